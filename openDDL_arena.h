@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_arena.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the memory arena used by the lexer to store one openDDL document
+///
+///   All the structures, properties, data_lists, literals, names and strings of a document are
+///   allocated one after the other in big blocks of memory. Instead of freeing each one of them,
+///   the whole document is freed in one go (calling reset or destroying the arena).
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENDDL_ARENA_INCLUDED
+#define OPENDDL_ARENA_INCLUDED
+
+#include <type_traits>
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class is a bump allocator, it owns all the memory of one openDDL document
+  ///   The objects created with make() will get their destructor called when the arena is reset (if they have one)
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_arena{
+        enum { BLOCK_SIZE = 64 * 1024, ALIGNMENT = 16 };
+
+        // This is a pointer to an object and the function that destroys it
+        struct destructor_entry{
+          void (*destroy)(void *);
+          void * object;
+        };
+
+        // The blocks of memory of the arena
+        dynarray<uint8_t *> blocks;
+        // The objects that have to be destroyed when reseting the arena (in order of creation)
+        dynarray<destructor_entry> destructors;
+        // The free memory of the current block
+        uint8_t * current;
+        size_t bytes_left;
+        // Some statistics of the memory
+        size_t bytes_used;
+        size_t bytes_reserved;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This function calls the destructor of an object created in the arena
+        /// @param  object  The object to destroy
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class object_type> static void destroy_object(void * object){
+          ((object_type *)object)->~object_type();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will register an object to be destroyed when reseting the arena
+        /// @param  object  The object created in the arena
+        /// @return The same object, so it can be used in the return of make()
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class object_type> object_type * register_object(object_type * object){
+          //The objects that don't need a destructor (literals, structures of identifier...) only use their memory
+          if (std::is_trivially_destructible<object_type>::value)
+            return object;
+          destructor_entry entry;
+          entry.destroy = &destroy_object<object_type>;
+          entry.object = object;
+          destructors.push_back(entry);
+          return object;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get a new block of memory from the system
+        /// @param  size  The minimum size of the block
+        ////////////////////////////////////////////////////////////////////////////////
+        void new_block(size_t size){
+          size_t block_size = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+          uint8_t * block = (uint8_t *)malloc(block_size);
+          blocks.push_back(block);
+          current = block;
+          bytes_left = block_size;
+          bytes_reserved += block_size;
+        }
+
+        // The arena owns its memory, so it cannot be copied
+        openDDL_arena(const openDDL_arena &);
+        openDDL_arena &operator=(const openDDL_arena &);
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the arena, it will not reserve memory until it's needed
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_arena(){
+          current = NULL;
+          bytes_left = 0;
+          bytes_used = 0;
+          bytes_reserved = 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Destructor of the arena, it frees all the document
+        ////////////////////////////////////////////////////////////////////////////////
+        ~openDDL_arena(){
+          reset();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get some memory from the arena
+        /// @param  size  The number of bytes requested
+        /// @return A pointer to the memory (aligned to 16 bytes)
+        ////////////////////////////////////////////////////////////////////////////////
+        void * allocate(size_t size){
+          size_t aligned_size = (size + (ALIGNMENT - 1)) & ~(size_t)(ALIGNMENT - 1);
+          if (aligned_size > bytes_left)
+            new_block(aligned_size);
+          void * memory = current;
+          current += aligned_size;
+          bytes_left -= aligned_size;
+          bytes_used += aligned_size;
+          return memory;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new object in the arena (with 0 to 4 parameters for the constructor)
+        /// @return A pointer to the new object, it will be destroyed when reseting the arena
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class object_type> object_type * make(){
+          return register_object(new (allocate(sizeof(object_type))) object_type());
+        }
+
+        template <class object_type, class A> object_type * make(A a){
+          return register_object(new (allocate(sizeof(object_type))) object_type(a));
+        }
+
+        template <class object_type, class A, class B> object_type * make(A a, B b){
+          return register_object(new (allocate(sizeof(object_type))) object_type(a, b));
+        }
+
+        template <class object_type, class A, class B, class C> object_type * make(A a, B b, C c){
+          return register_object(new (allocate(sizeof(object_type))) object_type(a, b, c));
+        }
+
+        template <class object_type, class A, class B, class C, class D> object_type * make(A a, B b, C c, D d){
+          return register_object(new (allocate(sizeof(object_type))) object_type(a, b, c, d));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get an array of characters from the arena
+        /// @param  size  The number of characters (it will reserve one more for the \0)
+        /// @return A pointer to the characters
+        ////////////////////////////////////////////////////////////////////////////////
+        char * make_chars(int size){
+          char * chars = (char *)allocate(size + 1);
+          chars[size] = '\0';
+          return chars;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will copy a word into the arena
+        /// @param  word  The word to copy
+        /// @param  size  The size of the word
+        /// @return A pointer to the copy of the word (ended with \0)
+        ////////////////////////////////////////////////////////////////////////////////
+        char * make_string(const char * word, int size){
+          char * new_word = make_chars(size);
+          memcpy(new_word, word, size);
+          return new_word;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will destroy all the objects and free all the memory of the arena in one go
+        ////////////////////////////////////////////////////////////////////////////////
+        void reset(){
+          for (int i = (int)destructors.size() - 1; i >= 0; --i)
+            destructors[i].destroy(destructors[i].object);
+          destructors.reset();
+          for (unsigned int i = 0; i < blocks.size(); ++i)
+            free(blocks[i]);
+          blocks.reset();
+          current = NULL;
+          bytes_left = 0;
+          bytes_used = 0;
+          bytes_reserved = 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will take all the memory and objects of another arena (the other arena is left empty)
+        /// @param  other  The arena to take, its objects will be destroyed when this arena is reset
+        ///   It's used to join the documents lexed in parallel, without copying them
+        ////////////////////////////////////////////////////////////////////////////////
+        void adopt(openDDL_arena &other){
+          for (unsigned int i = 0; i < other.blocks.size(); ++i)
+            blocks.push_back(other.blocks[i]);
+          for (unsigned int i = 0; i < other.destructors.size(); ++i)
+            destructors.push_back(other.destructors[i]);
+          bytes_used += other.bytes_used;
+          bytes_reserved += other.bytes_reserved;
+          other.blocks.reset();
+          other.destructors.reset();
+          other.current = NULL;
+          other.bytes_left = 0;
+          other.bytes_used = 0;
+          other.bytes_reserved = 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Some functions to obtain the statistics of the memory of the arena
+        /// @return The number of bytes used by the document, or reserved from the system
+        ////////////////////////////////////////////////////////////////////////////////
+        size_t get_bytes_used(){
+          return bytes_used;
+        }
+
+        size_t get_bytes_reserved(){
+          return bytes_reserved;
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
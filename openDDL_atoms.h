@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_atoms.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the table of atoms (interned strings) of one openDDL document
+///
+///   Every name ($name or %name), reference and string literal of the document is stored only once in this table,
+///   and it gets a small integer (its atom). So the lexer and the parser compare and look for names comparing
+///   integers, instead of copying the strings and comparing them character by character. The atom_t of octet
+///   of each name is obtained only once too (the first time it's requested).
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENDDL_ATOMS_INCLUDED
+#define OPENDDL_ATOMS_INCLUDED
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class interns the strings of a document, giving the same atom to the same string
+  ///   It's a hash table with open addressing, the strings are kept in their own arena so they never move
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_atom_table{
+        enum { MIN_SLOTS = 256 };
+
+        // This is one string of the table
+        struct atom_entry{
+          char * name;
+          int size;
+          uint32_t hash;
+          // The atom of octet, only valid if has_octet_atom is true
+          atom_t octet_atom;
+          bool has_octet_atom;
+        };
+
+        // The strings of the table (the index is the atom)
+        dynarray<atom_entry> entries;
+        // The hash table, each slot has an atom or -1 if it's free (the number of slots is a power of two)
+        dynarray<int> slots;
+        // The memory of the strings
+        openDDL_arena strings;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will compute the hash of a string (FNV-1a)
+        /// @param  chars  The characters of the string
+        /// @param  size  The number of characters
+        ////////////////////////////////////////////////////////////////////////////////
+        static uint32_t hash_chars(const char * chars, int size){
+          uint32_t hash = 2166136261u;
+          for (int i = 0; i < size; ++i){
+            hash ^= (uint8_t)chars[i];
+            hash *= 16777619u;
+          }
+          return hash;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the slot of a string
+        /// @return The slot with the atom of the string, or the free slot where it has to be added
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int find_slot(const char * chars, int size, uint32_t hash) const{
+          unsigned int mask = slots.size() - 1;
+          unsigned int slot = hash & mask;
+          for (;;){
+            int atom = slots[slot];
+            if (atom < 0)
+              return slot;
+            const atom_entry &entry = entries[atom];
+            if (entry.hash == hash && entry.size == size && memcmp(entry.name, chars, size) == 0)
+              return slot;
+            slot = (slot + 1) & mask;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will double the number of slots, and put again all the atoms in the table
+        ////////////////////////////////////////////////////////////////////////////////
+        void grow(){
+          unsigned int new_size = slots.size() < MIN_SLOTS ? MIN_SLOTS : slots.size() * 2;
+          slots.resize(new_size);
+          for (unsigned int i = 0; i < new_size; ++i)
+            slots[i] = -1;
+          for (unsigned int i = 0; i < entries.size(); ++i)
+            slots[find_slot(entries[i].name, entries[i].size, entries[i].hash)] = (int)i;
+        }
+
+        // The strings are owned by the table, so it cannot be copied
+        openDDL_atom_table(const openDDL_atom_table &);
+        openDDL_atom_table &operator=(const openDDL_atom_table &);
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the table, it will not reserve memory until the first string is added
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_atom_table(){
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get the atom of a string, adding the string to the table if it's new
+        /// @param  chars  The characters of the string (it does not need to end with \0)
+        /// @param  size  The number of characters
+        /// @return The atom of the string (0 for the first string added, 1 for the second...)
+        ////////////////////////////////////////////////////////////////////////////////
+        int intern(const char * chars, int size){
+          // The table is kept half empty at most, so the strings are found with few comparisons
+          if ((entries.size() + 1) * 2 > slots.size())
+            grow();
+          uint32_t hash = hash_chars(chars, size);
+          unsigned int slot = find_slot(chars, size, hash);
+          if (slots[slot] >= 0)
+            return slots[slot];
+          atom_entry entry;
+          entry.name = strings.make_string(chars, size);
+          entry.size = size;
+          entry.hash = hash;
+          entry.octet_atom = atom_;
+          entry.has_octet_atom = false;
+          slots[slot] = (int)entries.size();
+          entries.push_back(entry);
+          return slots[slot];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get the atom of a string, without adding it
+        /// @param  chars  The characters of the string
+        /// @param  size  The number of characters
+        /// @return The atom of the string, or -1 if it's not in the table
+        ////////////////////////////////////////////////////////////////////////////////
+        int find(const char * chars, int size) const{
+          if (slots.size() == 0)
+            return -1;
+          return slots[find_slot(chars, size, hash_chars(chars, size))];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Some functions to obtain the string of an atom
+        /// @param  atom  The atom (it has to be in the table)
+        /// @return The characters (ended with \0, valid till the table is reset), or the number of characters
+        ////////////////////////////////////////////////////////////////////////////////
+        char * get_name(int atom) const{
+          return entries[atom].name;
+        }
+
+        int get_size(int atom) const{
+          return entries[atom].size;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get the atom of octet of a string of the table (app_utils::get_atom is called only once)
+        /// @param  atom  The atom of the table, or -1
+        /// @return The atom_t of octet, or atom_ if the atom is -1
+        ////////////////////////////////////////////////////////////////////////////////
+        atom_t get_atom(int atom){
+          if (atom < 0)
+            return atom_;
+          atom_entry &entry = entries[atom];
+          if (!entry.has_octet_atom){
+            entry.octet_atom = app_utils::get_atom(entry.name);
+            entry.has_octet_atom = true;
+          }
+          return entry.octet_atom;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the number of strings of the table
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int size() const{
+          return entries.size();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will remove all the strings of the table (the atoms obtained before are not valid anymore)
+        ////////////////////////////////////////////////////////////////////////////////
+        void reset(){
+          entries.reset();
+          slots.reset();
+          strings.reset();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the memory used by the table
+        /// @return The number of bytes of the strings, the entries and the slots
+        ////////////////////////////////////////////////////////////////////////////////
+        size_t get_bytes_used(){
+          return strings.get_bytes_used() + entries.size() * sizeof(atom_entry) + slots.size() * sizeof(int);
+        }
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class is a dictionary indexed by the atoms of a document (an array, as the atoms are small integers)
+  ///   It's used instead of a dictionary of strings when the keys are names of the document
+  ////////////////////////////////////////////////////////////////////////////////
+      template <class value_type> class openDDL_atom_map{
+        dynarray<value_type> values;
+        dynarray<bool> used;
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get the value of an atom, adding it if it was not in the map
+        /// @param  atom  The atom (it cannot be -1)
+        ////////////////////////////////////////////////////////////////////////////////
+        value_type &operator[](int atom){
+          if ((unsigned int)atom >= values.size()){
+            unsigned int old_size = used.size();
+            values.resize(atom + 1);
+            used.resize(atom + 1);
+            for (unsigned int i = old_size; i < used.size(); ++i)
+              used[i] = false;
+          }
+          used[atom] = true;
+          return values[atom];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if an atom is in the map
+        /// @param  atom  The atom (it can be -1, then it's not in the map)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool contains(int atom) const{
+          return atom >= 0 && (unsigned int)atom < used.size() && used[atom];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will remove all the values of the map
+        ////////////////////////////////////////////////////////////////////////////////
+        void reset(){
+          values.reset();
+          used.reset();
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
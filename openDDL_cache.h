@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_cache.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the format of the binary cache of an openDDL document
+///
+///   Once a file is lexed, the document (structures, names, properties and data lists) can be saved in a binary
+///   file next to it. The next time the file is loaded, the cache is mapped in memory and the document is rebuilt
+///   from it without lexing anything: the names are interned in order, the structures are linked by their index,
+///   and the numbers of the data lists are used in place (they are already stored with their native type).
+///   There are no pointers in the cache, only offsets and indices, so it can be mapped at any address.
+///   The cache keeps the size, the time of modification and a hash of the source, it's only used if all of them match.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENDDL_CACHE_INCLUDED
+#define OPENDDL_CACHE_INCLUDED
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is what the cache knows of the file it comes from, to check if it's still the same file
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openDDL_cache_source{
+        uint64_t size;
+        int64_t mtime;
+        uint64_t hash;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is the beginning of the cache, the offsets of the sections are from the beginning of the file
+  ///   The sections are aligned to 8 bytes: atoms, characters of the atoms, structures, literals, paths and payload
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openDDL_cache_header{
+        char magic[8];
+        // OPENDDL_CACHE_VERSION, and 0x01020304 written with the byte order of the machine that wrote the cache
+        uint32_t version;
+        uint32_t byte_order;
+        openDDL_cache_source source;
+        // The size of the whole cache
+        uint64_t cache_size;
+        uint32_t num_atoms;
+        uint32_t num_structures;
+        uint32_t num_literals;
+        uint32_t num_paths;
+        uint64_t atoms_offset;
+        uint64_t chars_offset;
+        uint64_t structures_offset;
+        uint64_t literals_offset;
+        uint64_t paths_offset;
+        uint64_t payload_offset;
+        uint64_t payload_size;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is one string of the atom table (the index is the atom), its characters are in the section of characters
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openDDL_cache_atom{
+        uint64_t offset;
+        uint32_t size;
+        uint32_t unused;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is one structure, they are stored in the order of the file (a father is always before its substructures)
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openDDL_cache_structure{
+        // IDENTIFIER_TYPE or DATA_TYPE_TYPE, and the identifierID or the typeID
+        int32_t type;
+        int32_t id;
+        int32_t nameID;
+        // The index of the father, or -1 for the structures of the top level
+        int32_t father;
+        // Only for the data type structures: the integer_literal and the kind of list (one of the enum of openDDL_cache)
+        int32_t integer_literal;
+        int32_t list;
+        // The properties of an identifier structure, or the elements of a list of strings, refs or types
+        uint32_t first_literal;
+        uint32_t num_literals;
+        // The elements of a list of numbers, from the beginning of the payload (aligned to 8 bytes)
+        uint64_t num_elements;
+        uint64_t payload_offset;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is one literal (a property, or an element of a list that is not a number)
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openDDL_cache_literal{
+        // The identifier of the property (-1 for the elements of the lists)
+        int32_t identifierID;
+        int32_t value_type;
+        // The bits of the value for the numbers, bools and types (strings and refs use the atom)
+        uint32_t value;
+        int32_t atom;
+        int32_t size_string;
+        int32_t global_ref;
+        // The atoms of the names of a reference with more than one name are in the section of paths
+        int32_t path_size;
+        uint32_t first_path;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class has the helpers to write and check the caches (the lexer reads and writes the document)
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_cache{
+      public:
+        enum { OPENDDL_CACHE_VERSION = 1, BYTE_ORDER_MARK = 0x01020304, ALIGNMENT = 8, HASH_CHUNK_SIZE = 64 * 1024 * 1024 };
+        enum { NO_LIST = 0, DATA_LIST = 1, ARRAY_DATA = 2 };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the magic characters of the beginning of the caches
+        ////////////////////////////////////////////////////////////////////////////////
+        static const char * get_magic(){
+          return "ODDLCACH";
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will round a size up to the alignment of the sections
+        ////////////////////////////////////////////////////////////////////////////////
+        static uint64_t align(uint64_t size){
+          return (size + ALIGNMENT - 1) & ~(uint64_t)(ALIGNMENT - 1);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add some characters to the hash of a file (8 characters at a time, FNV-1a like)
+        /// @param  hash  The hash of the previous characters (start with get_initial_hash)
+        /// @param  data  The characters
+        /// @param  size  The number of characters, it has to be multiple of 8 except in the last piece of the file
+        /// @return The hash of all the characters
+        ////////////////////////////////////////////////////////////////////////////////
+        static uint64_t hash_bytes(uint64_t hash, const uint8_t * data, size_t size){
+          const uint64_t prime = 1099511628211ull;
+          size_t i = 0;
+          for (; i + 8 <= size; i += 8){
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            hash ^= word * 0x9E3779B97F4A7C15ull;
+            hash = ((hash << 27) | (hash >> 37)) * prime;
+          }
+          for (; i < size; ++i){
+            hash ^= data[i];
+            hash *= prime;
+          }
+          return hash;
+        }
+
+        static uint64_t get_initial_hash(){
+          return 14695981039346656037ull;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get the size and the time of the last modification of a file
+        /// @param  name  The path of the file
+        /// @param  size  It returns the size of the file
+        /// @param  mtime  It returns the time of modification (in seconds)
+        /// @return True if the file exists
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool get_file_stat(const char * name, uint64_t &size, int64_t &mtime){
+        #if defined(_WIN32)
+          struct __stat64 file_stat;
+          if (_stat64(name, &file_stat) != 0)
+            return false;
+        #else
+          struct stat file_stat;
+          if (stat(name, &file_stat) != 0)
+            return false;
+        #endif
+          size = (uint64_t)file_stat.st_size;
+          mtime = (int64_t)file_stat.st_mtime;
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if a section of the cache is inside it
+        /// @param  header  The header of the cache (its cache_size is already checked)
+        /// @param  offset  The offset of the section
+        /// @param  count  The number of elements of the section
+        /// @param  element_size  The size of each element
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool is_section_valid(const openDDL_cache_header &header, uint64_t offset, uint64_t count, uint64_t element_size){
+          return offset % ALIGNMENT == 0 && offset <= header.cache_size && count <= (header.cache_size - offset) / element_size;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check the header of a cache, and if it was made from the current version of the source
+        /// @param  data  The cache mapped in memory (aligned to 8 bytes)
+        /// @param  size  The size of the cache
+        /// @param  source  The size, time of modification and hash of the source now
+        /// @return The header if the cache can be used, or NULL if it's from another file, another version or it's broken
+        ////////////////////////////////////////////////////////////////////////////////
+        static const openDDL_cache_header * check_header(const uint8_t * data, size_t size, const openDDL_cache_source &source){
+          if (data == NULL || size < sizeof(openDDL_cache_header))
+            return NULL;
+          const openDDL_cache_header * header = (const openDDL_cache_header *)data;
+          if (memcmp(header->magic, get_magic(), 8) != 0 || header->version != OPENDDL_CACHE_VERSION || header->byte_order != BYTE_ORDER_MARK)
+            return NULL;
+          if (header->source.size != source.size || header->source.mtime != source.mtime || header->source.hash != source.hash)
+            return NULL;
+          if (header->cache_size != size)
+            return NULL;
+          if (!is_section_valid(*header, header->atoms_offset, header->num_atoms, sizeof(openDDL_cache_atom)) ||
+              !is_section_valid(*header, header->structures_offset, header->num_structures, sizeof(openDDL_cache_structure)) ||
+              !is_section_valid(*header, header->literals_offset, header->num_literals, sizeof(openDDL_cache_literal)) ||
+              !is_section_valid(*header, header->paths_offset, header->num_paths, sizeof(int32_t)) ||
+              !is_section_valid(*header, header->payload_offset, header->payload_size, 1) ||
+              header->chars_offset > header->cache_size)
+            return NULL;
+          return header;
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_file_map.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the file mapped in memory that the lexer reads in place
+///
+///   Instead of reading the whole file into a buffer (and copying it again into the lexer), the file
+///   is mapped in memory and the lexer reads the characters directly from the mapping. The operating
+///   system loads the pages of the file when they are needed, so there are no copies of the file.
+///   The offsets are 64 bits, so the files bigger than 4GB can be mapped in pieces.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENDDL_FILE_MAP_INCLUDED
+#define OPENDDL_FILE_MAP_INCLUDED
+
+#if defined(_WIN32)
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class maps a file in memory (read only)
+  ///   The whole file can be mapped at once, or it can be mapped by pieces (views) when the file is too big.
+  ///   The memory of a view is valid till another view is mapped or the file is closed.
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_file_map{
+        // The characters of the view mapped, and the number of characters
+        const uint8_t * data_;
+        size_t size_;
+        // The beginning of the mapping (it's aligned, so it can be before data_), and its size
+        void * view_;
+        size_t view_size_;
+        // The size of the file (64 bits, it can be bigger than the memory)
+        uint64_t file_size_;
+      #if defined(_WIN32)
+        HANDLE file_;
+        HANDLE mapping_;
+      #else
+        int file_;
+      #endif
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the alignment of the offsets of the views
+        /// @return The allocation granularity in windows, or the size of a page in other systems
+        ////////////////////////////////////////////////////////////////////////////////
+        static uint64_t get_granularity(){
+        #if defined(_WIN32)
+          SYSTEM_INFO info;
+          GetSystemInfo(&info);
+          return info.dwAllocationGranularity;
+        #else
+          return (uint64_t)sysconf(_SC_PAGESIZE);
+        #endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will unmap the current view (if there is one)
+        ////////////////////////////////////////////////////////////////////////////////
+        void unmap(){
+          if (view_ != NULL){
+          #if defined(_WIN32)
+            UnmapViewOfFile(view_);
+          #else
+            munmap(view_, view_size_);
+          #endif
+          }
+          view_ = NULL;
+          view_size_ = 0;
+          data_ = NULL;
+          size_ = 0;
+        }
+
+        // The mapping is owned by this object, so it cannot be copied
+        openDDL_file_map(const openDDL_file_map &);
+        openDDL_file_map &operator=(const openDDL_file_map &);
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the file map, it does not map anything till open is called
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_file_map(){
+          data_ = NULL;
+          size_ = 0;
+          view_ = NULL;
+          view_size_ = 0;
+          file_size_ = 0;
+        #if defined(_WIN32)
+          file_ = INVALID_HANDLE_VALUE;
+          mapping_ = NULL;
+        #else
+          file_ = -1;
+        #endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Destructor of the file map, it unmaps the file
+        ////////////////////////////////////////////////////////////////////////////////
+        ~openDDL_file_map(){
+          close();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will open a file to be mapped (if there was another file opened, it's closed)
+        /// @param  name  The path of the file
+        /// @return True if the file was opened, false if it does not exist, it's empty or it cannot be mapped
+        ///   Nothing is mapped yet, to read the file call map() with the part of the file needed
+        ////////////////////////////////////////////////////////////////////////////////
+        bool open(const char * name){
+          close();
+        #if defined(_WIN32)
+          file_ = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+          if (file_ == INVALID_HANDLE_VALUE)
+            return false;
+          LARGE_INTEGER file_size;
+          if (!GetFileSizeEx(file_, &file_size) || file_size.QuadPart <= 0){
+            close();
+            return false;
+          }
+          file_size_ = (uint64_t)file_size.QuadPart;
+          mapping_ = CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+          if (mapping_ == NULL){
+            close();
+            return false;
+          }
+        #else
+          file_ = ::open(name, O_RDONLY);
+          if (file_ < 0)
+            return false;
+          struct stat file_stat;
+          if (fstat(file_, &file_stat) != 0 || file_stat.st_size <= 0){
+            close();
+            return false;
+          }
+          file_size_ = (uint64_t)file_stat.st_size;
+        #endif
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will map a part of the file in memory (the previous view is unmapped)
+        /// @param  offset  The position of the first character to map (it does not need to be aligned)
+        /// @param  size    The number of characters to map
+        /// @return A pointer to the character in the position offset, or NULL if it cannot be mapped
+        ////////////////////////////////////////////////////////////////////////////////
+        const uint8_t * map(uint64_t offset, size_t size){
+          unmap();
+          if (offset + size > file_size_ || size == 0)
+            return NULL;
+          // The mapping has to start in a position multiple of the granularity
+          uint64_t aligned_offset = offset - offset % get_granularity();
+          size_t extra = (size_t)(offset - aligned_offset);
+          if (size + extra < size)
+            return NULL;
+        #if defined(_WIN32)
+          if (mapping_ == NULL)
+            return NULL;
+          view_ = MapViewOfFile(mapping_, FILE_MAP_READ, (DWORD)(aligned_offset >> 32), (DWORD)(aligned_offset & 0xFFFFFFFF), size + extra);
+          if (view_ == NULL)
+            return NULL;
+        #else
+          if (file_ < 0)
+            return NULL;
+          void * memory = mmap(NULL, size + extra, PROT_READ, MAP_PRIVATE, file_, (off_t)aligned_offset);
+          if (memory == MAP_FAILED)
+            return NULL;
+          // The lexer reads the file from the beginning to the end
+          madvise(memory, size + extra, MADV_SEQUENTIAL);
+          view_ = memory;
+        #endif
+          view_size_ = size + extra;
+          data_ = (const uint8_t *)view_ + extra;
+          size_ = size;
+          return data_;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will unmap the file and close it (the memory returned by data() is not valid anymore)
+        ////////////////////////////////////////////////////////////////////////////////
+        void close(){
+          unmap();
+        #if defined(_WIN32)
+          if (mapping_ != NULL)
+            CloseHandle(mapping_);
+          if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+          file_ = INVALID_HANDLE_VALUE;
+          mapping_ = NULL;
+        #else
+          if (file_ >= 0)
+            ::close(file_);
+          file_ = -1;
+        #endif
+          file_size_ = 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Some functions to obtain the characters of the view mapped
+        /// @return The first character of the view (or NULL), and the number of characters
+        ////////////////////////////////////////////////////////////////////////////////
+        const uint8_t * data() const{
+          return data_;
+        }
+
+        size_t size() const{
+          return size_;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the size of the file opened
+        /// @return The number of characters of the file (it can be bigger than what can be mapped at once)
+        ////////////////////////////////////////////////////////////////////////////////
+        uint64_t get_file_size() const{
+          return file_size_;
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
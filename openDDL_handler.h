@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_handler.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the interface to receive the openDDL document as a stream of events (SAX style)
+///
+///   Instead of building the whole tree of structures, the lexer can call to a handler while it reads
+///   the file: begin_structure, property, data_list_chunk and end_structure. The data lists are given
+///   in chunks, and the memory of each structure of the top level is released once it's finished, so
+///   the tools that only need some information (statistics, validation...) never hold all the scene.
+///
+///   A schema is a handler that only receives the content of the structures it knows: the lexer keeps building
+///   the tree, but those structures are read straight into the records of the schema (check openDDL_schema).
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENDDL_HANDLER_INCLUDED
+#define OPENDDL_HANDLER_INCLUDED
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class receives the events of the lexer, inherit from it and implement the functions needed
+  ///   All the functions return true to keep on reading, or false to stop the lexer (it's treated as an error)
+  ///   The pointers received are only valid during the call, so copy what has to be kept
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_handler{
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Destructor of the handler
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual ~openDDL_handler(){}
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called when a structure starts (after its name, before its properties and content)
+        /// @param  type_structure  IDENTIFIER_TYPE or DATA_TYPE_TYPE
+        /// @param  identifier  The identifier of the language (gex_ident_list) or the token of the data type (tok_bool ... tok_type)
+        /// @param  name  The name of the structure ($name or %name) or NULL if it has no name
+        /// @param  array_size  The size of the subarrays of a data array list, or -1 if it's not an array
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool begin_structure(structureType type_structure, int identifier, const char * name, int array_size){
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called for each property of an identifier structure
+        /// @param  identifier  The identifier of the property (gex_ident_list)
+        /// @param  literal  The value of the property
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool property(int identifier, const openDDL_data_literal &literal){
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called with the elements of a data list, in one or more chunks
+        /// @param  type  The token of the type of the elements (tok_bool ... tok_type)
+        /// @param  chunk  The elements read, read them with get_span or get_values (or get_literal if they are not numbers)
+        ///   The chunks of a data array list always contain complete subarrays
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool data_list_chunk(int type, openDDL_data_list &chunk){
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called when the } of a structure is found
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool end_structure(){
+          return true;
+        }
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class reads some structures of the document into its own records, instead of the tree
+  ///   The structures of the top level that it accepts are added to the tree with their name and properties only
+  ///   (so the references to them work as usual), and their substructures are sent to it as events. Inside them,
+  ///   the substructures that it does not accept are stored as usual and given whole to generic_structure.
+  ///   The names of the substructures sent as events are not checked, and they cannot be referenced.
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_schema : public openDDL_handler{
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called before a structure of the top level, and before each substructure of a record
+        /// @param  type_structure  IDENTIFIER_TYPE or DATA_TYPE_TYPE (the structures of the top level are always IDENTIFIER_TYPE)
+        /// @param  identifier  The identifier of the language (gex_ident_list) or the token of the data type (tok_bool ... tok_type)
+        /// @return True to receive its content as events, false to leave it in the tree (or give it whole to generic_structure)
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool accepts(structureType type_structure, int identifier){
+          return false;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called when the content of a structure of the top level accepted starts
+        /// @param  structure  The structure in the tree, with its name and properties (its substructures are not stored)
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool begin_record(openDDL_identifier_structure * structure){
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called with a substructure of a record that was not accepted, once it's finished
+        /// @param  structure  The structure, stored in the document (it's valid till the document is released)
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool generic_structure(openDDL_structure * structure){
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called when the } of a structure of the top level accepted is found
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool end_record(){
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is called when the document is released, the records of the document are not valid anymore
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual void release(){
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
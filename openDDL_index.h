@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_index.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the structural index of the characters of an openDDL file
+///
+///   Like in simdjson, the characters are checked 64 at a time to get a bitmap of the structural characters
+///   ({ } [ ] ( ) , =) that are not inside strings or comments. The positions of those characters are stored in
+///   an index, so the lexer can jump from one to the next instead of testing every character of the words.
+///   The index is built in windows of 64KB while the lexer advances, so it uses little memory even in big files.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENDDL_INDEX_INCLUDED
+#define OPENDDL_INDEX_INCLUDED
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class builds and walks the structural index of a buffer of characters
+  ///   The beginnings of the comments (the / of // and /*) are indexed too, so the words stop before them
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_index{
+        enum { WINDOW_SIZE = 64 * 1024, BLOCK_SIZE = 64 };
+        enum { NORMAL, STRING, STRING_ESCAPE, CHAR, CHAR_ESCAPE, LINE_COMMENT_START, LINE_COMMENT, BLOCK_COMMENT_START, BLOCK_COMMENT, BLOCK_COMMENT_STAR };
+
+        // The characters to index
+        const uint8_t * begin;
+        const uint8_t * end;
+        // The characters of the current window, and the position of the structural characters inside it
+        const uint8_t * window_begin;
+        const uint8_t * window_end;
+        dynarray<uint32_t> positions;
+        // The next position of the window to check
+        unsigned int cursor;
+        // Where the last character indexed was (one of the enum), it's kept from one block to the next
+        int state;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the position of the first bit set of a 64 bits mask (it cannot be 0)
+        ////////////////////////////////////////////////////////////////////////////////
+        static int first_bit(uint64_t mask){
+        #if defined(_MSC_VER)
+          unsigned long index;
+          _BitScanForward64(&index, mask);
+          return (int)index;
+        #else
+          return __builtin_ctzll(mask);
+        #endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will compute the xor of every bit with all the bits before it
+        ///   With the mask of the quotes, it gives 1 for the characters inside the strings (and the opening quote)
+        ////////////////////////////////////////////////////////////////////////////////
+        static uint64_t prefix_xor(uint64_t mask){
+          mask ^= mask << 1;
+          mask ^= mask << 2;
+          mask ^= mask << 4;
+          mask ^= mask << 8;
+          mask ^= mask << 16;
+          mask ^= mask << 32;
+          return mask;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if a character is structural ({ } [ ] ( ) , =)
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool is_structural(uint8_t character){
+          switch (character){
+          case 0x7b: case 0x7d: case 0x5b: case 0x5d: case 0x28: case 0x29: case 0x2c: case 0x3d:
+            return true;
+          default:
+            return false;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add to the window the positions of the bits of a mask
+        /// @param  block  The first character of the block of the mask
+        /// @param  mask  One bit per character of the block
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_positions(const uint8_t * block, uint64_t mask){
+          uint32_t offset = (uint32_t)(block - window_begin);
+          while (mask != 0){
+            positions.push_back(offset + first_bit(mask));
+            mask &= mask - 1;
+          }
+        }
+
+      #if defined(OPENDDL_SSE2)
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get the mask of the characters equal to a given one, in 16 characters
+        ////////////////////////////////////////////////////////////////////////////////
+        static uint64_t equal_mask(__m128i chars, char character){
+          return (uint64_t)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8(character)));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will index 64 characters at once, if they are simple enough
+        /// @param  block  The first of the 64 characters
+        /// @return True if the block was indexed, false if it has to be indexed character by character
+        ///   It can do it when there are no comments, char literals or escaped characters in the block (most of them)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool index_block(const uint8_t * block){
+          if (state != NORMAL && state != STRING)
+            return false;
+          uint64_t structural = 0, quotes = 0, others = 0;
+          for (int i = 0; i < 4; ++i){
+            __m128i chars = _mm_loadu_si128((const __m128i *)(block + 16 * i));
+            uint64_t brackets = equal_mask(chars, 0x7b) | equal_mask(chars, 0x7d) | equal_mask(chars, 0x5b) | equal_mask(chars, 0x5d);
+            uint64_t separators = equal_mask(chars, 0x28) | equal_mask(chars, 0x29) | equal_mask(chars, 0x2c) | equal_mask(chars, 0x3d);
+            structural |= (brackets | separators) << (16 * i);
+            quotes |= equal_mask(chars, 0x22) << (16 * i);
+            others |= (equal_mask(chars, 0x27) | equal_mask(chars, 0x5c) | equal_mask(chars, 0x2f)) << (16 * i); //27 = ' 5c = backslash 2f = /
+          }
+          if (others != 0)
+            return false;
+          if (quotes != 0 || state == STRING){
+            uint64_t inside = prefix_xor(quotes) ^ (state == STRING ? ~(uint64_t)0 : 0);
+            structural &= ~inside;
+            state = (inside >> 63) != 0 ? STRING : NORMAL;
+          }
+          add_positions(block, structural);
+          return true;
+        }
+      #endif
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will index the characters one by one (used in the blocks with comments, char literals...)
+        /// @param  c  The first character to index
+        /// @param  block_end  The end of the characters to index
+        ////////////////////////////////////////////////////////////////////////////////
+        void index_characters(const uint8_t * c, const uint8_t * block_end){
+          for (; c < block_end; ++c){
+            uint8_t character = *c;
+            switch (state){
+            case NORMAL:
+              if (is_structural(character))
+                positions.push_back((uint32_t)(c - window_begin));
+              else if (character == 0x22) state = STRING; //22 = "
+              else if (character == 0x27) state = CHAR; //27 = '
+              else if (character == 0x2f && c + 1 < end && (c[1] == 0x2f || c[1] == 0x2a)){ //2f = / and 2a = *
+                positions.push_back((uint32_t)(c - window_begin));
+                state = c[1] == 0x2f ? LINE_COMMENT_START : BLOCK_COMMENT_START;
+              }
+              break;
+            case STRING:
+              if (character == 0x5c) state = STRING_ESCAPE;
+              else if (character == 0x22) state = NORMAL;
+              break;
+            case CHAR:
+              if (character == 0x5c) state = CHAR_ESCAPE;
+              else if (character == 0x27) state = NORMAL;
+              break;
+            case STRING_ESCAPE:
+              state = STRING;
+              break;
+            case CHAR_ESCAPE:
+              state = CHAR;
+              break;
+            case LINE_COMMENT_START: //This is the second / of the //
+              state = LINE_COMMENT;
+              break;
+            case LINE_COMMENT:
+              if (character == 0x0d || character == 0x0a) state = NORMAL;
+              break;
+            case BLOCK_COMMENT_START: //This is the * of the /*
+              state = BLOCK_COMMENT;
+              break;
+            case BLOCK_COMMENT:
+              if (character == 0x2a) state = BLOCK_COMMENT_STAR;
+              break;
+            case BLOCK_COMMENT_STAR:
+              if (character == 0x2f) state = NORMAL;
+              else if (character != 0x2a) state = BLOCK_COMMENT;
+              break;
+            }
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will index the next window of characters (the previous window is forgotten)
+        ///   The state is kept between the windows, so a string or a comment can start in one window and end in another
+        ////////////////////////////////////////////////////////////////////////////////
+        void next_window(){
+          window_begin = window_end;
+          window_end = end - window_begin > WINDOW_SIZE ? window_begin + WINDOW_SIZE : end;
+          positions.resize(0);
+          cursor = 0;
+          const uint8_t * c = window_begin;
+        #if defined(OPENDDL_SSE2)
+          for (; window_end - c >= BLOCK_SIZE; c += BLOCK_SIZE){
+            if (!index_block(c))
+              index_characters(c, c + BLOCK_SIZE);
+          }
+        #endif
+          index_characters(c, window_end);
+        }
+
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the index, it does not index anything till reset is called
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_index(){
+          reset(NULL, 0);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will start the index of a new buffer of characters
+        /// @param  data  The first character
+        /// @param  size  The number of characters
+        ////////////////////////////////////////////////////////////////////////////////
+        void reset(const uint8_t * data, size_t size){
+          begin = data;
+          end = data + size;
+          window_begin = data;
+          window_end = data;
+          positions.resize(0);
+          cursor = 0;
+          state = NORMAL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will look for the next structural character (or the beginning of a comment)
+        /// @param  c  The current character, it can't be before the last one asked (the lexer only goes forward)
+        /// @return The first structural character at c or after it, or the end of the buffer if there are no more
+        ///   The characters inside strings are not structural, so c has to be outside a string (or at its quote)
+        ////////////////////////////////////////////////////////////////////////////////
+        const uint8_t * next(const uint8_t * c){
+          for (;;){
+            while (cursor < positions.size()){
+              const uint8_t * position = window_begin + positions[cursor];
+              if (position >= c)
+                return position;
+              ++cursor;
+            }
+            if (window_end >= end)
+              return end;
+            next_window();
+          }
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
@@ -21,6 +21,16 @@
 #define OPENDDL_LEXER_INCLUDED
 #include "openDDL_tokens.h"
 #include "openDDL_structures.h"
+#include "openDDL_handler.h"
+#include "openDDL_arena.h"
+#include "openDDL_atoms.h"
+#include "openDDL_scanner.h"
+#include "openDDL_index.h"
+#include "openDDL_number_parser.h"
+#include "openDDL_cache.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
 
 namespace octet
 {
@@ -31,26 +41,21 @@ namespace octet
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief This class is the openGEX lexer, it will read the array of characters and get tokens
   ////////////////////////////////////////////////////////////////////////////////
-      class openDDL_lexer : public ddl_token{
-        enum { MIN_RESERVING_DATA_LIST = 10, DEBUGGINGDDL = 0, DEBUGGINGDDLMORE = 0, DEBUGGING = 0, DEBUGGINGMORE = 0 };
+      class openDDL_lexer : public ddl_token, public openDDL_lazy_decoder{
+        enum { MIN_RESERVING_DATA_LIST = 10, STREAM_CHUNK_ELEMENTS = 4096, PARALLEL_MIN_SIZE = 1024 * 1024, RANGES_PER_THREAD = 4, DEBUGGINGDDL = 0, DEBUGGINGDDLMORE = 0, DEBUGGING = 0, DEBUGGINGMORE = 0 };
       protected:
-        // Dictionary of identifiers of the openDDL language we are using
-        dictionary<int> identifiers_;
-        // Dictionary of types of openDDL
-        dictionary<int> types_;
-        // Dictionary of names
-        dictionary<openDDL_structure *> names_;
-        // Dictionary of symbols
-        dictionary<int> symbols_;
+        // The structures with a global name, indexed by the atom of the name (NULL if the name is only referenced yet)
+        dynarray<openDDL_structure *> global_names;
+        // The atoms of the names, references and strings of the document (only the one of language is used, check intern)
+        openDDL_atom_table atoms;
+        std::mutex atoms_mutex;
         // This are the current character and the next character after the token
-        uint8_t * currentChar;
-        uint8_t * tempChar;
-        // This is the current buffer with the characters in UTF8
-        dynarray<uint8_t> buffer;
-        // The number of characters till the end of the file
-        int bufferSize;
+        const uint8_t * currentChar;
+        const uint8_t * tempChar;
+        // The number of characters till the end of the file (64 bits, the files can be bigger than 2GB)
+        int64_t bufferSize;
         // The size of the token
-        int sizeRead;
+        int64_t sizeRead;
         // Just to check nesting
         int nesting;
         // This will be the openDDL file being (just a series of structures)
@@ -58,32 +63,61 @@ namespace octet
         openDDL_data_list * current_data_list;
         openDDL_structure * current_structure;
         openDDL_data_literal* current_literal;
-
-        ////////////////////////////////////////////////////////////////////////////////
-        /// @brief  This function will add an identifiers to the dictionary
-        /// @param  id  , stands for the name of the identificator 
-        /// @param  tok , stands for the token of the identificator
-        ////////////////////////////////////////////////////////////////////////////////
-        void add_identifier(const char *id, int tok){
-          identifiers_[id] = tok;
-        }
-
-        ////////////////////////////////////////////////////////////////////////////////
-        /// @brief  This function will add an types to the dictionary
-        /// @param  id   stands for the name of the type
-        /// @param  tok  stands for the token of the type
-        ////////////////////////////////////////////////////////////////////////////////
-        void add_type(const char *id, int tok){
-          types_[id] = tok;
-        }
-
-        ////////////////////////////////////////////////////////////////////////////////
-        /// @brief  This function will add an symbols to the dictionary
-        /// @param  id  , stands for the name of the symbol to add (the character)
-        /// @param  tok , stands for the token of the symbol
-        ////////////////////////////////////////////////////////////////////////////////
-        void add_symbol(const char *id, int tok){
-          symbols_[id] = tok;
+        // This is the memory of the document (all the structures, names and strings are stored here)
+        openDDL_arena arena;
+        // This is a small buffer reused to copy the words of the data lists
+        dynarray<char> word_buffer;
+        // This is a small buffer reused to decode the string literals before interning them
+        dynarray<char> string_buffer;
+        // If there is a handler, the document is not stored, the lexer sends the events to the handler (check openDDL_handler.h)
+        openDDL_handler * handler;
+        // In streaming mode the elements of the data lists are stored here till they are sent to the handler
+        openDDL_data_list stream_data_list;
+        // The schema that reads the content of some structures into its own records (check set_schema), or NULL.
+        // While the content of one of them is lexed, the schema is the handler
+        openDDL_schema * schema;
+        // The substructures given whole to the schema, they are not in the tree but their references are resolved too
+        dynarray<openDDL_structure *> schema_structures;
+        // The characters received by feed() that are not lexed yet (the last structure of the top level is not complete)
+        dynarray<uint8_t> feed_buffer;
+        // This finds the ends of the structures in the characters received by feed()
+        openDDL_splitter splitter;
+        // True between the first feed() and finish(), and false if there was an error in any of the pieces
+        bool feeding;
+        bool feed_no_error;
+        // The lexer that knows the identifiers of the language (this one, or the main lexer if this is a worker of lexer_parallel)
+        openDDL_lexer * language;
+        // The number of threads used to lexer big buffers (0 = one per core, 1 = no parallel lexing)
+        int num_threads;
+        // The structures of the top level with a local name, indexed by the atom of the name (like global_names)
+        dynarray<openDDL_structure *> root_names;
+        // In a worker of lexer_parallel, the structures with a global name or a local name of the top level (in order),
+        // to join them with the other workers
+        dynarray<openDDL_structure *> global_named;
+        // The properties of the structure being read, they are copied together in the arena once they are all read
+        dynarray<openDDL_properties> property_buffer;
+        // This is a small buffer reused to get the atoms of the names of a reference
+        dynarray<int> path_buffer;
+        // The number of references not found by the last resolve_references
+        int unresolved_references;
+        // The structural index of the characters being lexed (only if use_index is true, check openDDL_index.h)
+        openDDL_index structural_index;
+        bool use_index;
+        bool indexed;
+        // If lazy_data is true, lexer_memory does not decode the data lists, they are decoded when they are requested
+        // (lazy is true only while lexing the characters that will be kept, check set_lazy_data)
+        bool lazy_data;
+        bool lazy;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function will find the identifier of the openDDL language we are using (openGEX...)
+        /// @param  word  The first character of the word
+        /// @param  size  The size of the word
+        /// @return The identifier of the word, or -1 if it's not an identifier of the language
+        ///   The language using the lexer has to implement it (openDDL does not define identifiers by itself)
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual int find_identifier(const char * word, int size){
+          return -1;
         }
 
         // Some small functions to make easier the lexer process
@@ -95,6 +129,14 @@ namespace octet
           return bufferSize <= 0;
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function returns the current character, without reading after the end of the file
+        /// @return The current character, or 0 if it's the end of the file (it's treated as a whitespace)
+        ////////////////////////////////////////////////////////////////////////////////
+        uint8_t current_char(){
+          return bufferSize > 0 ? *currentChar : 0;
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This function will get a new char
         ///   To do so, it will decrease the number of elements, and it will get a new char
@@ -120,7 +162,7 @@ namespace octet
         ///     This function will be useful when "jumpin" some characters that have already been readed
         ///     Be aware that it does not check if it has passed the end of the file!!!!
         ////////////////////////////////////////////////////////////////////////////////
-        void char_jump(int pos){
+        void char_jump(int64_t pos){
           bufferSize -= pos;
           currentChar += pos;
         }
@@ -133,7 +175,7 @@ namespace octet
         /// @param  size2  This is the size of the second word that has to be checked
         /// @returns  True if the two words are equal
         ////////////////////////////////////////////////////////////////////////////////
-        bool same_word(char *word1, int size1, char *word2, int size2){
+        bool same_word(const char *word1, int size1, const char *word2, int size2){
           bool equal = true;
           if (size1 != size2) equal = false;
           for (int i = 0; equal && i < size1; ++i){
@@ -150,7 +192,7 @@ namespace octet
         /// @param  size2  This is the size of the second word that has to be checked
         /// @returns  True if the two words are equal
         ////////////////////////////////////////////////////////////////////////////////
-        bool same_word(char *word1, char *word2, int size){
+        bool same_word(const char *word1, const char *word2, int size){
           bool equal = true;
           for (int i = 0; equal && i < size; ++i){
             equal = (word1[i] == word2[i]);
@@ -163,19 +205,18 @@ namespace octet
         /// @return True if the current character is a whiteSpace (any value less than 0x20)
         ////////////////////////////////////////////////////////////////////////////////
         bool is_whiteSpace(){ // everything less or equal than 0x20 is a whitespace
-          return *currentChar <= 0x20;
+          return current_char() <= 0x20;
         }
       
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This function ignore any comment or whitespace
-        ///     ToDO: This is used really often, check if it is really efficient!
+        ///     This is used really often, so it uses the vectorial scanner (16 or 32 characters at once)
         ////////////////////////////////////////////////////////////////////////////////
         void remove_comments_whitespaces(){ // everything less or equal than 0x20 is a whitespace
-          if(!is_end_file())
-            while ((is_whiteSpace() || is_comment()) && !is_end_file()){
-              if (is_whiteSpace()) get_next_char(); 
-              else ignore_comment();
-            }
+          if (!is_end_file()){
+            const uint8_t * next = openDDL_scanner::skip_whitespace_comments(currentChar, currentChar + bufferSize);
+            char_jump(next - currentChar);
+          }
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -183,63 +224,49 @@ namespace octet
         /// @returns This function returns true if the currentChar is the begining of a comment
         ////////////////////////////////////////////////////////////////////////////////
         bool is_comment(){ //0x2f = /  and  0x2A = *
-          return *currentChar == 0x2F && (currentChar[1] == 0x2F || currentChar[1] == 0x2A);
+          return bufferSize > 1 && currentChar[0] == 0x2F && (currentChar[1] == 0x2F || currentChar[1] == 0x2A);
         }
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief  This will lexer a comment with /* */or // and break line
-        ///     ToDo: This function is used A LOT. Check if it's really good, and make it better!
+        /// @brief  This will lexer a comment with /* */or // and break line (and the whitespaces after it)
+        ///     It has to be called only when is_comment() is true
         ////////////////////////////////////////////////////////////////////////////////
         void ignore_comment(){
-          //It comes from reading the / so, get next char
-          get_next_char();
-
-          switch (*currentChar){
-          case 0x2F: // 0x2f = /  as it comes from another / that means that it's a // comment
+          const uint8_t * end = currentChar + bufferSize;
+          const uint8_t * next = currentChar + 2;
+          if (currentChar[1] == 0x2F){ // 0x2f = /  as it comes from another / that means that it's a // comment
             if (DEBUGGINGDDLMORE) printf("(//comment)");
-            get_next_char();
-            while (*currentChar != 0x0D && *currentChar != 0x0A){
-              if (DEBUGGINGDDLMORE) printf("%c", *currentChar);
-              get_next_char();
-            }
-            if (DEBUGGINGDDLMORE) printf("_%c", *currentChar);
-            break;
-          case 0x2A: // 0x2a = * as it comes from another / that means that it's a /* comment
+            next = openDDL_scanner::find_line_end(next, end);
+          }
+          else{ // 0x2a = * as it comes from another / that means that it's a /* comment
             if (DEBUGGINGDDLMORE) printf("(/**/comment)");
-            get_next_char();
-            while (*currentChar != 0x2A && currentChar[1] != 0x2f){ // until next characters are * and / 
-              if (DEBUGGINGDDLMORE) printf("%c", *currentChar);
-              get_next_char();
-              if (is_end_file()) assert(0 && "It's missing the */ of a comment");
-            }
-            if (DEBUGGINGDDLMORE) printf("_%c", *currentChar);
-            get_next_char();
-            if (DEBUGGINGDDLMORE) printf("_%c", *currentChar);
-            get_next_char();
-            break;
+            next = openDDL_scanner::find_comment_end(next, end);
+            if (next == end) assert(0 && "It's missing the */ of a comment");
+            else next += 2;
           }
-          while (is_whiteSpace()) get_next_char();
-          if (DEBUGGINGDDLMORE) printf("\n%x\n", *currentChar);
+          next = openDDL_scanner::skip_whitespace(next, end);
+          char_jump(next - currentChar);
+          if (DEBUGGINGDDLMORE) printf("\n%x\n", current_char());
         }
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief  This function will test if the current token is a dataType (will return the index of the type
-        /// @param  word    It's the word to check if it's a data type
-        /// @return   it returns the value of the type readed
+        /// @brief  This function will test if the current token is a dataType
+        /// @param  word    It's the first character of the word to check if it's a data type
+        /// @param  size    It's the size of the word
+        /// @return   it returns the token of the type readed (or -1 if it's not a type)
         ////////////////////////////////////////////////////////////////////////////////
-        int is_dataType(string word){
-          int index = types_.get_index(word.c_str());
-          return index;
+        int is_dataType(const char * word, int size){
+          return find_type(word, size);
         }
 
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This function will test if the current token is a identifier
-        /// @param  word    It's the word to check if it's a identifier type
-        /// @return   True if it's a identifier, and false if it's not a identifier
+        /// @param  word    It's the first character of the word to check if it's a identifier type
+        /// @param  size    It's the size of the word
+        /// @return   it returns the identifier readed (or -1 if it's not an identifier)
         ////////////////////////////////////////////////////////////////////////////////
-        int is_identifier(string word){
-          int index = identifiers_.get_index(word.c_str());
-          return index;
+        int is_identifier(const char * word, int size){
+          return language->find_identifier(word, size);
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -247,7 +274,7 @@ namespace octet
         /// @return   True if it's a name, and false if it's not a name
         ////////////////////////////////////////////////////////////////////////////////
         bool is_name(){
-          return (*currentChar == '%') || (*currentChar == '$');
+          return (current_char() == '%') || (current_char() == '$');
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -255,8 +282,7 @@ namespace octet
         /// @return   True if it's a symbol, and false if it's not a symbol
         ////////////////////////////////////////////////////////////////////////////////
         bool is_symbol(){
-          string character((char*)currentChar, 1);
-          return symbols_.contains(character.c_str());
+          return !is_end_file() && find_symbol(*currentChar) >= 0;
         }
 
         //Here start some functions to get_literals!
@@ -267,7 +293,7 @@ namespace octet
         /// @param  size    this is the size of the word readed
         /// @return   True if everything went right, and false if something went wrong
         ////////////////////////////////////////////////////////////////////////////////
-        bool get_bool_literal(bool &value, char *word, int size){
+        bool get_bool_literal(bool &value, const char *word, int size){
           if (size == 4){ //true.size() == 4
             if (word[0] == 't' && word[1] == 'r' && word[2] == 'u' && word[3] == 'e')
               value = true;
@@ -285,75 +311,25 @@ namespace octet
 
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This function will check if it's a int-literal
-        /// @param  value   it returns the value of the integer
+        /// @param  value   it returns the value of the integer (with 64 bits, the negatives in two's complement)
         /// @param  word    this is a pointer to the beginning of the word
-        /// @param  size    this is the size of the word readed
+        /// @param  size    this is the size of the word readed (the word is in the word_buffer, with 8 characters after it)
+        /// @param  padded  true if there are 8 characters after the word that can be read (false if it's read in place near the end)
         /// @return   True if everything went right, and false if something went wrong
+        ///   The decimal, hex and binary literals are read 8 digits at a time (check openDDL_number_parser)
         ////////////////////////////////////////////////////////////////////////////////
-        bool get_integer_literal(int &value, char *word, int size){
-          value = 0;
-          int pow = 10;
-          int initial_i = 0;
-          int pos_negative = 1;
-
-          //It may have - or +
-          if (*word == 0x2b){ //2b = +
-            initial_i = 1; //ignore the first character
-            pos_negative = 1; //is positive number
-          }
-          else if (*word == 0x2d){ //2d = -
-            initial_i = 1; //ignore the first character
-            pos_negative = -1;
-          }
-
-
-          //It may be a binary-literal, hex-literal, int-literal or char-literal
-          if (word[initial_i] == 0x30){ //30 = 0
-            if (word[initial_i + 1] == 0x42 || word[initial_i + 1] == 0x62){ //42 = B, 62 = b, that meaning, it's a binary number
-              pow = 2;
-              initial_i += 2;
-              //fill this with the reader of binaries
-              for (int i = 0; i < size; ++i){
-                if (word[i] == 48 || word[i] == 49)
-                  value = value*pow + (word[i] - 48);
-                else
-                  return false; //ERROR!
-              }
-            }
-
-            else if (word[initial_i + 1] == 0x58 || word[initial_i + 1] == 0x78){ //58 = X, 78 = x, that meaning, it's an hex number
-              pow = 16;
-              initial_i += 2;
-              //fill this with the reader of exadecimals
-              for (int i = 0; i < size; ++i){
-                if (word[i] >= 48 || word[i] <= 57)
-                  value = value*pow + (word[i] - 48);
-                else if (word[i] >= 65 || word[i] <= 70)
-                  value = value*pow + (word[i] - 55);
-                else if (word[i] >= 97 || word[i] <= 102)
-                  value = value*pow + (word[i] - 87);
-                else
-                  return false; //ERROR!
-              }
-            }
-
-          }
-          else if (*word == 0x27) { //27 = '   This will be need to be fixed, this is for character literal
-            for (int i = initial_i; i < size; ++i){
-              value = value*pow + (word[i] - 48);
-              //this has to check also for escape-char
-            }
-
+        bool get_integer_literal(uint64_t &value, const char *word, int size, bool padded = true){
+          if (*word == 0x27) { //27 = '   it's a char literal
+            char character;
+            if (!get_char_literal(character, word, size))
+              return false;
+            value = (uint8_t)character;
+            return true;
           }
-          else {
-            for (int i = initial_i; i < size; ++i){
-              if (word[i] >= 48 || word[i] <= 57)
-                value = value*pow + (word[i] - 48);
-              else
-                return false; //ERROR!
-            }
+          if (!openDDL_number_parser::parse_integer(value, word, size, padded)){
+            printf("It's not a correct integer-literal!\n");
+            return false;
           }
-          value *= pos_negative;
           return true;
         }
 
@@ -363,134 +339,28 @@ namespace octet
         /// @param  word    this is a pointer to the beginning of the word
         /// @param  size    this is the size of the word readed
         /// @return   True if everything went right, and false if something went wrong
-        ///   ToDo: Replace String for char* 
-        ///   ToDo: Check this line: "value = value * 16 + ( ( *src - ( *src < 'A' ? '0' : 'A'-10 ) ) & 15 );"
-        ////////////////////////////////////////////////////////////////////////////////
-        bool get_float_literal(float &value, char *word, int size){
-          int decimal = 0; //This will be use to check how many decimals
-          int initial_i = 0; //This will be used to "jump" the firs character if there is a sign (+, -)
-          int pos_negative = 1; //This will be used to determine if it's positive or negative
-          int pow = 10; //This will be use to always track which kind of power we are aplying
-          int exponential = 1; //This will be use to check the exponential
-          int exp_pos_neg = 1; //This will be use to check the sign of the exponential
-          value = 0;
-
-          //It may have - or +
-          if (word[0] == 0x2b){ //2b = +
-            initial_i = 1; //ignore the first character
-            pos_negative = 1; //is positive number
-          }
-          else if (word[0] == 0x2d){ //2d = -
-            initial_i = 1; //ignore the first character
-            pos_negative = -1;
-          }
-
-          //It may be a binary-literal, hex-literal or float-literal (starting with 0 or .) or float-literal starting with any number
-          if (word[initial_i] == 0x30){ //30 = 0
-            //------CHECKING BINARY NUMBER
-            if (word[initial_i + 1] == 0x42 || word[initial_i + 1] == 0x62){ //42 = B, 62 = b, that meaning, it's a binary number
-              pow = 2;
-              initial_i += 2;
-              //fill this with the reader of binaries
-              for (int i = initial_i; i < size; ++i){
-                if (word[i] == 48 || word[i] == 49)  //48 in decimal is the symbol 0, 49 in decimal is the symbol 1
-                  value = value * 2 + (word[i] - 48);
-                else
-                  return false; //ERROR!
-              }
-            }
-
-            //------CHECKING HEXADECIMAL NUMBER
-            else if (word[initial_i + 1] == 0x58 || word[initial_i + 1] == 0x78){ //58 = X, 78 = x, that meaning, it's an hex number
-              union tupla { int i; float f; } u;
-              pow = 16;
-              initial_i += 2;
-              u.i = 0;
-              //fill this with the reader of exadecimals
-              for (int i = initial_i; i < size; ++i){
-                if (word[i] >= 0x30 && word[i] <= 0x39)
-                  u.i = u.i * 16 + (word[i] - 0x30);
-                else if (word[i] >= 0x41 && word[i] <= 0x5A)
-                  u.i = u.i * 16 + (word[i] - (0x41 - 10));
-                else if (word[i] >= 0x61 && word[i] <= 0x7A)
-                  u.i = u.i * 16 + (word[i] - (0x61 - 10));
-                else
-                  return false; //ERROR!
-              }
-              value = u.f;
-              if (DEBUGGINGDDLMORE) printf("===> %f, %8x <==== Is this right?\n", u.f, u.i);
-            }
-          }
-
-          //------CHECKING DECIMAL NUMBER
-          if (pow == 10){
-            int i;
-            // It can be a decimal, so we will use decimal as a way to test if it's decimal or not
-            decimal = -1;
-
-            //this will read the left part of the dot 
-            for (i = initial_i; i < size && decimal == -1 && exponential == 1; ++i){
-              if (word[i] == 0x2e) //2e = .
-                decimal = 0;
-              else if (word[i] == 0x45 || word[i] == 0x65) //45 = E, 65 = e
-                exponential = 0;
-              else if (word[i] >= 48 && word[i] <= 57)
-                value = value * 10 + (word[i] - 48);
-              else{
-                printf("It's not a correct digit!\n");
-                return false; //ERROR!
-              }
-            }
-            //------CHECKING right part of the DECIMAL NUMBER
-            //this part will read decimals (right part of dot)
-            if (decimal != -1)
-              for (; i < size && exponential == 1; ++i){
-                if (word[i] == 0x45 || word[i] == 0x65) //45 = E, 65 = e
-                  exponential = 0;
-                else{
-                  ++decimal;
-                  if (word[i] >= 48 && word[i] <= 57)
-                    value = value * 10 + (word[i] - 48);
-                  else{
-                    printf("It's not a correct digit!\n");
-                    return false; //ERROR!
-                  }
-                }
-              }
-            //------CHECKING exponential part of the DECIMAL NUMBER
-            //this part will understand exponentials (if there is any)
-            if (exponential == 0){
-              if (word[i] == 0x2b) //2b = +
-                ++i;
-              else if (word[i] == 0x2d){ //2d = -
-                ++i;
-                exp_pos_neg = -1;
-              }
-              for (; i < size; ++i){
-                if (word[i] >= 48 && word[i] <= 57)
-                  exponential = exponential * 10 + (word[i] - 48);
-                else{
-                  printf("It's not a correct digit!\n");
-                  return false; //ERROR!
-                }
-              }
-            }
-
+        ///   The value is correctly rounded (check openDDL_number_parser)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool get_float_literal(float &value, const char *word, int size){
+          if (!openDDL_number_parser::parse_float(value, word, size)){
+            printf("It's not a correct float-literal!\n");
+            return false;
           }
+          if (DEBUGGINGDDL) printf("Number-> %f ", value);
+          return true;
+        }
 
-          //If decimal arrived here as -1, it's not decimal, so make decimal == 1; if it's different to -1, its a decimal, so keep decimal value
-          decimal = decimal == -1 ? 0 : decimal;
-          //Now construct the number knowing value, pos_negative, decimal, pow, exponential!
-          value = value*pos_negative;
-          for (int i = 0; i < decimal; ++i){
-            value = value / 10;
-          }
-          if (exponential != 1){
-            float mult_exponential = 1;
-            for (int i = 0; i < exponential; ++i){
-              mult_exponential = exp_pos_neg > 0 ? mult_exponential * pow : mult_exponential / pow;
-            }
-            value = value * mult_exponential;
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function will check (and read) if it's a float-literal, and store it in a double
+        /// @param  value   it returns the value of the double
+        /// @param  word    this is a pointer to the beginning of the word
+        /// @param  size    this is the size of the word readed
+        /// @return   True if everything went right, and false if something went wrong
+        ////////////////////////////////////////////////////////////////////////////////
+        bool get_double_literal(double &value, const char *word, int size){
+          if (!openDDL_number_parser::parse_float(value, word, size)){
+            printf("It's not a correct float-literal!\n");
+            return false;
           }
           if (DEBUGGINGDDL) printf("Number-> %f ", value);
           return true;
@@ -513,7 +383,7 @@ namespace octet
         /// @param  size    this is the size of the word readed
         /// @return   True if everything went right, and false if something went wrong
         ////////////////////////////////////////////////////////////////////////////////
-        bool get_string_literal(string &value, char *word, int size){
+        bool get_string_literal(string &value, const char *word, int size){
           if (DEBUGGINGDDL) printf("Reading the string: ");
           char caracter;
           //first of all check if it's a correct string
@@ -600,7 +470,7 @@ namespace octet
         ///   The pointer new_word has to be previously initialized in memory with "size" 
         ///   reserved in memory. 
         ////////////////////////////////////////////////////////////////////////////////
-        bool get_string_literal(char * new_word, int &new_size, char *word, int size){
+        bool get_string_literal(char * new_word, int &new_size, const char *word, int size){
           if (DEBUGGINGDDL) printf("Reading the string: ");
           char caracter;
           //first of all check if it's a correct string
@@ -682,7 +552,7 @@ namespace octet
         /// @param  size    this is the size of the word readed
         /// @return   True if everything went right, and false if something went wrong
         ////////////////////////////////////////////////////////////////////////////////
-        bool get_char_literal(char &value, char *word, int size){
+        bool get_char_literal(char &value, const char *word, int size){
           if (DEBUGGINGDDL) printf("Reading the string: ");
           //first of all check if it's a correct char literal
           if (size < 3 || size > 5){
@@ -755,67 +625,84 @@ namespace octet
         }
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief  This function will check if it's a reference
-        /// @param  value   it returns the value of the reference
+        /// @brief  This function will read a string-literal and intern it in the atom table
+        /// @param  new_word   it returns the string interned (ended with \0)
+        /// @param  new_size   it returns the size of the string
+        /// @param  atom    it returns the atom of the string (or -1 in streaming mode)
         /// @param  word    this is a pointer to the beginning of the word
         /// @param  size    this is the size of the word readed
         /// @return   True if everything went right, and false if something went wrong
         ////////////////////////////////////////////////////////////////////////////////
-        bool get_value_reference(char *ref, int &new_size, bool &global, char *word, int size){
-          if (DEBUGGINGDDL) printf("Reading the reference: %s\n", word);
+        bool get_interned_string(char *&new_word, int &new_size, int &atom, const char *word, int size){
+          if ((int)string_buffer.size() < size + 1)
+            string_buffer.resize(size + 1);
+          new_size = 0;
+          bool no_error = get_string_literal(string_buffer.data(), new_size, word, size);
+          atom = intern(string_buffer.data(), new_size, new_word);
+          return no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function will check if it's a reference, and set it in a literal
+        /// @param  literal it returns the reference (ref_, its atom, the atoms of its names and if it's global)
+        /// @param  word    this is a pointer to the beginning of the word
+        /// @param  size    this is the size of the word readed
+        /// @return   True if everything went right, and false if something went wrong
+        ///   The reference is not looked for here (the name can be after the reference), check resolve_references
+        ////////////////////////////////////////////////////////////////////////////////
+        bool get_value_reference(openDDL_data_literal * literal, const char *word, int size){
+          if (DEBUGGINGDDL) printf("Reading the reference: %.*s\n", size, word);
         
+          // The reference is interned (even 'null'), so the same reference is always the same atom
+          literal->value_type = value_type_DDL::REF;
+          literal->atom_ = intern(word, size, literal->value.ref_);
+          literal->size_string_ = size;
+          literal->global_ref_ = *word == 0x24; // 24 = $, that means it's a global name
+          literal->path_ = NULL;
+          literal->path_size_ = 1;
+          literal->target_ = NULL;
           // A reference can be the identificator or name 'null'
-          if (size == 4){ //null size is 4
-            if (word[0] == 'n' && word[1] == 'u' && word[2] == 'l' && word[3] == 'l'){
-              ref = "NULL";
+          if (size == 4 && word[0] == 'n' && word[1] == 'u' && word[2] == 'l' && word[3] == 'l'){
+            if (DEBUGGINGDDL) printf("It's the null reference\n");
+            return true;
+          }
+          // The name can be followed by the local names of its substructures ($a%b%c), each one is interned by itself
+          path_buffer.resize(0);
+          char * part;
+          int part_begin = 0;
+          for (int i = 1; i <= size; ++i){
+            if (i == size || word[i] == 0x25){ // 25 = %
+              if (i < size || part_begin > 0)
+                path_buffer.push_back(intern(word + part_begin, i - part_begin, part));
+              part_begin = i;
             }
           }
-          // If it's not the null value...
-          else{
-            // pass from word to ref, and then work with ref!
-            for (int i = 0; i < size; ++i){
-              ref[i] = word[i];
+          // The local names can also be separated by whitespaces
+          while (!is_end_file() && current_char() != 0x7d && current_char() != 0x2c && current_char() != 0x29){ //While the current char is not the } or , or ) there must be more references to this reference
+            if (current_char() == 0x25){
+              if (path_buffer.size() == 0)
+                path_buffer.push_back(literal->atom_);
+              int part_size = read_word_size();
+              if (DEBUGGING) printf(" %.*s ", part_size, tempChar);
+              path_buffer.push_back(intern((const char *)tempChar, part_size, part));
+              remove_comments_whitespaces();
             }
-            new_size = size;
-            // it can be also a name
-            if (*word == 0x24){ // 24 = $, that means it's a global name
-              global = true;
-              //first step is to look if the global name exists
-              int nameID = names_.get_index(word);
-              //if it does not exist, pointer = NULL
-              if (nameID < 0){
-                names_[word] = NULL;
-              }
+            else if (is_whiteSpace() || is_comment()){
+              if (DEBUGGING) printf(" %c ", current_char());
+              remove_comments_whitespaces(); 
             }
-            else if (*word == 0x25){ // 25 = %, that means it's a local name
-              global = false;
-              //first step is to look if the local name exists
-              openDDL_identifier_structure * father = current_structure->get_father_structure();
-              int nameID = father->get_local_index(word);
-              //if it does not exist, pointer = NULL
-              if (nameID < 0){
-                father->set_local_name(word, NULL);
-              }
-            }
-            // followed optionally for some identifiers
-            string new_word;
-            while (*currentChar != 0x7d && *currentChar != 0x2c && *currentChar != 0x29){ //While the current char is not the } or , or ) there must be more references to this reference
-              if (*currentChar == 0x25){
-                get_next_char();
-                remove_comments_whitespaces();
-                new_word = read_word();
-                if (DEBUGGING) printf(" %s ", new_word);
-                get_next_char();
-                remove_comments_whitespaces();
-              }
-              else{
-                if (DEBUGGING) printf(" %c ", *currentChar);
-                remove_comments_whitespaces(); 
-              }
+            else{
+              printf("\nERROR: It's not a correct reference, it found a %c.\n", current_char());
+              return false;
             }
           }
+          if (path_buffer.size() > 1){
+            literal->path_size_ = (int)path_buffer.size();
+            literal->path_ = (int *)arena.allocate(path_buffer.size() * sizeof(int));
+            memcpy(literal->path_, path_buffer.data(), path_buffer.size() * sizeof(int));
+          }
 
-          if (DEBUGGINGDDL) printf("Reference with id: %s\n", ref);
+          if (DEBUGGINGDDL) printf("Reference with id: %s\n", literal->value.ref_);
           return true;
         }
 
@@ -826,75 +713,103 @@ namespace octet
         /// @param  size    this is the size of the word readed
         /// @return   True if everything went right, and false if something went wrong
         ////////////////////////////////////////////////////////////////////////////////
-        bool get_value_data_type(int &type, char *word, int size){
+        bool get_value_data_type(int &type, const char *word, int size){
           return true;
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function will intern a string of the document in the atom table (check openDDL_atoms.h)
+        /// @param  chars  The characters of the string
+        /// @param  size  The number of characters
+        /// @param  interned  It returns the string of the table (ended with \0), valid till the document is released
+        /// @return The atom of the string, or -1 in streaming mode
+        ///   All the lexers of a document share the table of language, the workers of lexer_parallel lock it.
+        ///   In streaming mode the strings are not kept after their structure, so they are copied in the arena instead.
+        ////////////////////////////////////////////////////////////////////////////////
+        int intern(const char * chars, int size, char *&interned){
+          if (handler != NULL){
+            interned = arena.make_string(chars, size);
+            return -1;
+          }
+          if (language == this){
+            int atom = atoms.intern(chars, size);
+            interned = atoms.get_name(atom);
+            return atom;
+          }
+          std::lock_guard<std::mutex> lock(language->atoms_mutex);
+          int atom = language->atoms.intern(chars, size);
+          interned = language->atoms.get_name(atom);
+          return atom;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function will get the structure with a name of this lexer (global, or local of the top level)
+        /// @param  names  global_names or root_names
+        /// @param  atom  The atom of the name
+        /// @return The structure with this name, it's NULL if the name was not found yet (it's added then)
+        ////////////////////////////////////////////////////////////////////////////////
+        static openDDL_structure *&get_named(dynarray<openDDL_structure *> &names, int atom){
+          if ((unsigned int)atom >= names.size()){
+            unsigned int old_size = names.size();
+            names.resize(atom + 1);
+            for (unsigned int i = old_size; i < names.size(); ++i)
+              names[i] = NULL;
+          }
+          return names[atom];
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This functions process the name, and add it to the application
         /// @param  structure   This is a pointer to the structure that will have this name
-        /// @return   The ID of the name
+        /// @return   The ID of the name (its atom)
         ////////////////////////////////////////////////////////////////////////////////
-        int process_name(openDDL_structure * father_structure){
+        int process_name(openDDL_identifier_structure * father_structure){
           char *name;
           int size_name = read_word_size();
-          name = new char[size_name+1];
-          for (int i = 0; i < size_name; ++i){
-            name[i] = tempChar[i];
-          }
-          name[size_name] = '\0';
+          int nameID = intern((const char*)tempChar, size_name, name);
           if(DEBUGGING) printf("It's the name %s<<!!\n", name);
+          current_structure->set_name(name);
+
+          //In streaming mode there is no tree to look for the names, so they are only given to the handler
+          if (handler != NULL)
+            return 0;
         
-          int nameID;
+          current_structure->set_nameID(nameID);
           if (*name == 0x24){ //It's a global name
-            if (DEBUGGING) printf("Globaling name\n");
-            nameID = names_.get_index(name);
-            if (DEBUGGING) printf("Name ID is %i\n", nameID);
-            if (nameID < 0){
-              names_[name] = current_structure;
-              nameID = names_.get_index(name);
-              if (DEBUGGING) printf("NEW Name ID is %i\n", nameID);
-              current_structure->set_nameID(nameID);
-              current_structure->set_name(name);
+            if (DEBUGGING) printf("Globaling name %i\n", nameID);
+            openDDL_structure *&named = get_named(global_names, nameID);
+            if (named == NULL){
+              named = current_structure;
+              if (language != this)
+                global_named.push_back(current_structure);
             }
             else{
-              current_structure->set_nameID(nameID);
-              current_structure->set_name(name);
-              if (names_[name] == NULL){
-                if (DEBUGGING) printf("Adding new content to name\n");
-                names_[name] = current_structure;
+              printf("This global name already exists!\n");
+              return -1;
+            }
+          }
+          else if (*name == 0x25){ //It's a local name
+            if (DEBUGGING) printf("Localing name %i\n", nameID);
+            //The local names are found in the substructures of the father (this structure is added to it when it's finished)
+            //but the structures of the top level have no father, so they are kept like the global names
+            if (father_structure == NULL){
+              openDDL_structure *&named = get_named(root_names, nameID);
+              if (named == NULL){
+                named = current_structure;
+                if (language != this)
+                  global_named.push_back(current_structure);
               }
               else{
-                printf("This global name already exists!\n");
+                printf("This local name already exists!\n");
                 return -1;
               }
             }
-          }
-          else if (*name == 0x25){ //It's a local name
-            if (DEBUGGING) printf("Localing name\n");
-            nameID = father_structure->get_local_index(name);
-            if (DEBUGGING) printf("Name ID is %i\n", nameID);
-            if (nameID < 0){
-              father_structure->set_local_name(name, current_structure);
-              nameID = father_structure->get_local_index(name);
-              current_structure->set_nameID(father_structure->get_local_index(name));
-              current_structure->set_name(name);
-              if (DEBUGGING) printf("NEW Name ID is %i\n", father_structure->get_local_index(name));
-            }
-            else{
-              current_structure->set_nameID(father_structure->get_local_index(name));
-              current_structure->set_name(name);
-              nameID = father_structure->get_local_index(name);
-              if (father_structure->get_local_name(name) == NULL){
-                if (DEBUGGING) printf("Adding new content to name\n");
-                father_structure->set_local_name(name, current_structure);
-              }
+            else if (father_structure->find_local_name(nameID) != NULL){
               printf("This local name already exists!\n");
               return -1;
             }
           }
         
-          if (nameID < 0) printf("ERROR!!!!!!!! At this point the name has to exist!\n\n");
           return nameID;
         }
 
@@ -908,11 +823,9 @@ namespace octet
         ///     is expecting it will store properly the property. If it's not correct, it will print an error reading the file
         ////////////////////////////////////////////////////////////////////////////////
         bool process_single_property(openDDL_properties * new_property, int type_known = -1){
-          string word;
-
           //Now it has to find a identifier
-          word = read_word();
-          int type = is_identifier(word);
+          int size_word = read_word_size();
+          int type = is_identifier((const char*)tempChar, size_word);
           new_property->identifierID = type;
           //Now check if it's a correct property
           if (type < 0){
@@ -922,8 +835,8 @@ namespace octet
           remove_comments_whitespaces();
 
           //Now it has to find an =
-          if (*currentChar != 0x3D){
-            printf("\nERROR: It was expecting a '=' and find %c instead.\n", *currentChar);
+          if (current_char() != 0x3D){
+            printf("\nERROR: It was expecting a '=' and find %c instead.\n", current_char());
             return false;
           }
           get_next_char();
@@ -932,36 +845,31 @@ namespace octet
           //Not it has to find a literal, that might be (bool, int, float, string, ref or type)
           int size;
           read_data_property(size);
+          if (size == 0){
+            printf("\nERROR: It was expecting the value of the property.\n");
+            return false;
+          }
 
           // Check if it's a string
           if (*tempChar == 0x22){ //22 = "
-            //Get ready the data to store the size
-            char * new_string = new char[size];
+            char * new_string;
             int new_size;
             // Obtain the string from the property
-            get_string_literal(new_string, new_size, (char*) tempChar, size);
+            get_interned_string(new_string, new_size, new_property->literal.atom_, (const char*) tempChar, size);
             // Set new property with the new value as string!
             new_property->literal.value_type = value_type_DDL::STRING;
             new_property->literal.value.string_ = new_string;
             new_property->literal.size_string_ = new_size;
           }
           else if (*tempChar == 0x24 || *tempChar == 0x25){  //24 = $, 25= %
-            //Get ready the data to store the size
-            char * new_string = new char[size+1];
-            int new_size;
-            bool global;
-            // Obtain the ref from the property
-            get_value_reference(new_string, new_size, global, (char*)tempChar, size);
-            // Set new property with the new value as reference
-            new_property->literal.value_type = value_type_DDL::REF;
-            new_property->literal.value.ref_ = new_string;
-            new_property->literal.value.ref_[new_size] = '\0';
-            new_property->literal.global_ref_ = global;
+            // Obtain the ref from the property, and set it as the new value of the property
+            if (!get_value_reference(&new_property->literal, (const char*)tempChar, size))
+              return false;
           }
           //Check if it's a data_type
           else if (*tempChar == 't' || *tempChar == 'b'){
             bool bool_value = false;
-            get_bool_literal(bool_value, (char*)tempChar, size);
+            get_bool_literal(bool_value, (const char*)tempChar, size);
             // Set new property with the new value as bool!
             new_property->literal.value_type = value_type_DDL::BOOL;
             new_property->literal.value.bool_ = bool_value;
@@ -969,11 +877,11 @@ namespace octet
           }
           else{
             float value;
-            get_float_literal(value, (char*)tempChar, size);
+            get_float_literal(value, (const char*)tempChar, size);
             new_property->literal.value.float_ = value;
             new_property->literal.value_type = value_type_DDL::FLOAT;
           }
-          if (DEBUGGING) printf("\n\tCurrent character after the word %s!! %c\n\n", string((char*)tempChar, size), *currentChar);
+          if (DEBUGGING) printf("\n\tCurrent character after the word %s!! %c\n\n", string((const char*)tempChar, size), current_char());
 
           return true;
         }
@@ -990,18 +898,21 @@ namespace octet
           remove_comments_whitespaces();
 
           //process the first element
-          openDDL_properties * new_property = new openDDL_properties();
+          property_buffer.resize(1);
+          openDDL_properties * new_property = &property_buffer[0];
+          memset(new_property, 0, sizeof(openDDL_properties));
           current_structure = structure;
           no_error = process_single_property(new_property);
-          //printf("Property %i with %i\n", identifiers_.get_value(new_property->identifierID), new_property->literal.value.integer_);
-          structure->add_property(new_property);
+          //printf("Property %i with %i\n", new_property->identifierID, new_property->literal.value.integer_);
+          if (no_error && handler != NULL)
+            no_error = handler->property(new_property->identifierID, new_property->literal);
 
           //it will have to expect more properties as long as it's not a )
-          while (*currentChar != 0x29 && no_error){ // 0x29 = )
+          while (current_char() != 0x29 && no_error){ // 0x29 = )
             if (DEBUGGINGDDL) printf("More properties!\n");
             //before going on, check that it's a proper list of properties, that's so, it has to have a ,
-            if (*currentChar != 0x2C){ // 0x2C = ,   
-              printf("\n\nERROR!! It was expecting a ',' and it found a %c instead.\n", *currentChar);
+            if (current_char() != 0x2C){ // 0x2C = ,   
+              printf("\n\nERROR!! It was expecting a ',' and it found a %c instead.\n", current_char());
               return false;
             }
             else{
@@ -1009,29 +920,57 @@ namespace octet
               remove_comments_whitespaces();
             }
             //now, keep on processing properties
-            new_property = new openDDL_properties();
+            property_buffer.resize(property_buffer.size() + 1);
+            new_property = &property_buffer[property_buffer.size() - 1];
+            memset(new_property, 0, sizeof(openDDL_properties));
             current_structure = structure;
             no_error = process_single_property(new_property);
-            structure->add_property(new_property);
+            if (no_error && handler != NULL)
+              no_error = handler->property(new_property->identifierID, new_property->literal);
+          }
+          //All the properties of the structure are stored together
+          if (handler == NULL){
+            openDDL_properties * properties = (openDDL_properties *)arena.allocate(property_buffer.size() * sizeof(openDDL_properties));
+            memcpy(properties, property_buffer.data(), property_buffer.size() * sizeof(openDDL_properties));
+            structure->set_properties(properties, (int)property_buffer.size());
           }
           get_next_char();
           return no_error;
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function copies the word that starts in tempChar into the word_buffer
+        /// @param  size  The size of the word
+        /// @return A pointer to the copy of the word (ended with \0), it's only valid till the next call
+        ///   There are always 8 characters after the word that can be read (so the numbers can be read 8 at a time)
+        ////////////////////////////////////////////////////////////////////////////////
+        char * copy_word(int size){
+          if ((int)word_buffer.size() < size + 8)
+            word_buffer.resize(size + 8);
+          char * word = word_buffer.data();
+          for (int i = 0; i < size; ++i)
+            word[i] = tempChar[i];
+          word[size] = '\0';
+          return word;
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This functions process the data list, taking into account the type of data expected
         /// @param  type  represent the type of element that it's expecting
-        /// @param  size  The size of the word to read (starting with tempChar)
+        /// @param  word  The word to process
+        /// @param  size  The size of the word to read
+        ///   The numbers (and bools) are added with their native type to the contiguous array of current_data_list
+        ///   The strings, refs and types are added as a new literal to current_data_list
         ////////////////////////////////////////////////////////////////////////////////
-        void process_data_list_element(int type, char* word, int size){
+        bool process_data_list_element(int type, const char* word, int size){
           bool no_error = true;
-          //string word((char*)tempChar, size);
           //Check the type, and call to the appropriate processor function
           switch (type){
           case token_type::tok_bool:
           {
-            bool valueBool;
-            no_error = get_bool_literal(valueBool, (char*)tempChar, size);
+            bool valueBool = false;
+            no_error = get_bool_literal(valueBool, word, size);
+            current_data_list->add_value<bool>(valueBool);
             break;
           }
           case token_type::tok_int8:
@@ -1043,105 +982,242 @@ namespace octet
           case token_type::tok_uint32:
           case token_type::tok_uint64:
           {
-            no_error = get_integer_literal(current_literal->value.integer_, word, size);
+            uint64_t valueInt = 0;
+            no_error = get_integer_literal(valueInt, word, size);
+            switch (type){
+            case token_type::tok_int8: current_data_list->add_value<int8_t>((int8_t)valueInt); break;
+            case token_type::tok_int16: current_data_list->add_value<int16_t>((int16_t)valueInt); break;
+            case token_type::tok_int32: current_data_list->add_value<int32_t>((int32_t)valueInt); break;
+            case token_type::tok_int64: current_data_list->add_value<int64_t>((int64_t)valueInt); break;
+            case token_type::tok_uint8: current_data_list->add_value<uint8_t>((uint8_t)valueInt); break;
+            case token_type::tok_uint16: current_data_list->add_value<uint16_t>((uint16_t)valueInt); break;
+            case token_type::tok_uint32: current_data_list->add_value<uint32_t>((uint32_t)valueInt); break;
+            default: current_data_list->add_value<uint64_t>(valueInt); break;
+            }
             break;
           }
           case token_type::tok_float:
+          {
+            float valueFloat = 0.0f;
+            no_error = get_float_literal(valueFloat, word, size);
+            current_data_list->add_value<float>(valueFloat);
+            break;
+          }
           case token_type::tok_double:
           {
-            no_error = get_float_literal(current_literal->value.float_, word, size);
+            double valueDouble = 0.0;
+            no_error = get_double_literal(valueDouble, word, size);
+            current_data_list->add_value<double>(valueDouble);
             break;
           }
           case token_type::tok_string:
           {
-            char * new_string = new char[size];
+            current_literal = arena.make<openDDL_data_literal>();
+            char * new_string;
             int new_size;
             // Obtain the string from the property
-            no_error = get_string_literal(new_string, new_size, word, size);
+            no_error = get_interned_string(new_string, new_size, current_literal->atom_, word, size);
             // Set new property with the new value as string!
             current_literal->value_type = value_type_DDL::STRING;
             current_literal->value.string_ = new_string;
             current_literal->size_string_ = new_size;
-          
+            current_data_list->add_literal(current_literal);
             break;
           }
           case token_type::tok_ref:
           {
-            char * new_string = new char[size];
-            int new_size;
-            no_error = get_value_reference(new_string, new_size, current_literal->global_ref_, word, size);
-            // Set new property with the new value as reference
-            current_literal->value_type = value_type_DDL::REF;
-            new_string[new_size] = '\0';
-            current_literal->value.ref_ = new_string;
-            current_literal->size_string_ = new_size;
+            current_literal = arena.make<openDDL_data_literal>();
+            no_error = get_value_reference(current_literal, word, size);
+            current_data_list->add_literal(current_literal);
             break;
           }
           case token_type::tok_type:
           {
+            current_literal = arena.make<openDDL_data_literal>();
             no_error = get_value_data_type(current_literal->value.type_, word, size);
+            current_literal->value_type = value_type_DDL::TYPE;
+            current_data_list->add_literal(current_literal);
             break;
           }
           default:
             break;
           };
+          return no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function returns the data_list where the elements of a new list will be stored
+        /// @param  type  This is the type of the elements of the list
+        /// @return A new data_list of the document, or the stream_data_list (emptied) if there is a handler
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_data_list * new_data_list(int type){
+          if (handler != NULL){
+            stream_data_list.clear(type);
+            return &stream_data_list;
+          }
+          return arena.make<openDDL_data_list>(type);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function sends the elements of the stream_data_list to the handler (only in streaming mode)
+        /// @param  last  True at the end of the data list, if not they are only sent when there are STREAM_CHUNK_ELEMENTS
+        /// @return False if the handler wants to stop the lexer
+        ////////////////////////////////////////////////////////////////////////////////
+        bool send_data_list_chunk(bool last){
+          if (handler == NULL || stream_data_list.size() == 0 || (!last && stream_data_list.size() < STREAM_CHUNK_ELEMENTS))
+            return true;
+          bool no_error = handler->data_list_chunk(stream_data_list.token_type, stream_data_list);
+          stream_data_list.clear(stream_data_list.token_type);
+          return no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function checks again how an element of a data list ended, after processing it
+        /// @param  ending  What read_data_list_element returned
+        /// @return 1 if there are more elements, 0 if it's the end of the list, -1 if there is an error
+        ///   A reference can go on after a whitespace ($a %b), so it's read by get_value_reference till the , or }
+        ////////////////////////////////////////////////////////////////////////////////
+        int element_ending(int ending){
+          if (ending >= 0)
+            return ending;
+          return current_char() == 0x2c ? 1 : (current_char() == 0x7d ? 0 : -1); //2c = , and 7d = }
         }
 
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This function has to process the datalist
         /// @param  type  This is the type of the data list elements
+        /// @param  count  The number of elements if it's known (lazy mode), to reserve the memory at once
         /// @return true if it went ok and false if there was any problem (for instance not finding a })
         ///   This function will keep on checking data until it finds a }. 
         ////////////////////////////////////////////////////////////////////////////////
-        bool process_data_list(int type){
+        bool process_data_list(int type, size_t count = 0){
           int ending, size;
           char *word = NULL;
 
           remove_comments_whitespaces();
-          if (*currentChar == 0x7d){ //7d = },  if the next character is }, that means that it's empty!!!
+          if (current_char() == 0x7d){ //7d = },  if the next character is }, that means that it's empty!!!
             return true;
           }
         
-          // Initializing the new data_list
-          current_data_list = new openDDL_data_list;
-          //This powerfull line  converts from the numeration given in openDDL_tokes for types to the one given in value_type_DDL
-          current_data_list->value_type = (value_type_DDL) convert_type_token_to_DDL(type);
+          // Initializing the new data_list (it knows its value_type from the token of the type)
+          current_data_list = new_data_list(type);
           // Reserve some space prior to start
-          current_data_list->data_list.reserve(MIN_RESERVING_DATA_LIST);
+          current_data_list->reserve(count > MIN_RESERVING_DATA_LIST ? count : MIN_RESERVING_DATA_LIST);
 
           //Read the first element, process it and add it to data_list
-          current_literal = new openDDL_data_literal;
           ending = read_data_list_element(size);
-          word = new char[size + 1];
-          for (int i = 0; i < size; ++i)
-            word[i] = tempChar[i];
-          word[size] = '\0';
+          word = copy_word(size);
           process_data_list_element(type, word, size);
-          current_literal->value_type = current_data_list->value_type;
-          current_data_list->data_list.push_back(current_literal);
+          ending = element_ending(ending);
 
           //If there are more elements...
           while (ending == 1){ //keep on reading while there are more elements
             get_next_char();
             remove_comments_whitespaces();
             //Read next element, process it, and add it to data_list
-            current_literal = new openDDL_data_literal();
             ending = read_data_list_element(size);
-            word = new char[size + 1];
-            for (int i = 0; i < size; ++i)
-              word[i] = tempChar[i];
-            word[size] = '\0';
+            word = copy_word(size);
             process_data_list_element(type, word, size);
-            current_literal->value_type = current_data_list->value_type;
-            current_data_list->data_list.push_back(current_literal);
-          }
+            ending = element_ending(ending);
+            if (!send_data_list_chunk(false))
+              return false;
+            }
           if (DEBUGGINGDDL) printf("\n");
 
+          if (handler != NULL)
+            return send_data_list_chunk(true);
           ((openDDL_data_type_structure *)current_structure)->add_data_list(current_data_list);
 
           return true;
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  These functions read a number of a data array list directly from the characters (no copy of the word)
+        /// @param  value  The value read (it keeps its value if the word is not correct)
+        /// @param  word  The first character of the word
+        /// @param  size  The size of the word
+        /// @param  padded  True if there are 8 characters after the word that can be read
+        /// @return True if the word is a correct literal of the type
+        ///   The overload is chosen when compiling process_data_array_values, so there is no switch per element
+        ////////////////////////////////////////////////////////////////////////////////
+        bool read_element(bool &value, const char * word, int size, bool padded){
+          return get_bool_literal(value, word, size);
+        }
+
+        bool read_element(float &value, const char * word, int size, bool padded){
+          return get_float_literal(value, word, size);
+        }
+
+        bool read_element(double &value, const char * word, int size, bool padded){
+          return get_double_literal(value, word, size);
+        }
+
+        template <class integer_type> bool read_element(integer_type &value, const char * word, int size, bool padded){
+          uint64_t integer = 0;
+          if (!get_integer_literal(integer, word, size, padded))
+            return false;
+          value = (integer_type)integer;
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function decodes all the subarrays of a data array list of numbers, for one type of element
+        /// @param  arraySize   This is the size of the subarrays
+        /// @return true if it went ok and false if there was any problem (for instance not finding a })
+        ///   The space of each subarray is added at once to current_data_list, and the elements are written directly
+        ///   into it, so there is no allocation or switch of the type per element. It finishes in the } of the list.
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class element_type> bool process_data_array_values(int arraySize){
+          int size;
+          while (current_char() != 0x7d){ //7d = } (the end of the data array list)
+            if (current_char() == 0x2c){ //2c = ,
+              get_next_char();
+              remove_comments_whitespaces();
+            }
+            if (current_char() != 0x7b){ //7b = {
+              printf("Problem reading the begining of the data array!!! \n");
+              return false;
+            }
+            element_type * values = current_data_list->append_values<element_type>(arraySize);
+            for (int i = 0; i < arraySize; ++i){
+              get_next_char();
+              remove_comments_whitespaces();
+              read_data_list_element(size);
+              element_type value = element_type();
+              read_element(value, (const char *)tempChar, size, (currentChar + bufferSize) - (tempChar + size) >= 8);
+              values[i] = value;
+            }
+            if (current_char() != 0x7d) //7d = }
+              return false;
+            get_next_char();
+            remove_comments_whitespaces();
+          }
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function chooses the decoder of the subarrays of numbers for the type of the elements
+        /// @param  type  This is the type of the elements (it has to be a number or a bool)
+        /// @param  arraySize   This is the size of the subarrays
+        /// @return true if it went ok and false if there was any problem
+        ////////////////////////////////////////////////////////////////////////////////
+        bool process_data_array_numbers(int type, int arraySize){
+          switch (type){
+          case token_type::tok_bool: return process_data_array_values<bool>(arraySize);
+          case token_type::tok_int8: return process_data_array_values<int8_t>(arraySize);
+          case token_type::tok_int16: return process_data_array_values<int16_t>(arraySize);
+          case token_type::tok_int32: return process_data_array_values<int32_t>(arraySize);
+          case token_type::tok_int64: return process_data_array_values<int64_t>(arraySize);
+          case token_type::tok_uint8: return process_data_array_values<uint8_t>(arraySize);
+          case token_type::tok_uint16: return process_data_array_values<uint16_t>(arraySize);
+          case token_type::tok_uint32: return process_data_array_values<uint32_t>(arraySize);
+          case token_type::tok_uint64: return process_data_array_values<uint64_t>(arraySize);
+          case token_type::tok_float: return process_data_array_values<float>(arraySize);
+          case token_type::tok_double: return process_data_array_values<double>(arraySize);
+          default: return false;
+          }
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This function has to process the dataarraylist
         /// @param  type  This is the type of the elements that it's reading in the array
@@ -1152,11 +1228,11 @@ namespace octet
         bool process_data_array(int type, int arraySize){
           char * word;
           //detect {
-          if (*currentChar == 0x2c){ //2c = ,
+          if (current_char() == 0x2c){ //2c = ,
             get_next_char();
             remove_comments_whitespaces();
           }
-          if (*currentChar != 0x7b){ //7b = {
+          if (current_char() != 0x7b){ //7b = {
             printf("Problem reading the begining of the data array!!! \n");
             return false;
           }
@@ -1167,20 +1243,14 @@ namespace octet
           while (itemsLeft > 0){
             get_next_char();
             remove_comments_whitespaces();
-            current_literal = new openDDL_data_literal();
             ending = read_data_list_element(wordSize);
-            word = new char[wordSize + 1];
-            for (int i = 0; i < wordSize; ++i)
-              word[i] = tempChar[i];
-            word[wordSize] = '\0';
+            word = copy_word(wordSize);
             process_data_list_element(type, word, wordSize);
-            current_literal->value_type = current_data_list->value_type;
-            current_data_list->data_list.push_back(current_literal);
             --itemsLeft;
           }
           //detect }
           if (DEBUGGINGDDL) printf("_%x\n", currentChar[0]);
-          if (*currentChar != 0x7d){ //7d = }
+          if (current_char() != 0x7d){ //7d = }
             return false;
             printf("I Don't find the } inside process_data_array\n");
           }
@@ -1192,31 +1262,46 @@ namespace octet
         /// @brief  This function has to process the datalist
         /// @param  type  This is the type of the elements that it's reading in the array
         /// @param  arraySize   This is the size of the array (it will be used to make faster the parser process)
+        /// @param  count  The number of elements if it's known (lazy mode), to reserve the memory at once
         /// @return true if it went ok and false if there was any problem (for instance not finding a })
         ///  This function will keep on checking data until it finds a }. 
+        ///  All the subarrays are stored one after the other in the same list (set_array_data of the structure)
         ////////////////////////////////////////////////////////////////////////////////
-        bool process_data_array_list(int type, int arraySize){
+        bool process_data_array_list(int type, int arraySize, size_t count = 0){
           bool no_error = true;
-          value_type_DDL translated_type = (value_type_DDL)((type>8) ? (type - 6) : ((type>4) ? 0 : (type == 0) ? 2 : 1));;
-          if (*currentChar != 0x7b){ //7b = {
+          if (current_char() != 0x7b){ //7b = {
             printf("Problem reading the begining of the data array list!!! \n");
             return false;
           }
           get_next_char();
           remove_comments_whitespaces();
 
-          while (no_error && *currentChar != 0x7d){
-            current_data_list = new openDDL_data_list();
-            current_data_list->value_type = translated_type;
+          //In streaming mode the list is sent in chunks of complete subarrays
+          current_data_list = new_data_list(type);
+          if (handler == NULL){
+            current_data_list->reserve(count);
+            ((openDDL_data_type_structure *)current_structure)->set_array_data(current_data_list);
+            //The numbers are decoded in bulk, the strings, refs and types with process_data_array
+            if (current_data_list->is_numeric() && !process_data_array_numbers(type, arraySize)){
+              //Like process_data_array, jump the character where the subarray failed
+              no_error = false;
+              get_next_char();
+              remove_comments_whitespaces();
+            }
+          }
+          while (no_error && current_char() != 0x7d){
             no_error = process_data_array(type, arraySize); //This will have to start with {, read arraySize elements, read }
             get_next_char();
             remove_comments_whitespaces();
-            ((openDDL_data_type_structure *)current_structure)->add_data_list(current_data_list);
+            if (no_error)
+              no_error = send_data_list_chunk(false);
             if (DEBUGGINGDDL) printf("After data array...%x\n", currentChar[0]);
           }
+          if (no_error)
+            no_error = send_data_list_chunk(true);
           //expect } (7d)
 
-          if (*currentChar != 0x7d){
+          if (current_char() != 0x7d){
             no_error = false;
             printf("----ERROR WITH DATA ARRAY LIST\n");
           }
@@ -1224,6 +1309,46 @@ namespace octet
           return no_error;
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function jumps the data lists of a structure without decoding them (lazy mode)
+        /// @param  structure  The structure of data type, it will keep the characters of the lists to decode them later
+        /// @param  arraySize  The size of the subarrays, or -1 if it's a data list
+        /// @return true if it went ok and false if there was any problem (not finding the })
+        ///   The currentChar has to be after the { of a data list (it cannot be empty), or in the { of a data array list.
+        ///   The elements are counted (without decoding them), and the currentChar finishes in the } like process_data_list
+        ////////////////////////////////////////////////////////////////////////////////
+        bool skip_data_lists(openDDL_data_type_structure * structure, int arraySize){
+          const uint8_t * begin = currentChar;
+          const uint8_t * end = currentChar + bufferSize;
+          size_t commas, subarrays;
+          //The data array lists start in their {, so the subarrays are inside it
+          const uint8_t * list_end = openDDL_scanner::find_data_list_end(arraySize < 0 ? begin : begin + 1, end, commas, subarrays);
+          if (list_end == end){
+            printf("\nERROR: The file finished before the } of the data list!!!\n\n");
+            return false;
+          }
+          structure->set_lazy_data(begin, list_end, arraySize < 0 ? commas + 1 : subarrays * arraySize, language);
+          char_jump(list_end - currentChar);
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This function uses the structural index to find the size of the word that starts in currentChar
+        /// @param  closing  The character that closes the list of words: } in the data lists, ) in the properties
+        /// @return The size of the word, it finishes before the next , closing or comment (or before a whitespace)
+        ///   The index jumps directly to the next structural character, so only the characters of the word are checked
+        ////////////////////////////////////////////////////////////////////////////////
+        int indexed_word_size(uint8_t closing){
+          const uint8_t * end = currentChar + bufferSize;
+          const uint8_t * stop = structural_index.next(currentChar);
+          while (stop < end && *stop != 0x2c && *stop != closing && *stop != 0x2f) //2c = , and 2f = / (a comment)
+            stop = structural_index.next(stop + 1);
+          const uint8_t * c = currentChar;
+          while (c < stop && *c > 0x20)
+            ++c;
+          return (int)(c - currentChar);
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This function will read a data-list element and will return if error or more elements
         /// @param  size  This function read the size of the next word and returns it also as a parameter 
@@ -1238,15 +1363,19 @@ namespace octet
           tempChar = currentChar;
           //If the element to read is a char literal or a string literal, we cannot ignore all whitespaces, so we will
           // have to use a different way to stop it with whitespaces
-          if (*currentChar == 0x27 || *currentChar == 0x22){ //27 = ' and 22 = "
-            while (*currentChar != 0x2c && *currentChar != 0x7d && !(*currentChar != 0x20 && is_whiteSpace()) && !is_comment()){
-              if (DEBUGGINGDDLMORE) printf("%c, ", *currentChar);
+          if (current_char() == 0x27 || current_char() == 0x22){ //27 = ' and 22 = "
+            while (current_char() != 0x2c && current_char() != 0x7d && !(current_char() != 0x20 && is_whiteSpace()) && !is_comment()){
+              if (DEBUGGINGDDLMORE) printf("%c, ", current_char());
               get_next_char();
               ++sizeWord;
             }
           }
+          else if (indexed){
+            sizeWord = indexed_word_size(0x7d); //7d = }
+            char_jump(sizeWord);
+          }
           else{
-            while (*currentChar != 0x2c && *currentChar != 0x7d && !is_whiteSpace() && !is_comment()){
+            while (current_char() != 0x2c && current_char() != 0x7d && !is_whiteSpace() && !is_comment()){
               if (DEBUGGINGDDLMORE) printf("%x, ", currentChar[0]);
               get_next_char();
               ++sizeWord;
@@ -1254,7 +1383,7 @@ namespace octet
           }
           remove_comments_whitespaces();
 
-          switch (*currentChar){
+          switch (current_char()){
           case 0x2c: //2c = ,
             to_return = 1;
             break;
@@ -1279,38 +1408,42 @@ namespace octet
         int read_data_property(int &size){
           size = 0;
           tempChar = currentChar;
-          while (*currentChar != 0x2C && *currentChar != 0x29 && !is_whiteSpace() && !is_comment()){
-            if (DEBUGGINGDDLMORE) printf("%x, ", *currentChar);
+          if (indexed && current_char() != 0x22 && current_char() != 0x27){ //22 = " and 27 = ' (the strings are read as usual)
+            size = indexed_word_size(0x29); //29 = )
+            char_jump(size);
+          }
+          while (current_char() != 0x2C && current_char() != 0x29 && !is_whiteSpace() && !is_comment()){
+            if (DEBUGGINGDDLMORE) printf("%x, ", current_char());
             ++size;
             get_next_char();
           }
 
           remove_comments_whitespaces();
-          if (*currentChar == 0x2C)
+          if (current_char() == 0x2C)
             return 1;
-          else if (*currentChar == 0x29)
+          else if (current_char() == 0x29)
             return 0;
           return -1;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief  This function will check the size of the array
-        /// @return Returns the size of the array
+        /// @return Returns the size of the array, or -1 if it's not a correct size (or it does not fit in an int)
         ////////////////////////////////////////////////////////////////////////////////
         int read_array_size(){
-          int sizeNumber = 0, number = 0, pow = 1;
+          int sizeNumber = 0;
           tempChar = currentChar;
-          while (*currentChar != 0x5d){ // 5d = ]
+          while (!is_end_file() && current_char() != 0x5d){ // 5d = ]
             get_next_char();
             ++sizeNumber;
           }
           if (DEBUGGINGDDLMORE) printf("\n");
-          --sizeNumber;
-          for (int i = 0; i <= sizeNumber; ++i){
-            number += pow*((int)tempChar[sizeNumber-i]-48);
-            pow *= 10;
+          uint64_t number;
+          if (!openDDL_number_parser::parse_integer(number, (const char*)tempChar, sizeNumber) || number == 0 || number > 0x7FFFFFFF){
+            printf("ERROR: The size of the array is not correct!\n");
+            return -1;
           }
-          return number;
+          return (int)number;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -1336,7 +1469,7 @@ namespace octet
               get_next_char();
             }
           }
-          string temp((char*)(tempChar), sizeWord);
+          string temp((const char*)(tempChar), sizeWord);
           if (DEBUGGING) printf("Last symbol-> %x finding %s\n", currentChar[0], temp);
           if (DEBUGGING) printf("Finding => %s ", temp);
           return temp;
@@ -1385,30 +1518,34 @@ namespace octet
           openDDL_data_type_structure * data_type_structure;
           //Then it will read the first character, to see if its a [, or {, or name
           //if name it is a only dataList, so call to process_dataList() and tell that function if has a name or not
-          if (*currentChar == 0x5b){ // 5b = [
+          if (current_char() == 0x5b){ // 5b = [
             if (DEBUGGING) printf("It's a data array list!\n");
             //check integer-literal (for a data array list)
             get_next_char();
             arraySize = read_array_size();
+            if (arraySize < 0)
+              return NULL;
             if (DEBUGGINGMORE) printf("The size is %i\n", arraySize);
             get_next_char();
             remove_comments_whitespaces();
 
+            // Get ready to create a new structure of data_type (before the name, so the name is given to this structure)
+            data_type_structure = arena.make<openDDL_data_type_structure>(type, arraySize, father);
+            current_structure = data_type_structure;
+
             //it may receive a name (optional)
-            int nameID = -1;
             if (is_name()){
-              nameID = process_name(father);
+              process_name(father);
               get_next_char();
             }
-
-            // Get ready to create a new structure of data_type
-            data_type_structure = new openDDL_data_type_structure(type, arraySize, father, nameID);
-            data_type_structure->set_integer_literal(arraySize);
             remove_comments_whitespaces();
+            if (handler != NULL && !handler->begin_structure(DATA_TYPE_TYPE, type, data_type_structure->get_name(), arraySize))
+              return NULL;
 
             //expect a { (if not, error)
-            current_structure = data_type_structure;
-            if (*currentChar == 0x7b) //7b = {
+            if (current_char() == 0x7b && lazy) //7b = {
+              no_error = skip_data_lists(data_type_structure, arraySize);
+            else if (current_char() == 0x7b)
               no_error = process_data_array_list(type, arraySize);
             else{ //call to process data array list, it will check the }
               no_error = false; //return error
@@ -1418,23 +1555,27 @@ namespace octet
 
           //now check the other option (name) { data-list* }
           else{
-            int nameID = -1;
+            // Get ready to create a new structure of data_type (it has an array size of -1, because it's not array_size
+            data_type_structure = arena.make<openDDL_data_type_structure>(type, -1, father);
+            current_structure = data_type_structure;
+
             if (is_name()){ // check if there is a name, and process it
               if (DEBUGGING) printf("It's a name + data list!\n");
-              nameID = process_name(father);
+              process_name(father);
               get_next_char();
             }
-
-            // Get ready to create a new structure of data_type (it has an array size of -1, because it's not array_size
-            data_type_structure = new openDDL_data_type_structure(type, -1, father, nameID);
+            if (handler != NULL && !handler->begin_structure(DATA_TYPE_TYPE, type, data_type_structure->get_name(), -1))
+              return NULL;
 
             //After the optional name, it expects a {, and analize the data_list
-            if (*currentChar == 0x7b){ // 7b = {
+            if (current_char() == 0x7b){ // 7b = {
               if (DEBUGGING) printf("It's a data list!\n");
               get_next_char();
               remove_comments_whitespaces();
-              current_structure = data_type_structure;
-              no_error = process_data_list(type);  //expect a } (if not, error)
+              if (lazy && current_char() != 0x7d) //7d = } (the empty lists are not kept for later)
+                no_error = skip_data_lists(data_type_structure, -1);
+              else
+                no_error = process_data_list(type);  //expect a } (if not, error)
               if (!no_error) printf("---SOMETHING WENT WRONG WITH DATA LIST\n");
             }
             else{ //if there is no {, ITS AN ERROR!!!
@@ -1442,7 +1583,7 @@ namespace octet
               printf("\n\nERROR: I don't find the data-list!\n\n");
             }
           }
-          if (DEBUGGING) printf("Expect a } ... %c\n", *currentChar);
+          if (DEBUGGING) printf("Expect a } ... %c\n", current_char());
         
           if (no_error)
             return data_type_structure;
@@ -1467,38 +1608,59 @@ namespace octet
           //Then it will read the first character, to see if its a (, or name, or {
           int nameID = -1;
           //Get ready the new structure
-          openDDL_identifier_structure * identifier_structure = new openDDL_identifier_structure(type, father);
+          openDDL_identifier_structure * identifier_structure = arena.make<openDDL_identifier_structure>(type, father);
           current_structure = identifier_structure;
 
           //If its a name call to something to process name
           if (is_name()){
             nameID = process_name(father);
           }
+          if (handler != NULL && !handler->begin_structure(IDENTIFIER_TYPE, type, identifier_structure->get_name(), -1))
+            return NULL;
 
           //Later, check if it's ( and call something to check properties - telling the function which structure is this one
           remove_comments_whitespaces();
-          if (*currentChar == 0x28){ // 28 = (
+          if (current_char() == 0x28){ // 28 = (
             //call something to check properties          //expect a ) (if not, error)
             no_error = process_properties(identifier_structure);
           }
 
+          //If the schema knows this structure, only its name and properties are kept, the content goes to the schema
+          bool record = father == NULL && handler == NULL && schema != NULL && schema->accepts(IDENTIFIER_TYPE, type);
+          bool saved_lazy = lazy;
+          if (record && no_error){
+            no_error = schema->begin_record(identifier_structure);
+            handler = schema;
+            lazy = false;
+          }
+
           remove_comments_whitespaces();
           //Later expect a {, if not return error, and check for a new structure inside this structure
-          if (*currentChar == 0x7b){ //7b = {
+          if (current_char() == 0x7b){ //7b = {
             get_next_char();
             remove_comments_whitespaces();
 
-            while (*currentChar != 0x7d){ //7d = } (keep on looking for new substructures while it does not find }
+            while (no_error && !is_end_file() && current_char() != 0x7d){ //7d = } (keep on looking for new substructures while it does not find }
               no_error = process_structure(identifier_structure);  //call to process structure
               //Later expect a }, if not return error
               remove_comments_whitespaces();
             }
+            if (is_end_file()){
+              no_error = false;
+              printf("\nERROR: The file finished before the } of the structure!!!\n\n");
+            }
           }
           else{
             no_error = false;
             printf("\nERROR: No substructure!!!\n\n");
           }
-          if (DEBUGGING) printf("Expect a } ... %c\n", *currentChar);
+          if (record){
+            handler = NULL;
+            lazy = saved_lazy;
+            if (no_error)
+              no_error = schema->end_record();
+          }
+          if (DEBUGGING) printf("Expect a } ... %c\n", current_char());
 
           if (no_error)
             return identifier_structure;
@@ -1514,39 +1676,55 @@ namespace octet
         bool process_structure(openDDL_identifier_structure * father = NULL){
           bool no_error = true;
           if (is_end_file()) return true; //If we arrived to the end of the file, let's finish this!
-          string word;
           ++nesting;
-          if (DEBUGGING) printf("\n-----------%x\t%c\n", *currentChar, *currentChar);
+          if (DEBUGGING) printf("\n-----------%x\t%c\n", current_char(), current_char());
           openDDL_structure * processing_structure = NULL;
           // It's a real structure! But it can be IDENTIFIER or DATATYPE
           //remove_comments_whitespaces();
-          word = read_word();
-          if (DEBUGGING) printf("Finding => %s\n", word);
+          int size_word = read_word_size();
+          const char * word = (const char*)tempChar;
+          if (DEBUGGING) printf("Finding => %.*s\n", size_word, word);
           remove_comments_whitespaces();
           if (DEBUGGINGMORE) printf("%x <----\n", currentChar[0]);
 
-          //check if it's a type and return it's index (if its negative it's not a type)
-          int type = is_dataType(word);
+          //Inside the content of a record of the schema, the substructures that it does not accept are stored as usual
+          bool generic = false;
+          //check if it's a type and return its token (if its negative it's not a type)
+          int type = is_dataType(word, size_word);
           if (type >= 0){ //As it's a Data type, now it can be single data list or data array list!
-            processing_structure = process_structureData(types_.get_value(type),father);
+            generic = handler != NULL && handler == schema && !schema->accepts(DATA_TYPE_TYPE, type);
+            if (generic)
+              handler = NULL;
+            processing_structure = process_structureData(type, father);
           }
 
           else{
-            //check if it's a identifier and return it's index (if its negative it's not a identifier)
-            type = is_identifier(word);
+            //check if it's a identifier and return it (if its negative it's not a identifier)
+            type = is_identifier(word, size_word);
             if (type >= 0){ //As it's a Identifier type, now check name? properties? and then { structure(s)? }
-              processing_structure = process_structureIdentifier(identifiers_.get_value(type), father);
+              generic = handler != NULL && handler == schema && !schema->accepts(IDENTIFIER_TYPE, type);
+              if (generic)
+                handler = NULL;
+              processing_structure = process_structureIdentifier(type, father);
             }
 
             else{ //if it's nothing of the above is an error
               printf("ERRROR!!! There is no real structure.\n");//assert(0 && "It's not a proper structure");
             }
           }
-          if (DEBUGGING) printf("Expect a } ... %c\n", *currentChar);
+          if (DEBUGGING) printf("Expect a } ... %c\n", current_char());
           get_next_char();
           --nesting;
+          if (generic)
+            handler = schema;
           if (processing_structure == NULL)
             no_error = false;
+          else if (generic){ //It's not in the tree, the schema keeps it
+            schema_structures.push_back(processing_structure);
+            no_error = schema->generic_structure(processing_structure);
+          }
+          else if (handler != NULL) //In streaming mode the structure is not stored, the handler is told that it's finished
+            no_error = handler->end_structure();
           else{
             if (father == NULL) //Doesn't have a father, then it's a global structure
               openDDL_file.push_back(processing_structure);
@@ -1558,35 +1736,140 @@ namespace octet
         }
       
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will initialize the dictionaries of the lexer
+        /// @brief This will initialize the lexer
+        ///   The types, symbols and identifiers are found with perfect hashes (check openDDL_tokens.h), so there
+        ///   are no dictionaries to fill
         ////////////////////////////////////////////////////////////////////////////////
         void init_ddl(){
-          // Adding the types to the list of types
-          for (int i = first_type(); i < first_symbol(); ++i)
-            add_type(token_name(i).c_str(),i);
-          for (int i = first_symbol(); i <= last_symbol(); ++i)
-            add_symbol(token_name(i).c_str(), i);
           nesting = 0;
+          handler = NULL;
+          schema = NULL;
+          feeding = false;
+          feed_no_error = true;
+          language = this;
+          num_threads = 0;
+          use_index = false;
+          indexed = false;
+          lazy_data = false;
+          lazy = false;
+          unresolved_references = 0;
         }
-      public:
+
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief Constructor of lexer
+        /// @brief This is the work shared by the threads of lexer_parallel
+        ///   Each range (from cuts[i] to cuts[i + 1]) is lexed by its own worker, the threads take the next range free
         ////////////////////////////////////////////////////////////////////////////////
-        openDDL_lexer(){}
+        struct parallel_job{
+          dynarray<const uint8_t *> cuts;
+          dynarray<openDDL_lexer *> workers;
+          dynarray<uint8_t> results;
+          std::atomic<int> next_range;
+        };
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief  This will be the function that creates de process of the lexer receiving as parameter the array of characters
-        /// @param  It will receive a dynarray of uint8, it will represente the content of the file
+        /// @brief This is the function executed by each thread of lexer_parallel
+        /// @param  job  The ranges to lexer, and the workers and results of each range
+        ////////////////////////////////////////////////////////////////////////////////
+        static void parallel_worker(parallel_job * job){
+          int num_ranges = (int)job->workers.size();
+          for (int range = job->next_range++; range < num_ranges; range = job->next_range++){
+            const uint8_t * begin = job->cuts[range];
+            job->results[range] = job->workers[range]->lexer_append(begin, job->cuts[range + 1] - begin) ? 1 : 0;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will lexer the structures of the top level in parallel, and add them to the current document
+        /// @param  data  The characters (UTF8)
+        /// @param  size  The number of characters
+        /// @param  threads  The number of threads to use
         /// @return True if everything went well, false if there was some problem
+        ///   First the ends of the structures of the top level are found (jumping strings and comments), then the file is
+        ///   cut in ranges of similar size with complete structures, and every range is lexed by a worker in its own arena.
+        ///   At the end the workers are joined in the order of the file, so the document is the same as lexing it in order
+        ///   (the global names are checked in that order too, the first one wins as usual).
+        ////////////////////////////////////////////////////////////////////////////////
+        bool lexer_parallel(const uint8_t * data, size_t size, int threads){
+          parallel_job job;
+          dynarray<const uint8_t *> ends;
+          openDDL_splitter prescan;
+          prescan.scan(data, data + size, &ends);
+
+          //Cut the buffer in ranges of similar size (only after the end of a structure)
+          int max_ranges = threads * RANGES_PER_THREAD;
+          size_t range_size = size / max_ranges + 1;
+          job.cuts.push_back(data);
+          for (unsigned int i = 0; i < ends.size(); ++i){
+            if ((size_t)(ends[i] - job.cuts[job.cuts.size() - 1]) >= range_size)
+              job.cuts.push_back(ends[i]);
+          }
+          if (job.cuts[job.cuts.size() - 1] != data + size)
+            job.cuts.push_back(data + size);
+          int num_ranges = (int)job.cuts.size() - 1;
+          if (num_ranges < 2)
+            return lexer_range(data, size);
+
+          for (int i = 0; i < num_ranges; ++i){
+            openDDL_lexer * worker = new openDDL_lexer();
+            worker->language = language;
+            worker->num_threads = 1;
+            worker->use_index = use_index;
+            worker->lazy = lazy;
+            job.workers.push_back(worker);
+            job.results.push_back(0);
+          }
+          job.next_range = 0;
+          if (threads > num_ranges)
+            threads = num_ranges;
+          std::thread * pool = new std::thread[threads - 1];
+          for (int i = 0; i < threads - 1; ++i)
+            pool[i] = std::thread(parallel_worker, &job);
+          parallel_worker(&job);
+          for (int i = 0; i < threads - 1; ++i)
+            pool[i].join();
+          delete[] pool;
+
+          //Join the documents of the workers in the order of the file
+          bool no_error = true;
+          for (int i = 0; i < num_ranges; ++i){
+            openDDL_lexer * worker = job.workers[i];
+            no_error = no_error && job.results[i] != 0;
+            if (no_error){
+              for (unsigned int j = 0; j < worker->openDDL_file.size(); ++j)
+                openDDL_file.push_back(worker->openDDL_file[j]);
+              for (unsigned int j = 0; j < worker->global_named.size(); ++j){
+                openDDL_structure * structure = worker->global_named[j];
+                //The workers share the atom table, so the atoms of the names are the same in all of them
+                bool global = *structure->get_name() == 0x24; //24 = $
+                openDDL_structure *&named = get_named(global ? global_names : root_names, structure->get_nameID());
+                if (named != NULL)
+                  printf(global ? "This global name already exists!\n" : "This local name already exists!\n");
+                else
+                  named = structure;
+              }
+            }
+            //The memory of the worker is kept even if there was an error, it will be freed with the document
+            arena.adopt(worker->arena);
+            delete worker;
+          }
+          return no_error;
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
-        bool lexer_file(dynarray<uint8_t> file){
+        /// @brief This will lexer the structures of the top level one after the other, and add them to the current document
+        /// @param  data  The characters (UTF8)
+        /// @param  size  The number of characters
+        /// @return True if everything went well, false if there was some problem
+        ////////////////////////////////////////////////////////////////////////////////
+        bool lexer_range(const uint8_t * data, size_t size){
           bool no_error = true;
           sizeRead = 0;
-          buffer = file;
-          currentChar = &buffer[0];
-          bufferSize = buffer.size();
-          if (bufferSize < 5)
-            no_error = false;
+          currentChar = data;
+          bufferSize = (int64_t)size;
+          //The positions of the index are 32 bits inside windows of 64KB, so any size can be indexed
+          indexed = use_index;
+          if (indexed)
+            structural_index.reset(data, size);
           // It's starting to process all the array of characters starting with the first
           // Will do this until the end of the file
           while (!is_end_file() && no_error){
@@ -1594,13 +1877,737 @@ namespace octet
             if (!is_end_file()){
               //Process token (in openDDL is a structure) when you find it
               no_error = process_structure();
+              //In streaming mode nothing is kept after the structure of the top level
+              if (handler != NULL)
+                release_document();
               //get new token
-              if(DEBUGGING) printf("-----------%x\n", *currentChar);
+              if(DEBUGGING) printf("-----------%x\n", current_char());
             }
           }
+          indexed = false;
 
           return no_error;
         }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is the document converted to the records of the binary cache (check openDDL_cache.h)
+        ///   The numbers of the data lists are not copied, the lists are kept to write them at the end of the cache
+        ////////////////////////////////////////////////////////////////////////////////
+        struct cache_writer{
+          dynarray<openDDL_cache_structure> structures;
+          dynarray<openDDL_cache_literal> literals;
+          dynarray<int32_t> paths;
+          dynarray<openDDL_data_list *> payloads;
+          uint64_t payload_size;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a literal (a property or an element of a list) to the records of the cache
+        /// @param  writer  The records of the cache
+        /// @param  literal  The literal
+        /// @param  identifierID  The identifier of the property, or -1 for the elements of the lists
+        ////////////////////////////////////////////////////////////////////////////////
+        static void cache_literal(cache_writer &writer, const openDDL_data_literal &literal, int identifierID){
+          openDDL_cache_literal record;
+          memset(&record, 0, sizeof(record));
+          record.identifierID = identifierID;
+          record.value_type = literal.value_type;
+          record.atom = -1;
+          if (literal.value_type == value_type_DDL::STRING || literal.value_type == value_type_DDL::REF){
+            record.atom = literal.atom_;
+            record.size_string = literal.size_string_;
+          }
+          if (literal.value_type == value_type_DDL::REF){
+            record.global_ref = literal.global_ref_ ? 1 : 0;
+            record.path_size = literal.path_size_;
+            if (literal.path_ != NULL){
+              record.first_path = writer.paths.size();
+              for (int i = 0; i < literal.path_size_; ++i)
+                writer.paths.push_back(literal.path_[i]);
+            }
+          }
+          else if (literal.value_type == value_type_DDL::BOOL)
+            record.value = literal.value.bool_ ? 1 : 0;
+          else if (literal.value_type != value_type_DDL::STRING)
+            memcpy(&record.value, &literal.value, sizeof(record.value));
+          writer.literals.push_back(record);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a structure and all its substructures to the records of the cache (in the order of the file)
+        /// @param  writer  The records of the cache
+        /// @param  structure  The structure
+        /// @param  father  The index of the record of its father, or -1 in the top level
+        ///   The data lists not decoded yet (lazy mode) are decoded here
+        ////////////////////////////////////////////////////////////////////////////////
+        static void cache_structure(cache_writer &writer, openDDL_structure * structure, int father){
+          openDDL_cache_structure record;
+          memset(&record, 0, sizeof(record));
+          record.type = structure->get_type_structure();
+          record.nameID = structure->get_nameID();
+          record.father = father;
+          record.integer_literal = -1;
+          record.list = openDDL_cache::NO_LIST;
+          record.first_literal = writer.literals.size();
+          int index = (int)writer.structures.size();
+          if (structure->get_type_structure() == IDENTIFIER_TYPE){
+            openDDL_identifier_structure * identifier = (openDDL_identifier_structure *)structure;
+            record.id = identifier->get_identifierID();
+            record.num_literals = identifier->get_number_properties();
+            for (int i = 0; i < identifier->get_number_properties(); ++i)
+              cache_literal(writer, identifier->get_property(i)->literal, identifier->get_property(i)->identifierID);
+            writer.structures.push_back(record);
+            for (openDDL_structure * substructure = identifier->get_first_substructure(); substructure != NULL; substructure = substructure->get_next_sibling())
+              cache_structure(writer, substructure, index);
+            return;
+          }
+          openDDL_data_type_structure * data_type = (openDDL_data_type_structure *)structure;
+          record.id = data_type->get_typeID();
+          record.integer_literal = data_type->get_integer_literal();
+          openDDL_data_list * list = data_type->get_contiguous_list();
+          if (list != NULL){
+            record.list = data_type->get_integer_literal() >= 0 ? openDDL_cache::ARRAY_DATA : openDDL_cache::DATA_LIST;
+            record.num_elements = list->size();
+            if (list->is_numeric()){
+              record.payload_offset = writer.payload_size;
+              writer.payload_size = openDDL_cache::align(writer.payload_size + list->size() * openDDL_data_list::element_size(list->token_type));
+              writer.payloads.push_back(list);
+            }
+            else{
+              record.num_literals = (uint32_t)list->size();
+              for (size_t i = 0; i < list->size(); ++i)
+                cache_literal(writer, *list->get_literal(i), -1);
+            }
+          }
+          writer.structures.push_back(record);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will write zeros till the next alignment of the sections of the cache
+        /// @param  file  The cache being written
+        /// @param  size  The number of characters written since the last aligned section
+        /// @return True if everything was written
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool write_cache_padding(FILE * file, uint64_t size){
+          static const uint8_t zeros[openDDL_cache::ALIGNMENT] = { 0 };
+          size_t padding = (size_t)(openDDL_cache::align(size) - size);
+          return padding == 0 || fwrite(zeros, 1, padding, file) == padding;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will set a literal of the document from its record of the cache
+        /// @param  record  The record of the cache
+        /// @param  literal  The literal to fill
+        /// @param  header  The header of the cache
+        /// @param  data  The beginning of the cache
+        /// @return True if everything went right, and false if the record is broken
+        ////////////////////////////////////////////////////////////////////////////////
+        bool read_cache_literal(const openDDL_cache_literal &record, openDDL_data_literal &literal, const openDDL_cache_header &header, const uint8_t * data){
+          memset(&literal, 0, sizeof(literal));
+          if (record.value_type < value_type_DDL::UINT || record.value_type > value_type_DDL::TYPE)
+            return false;
+          literal.value_type = (value_type_DDL)record.value_type;
+          literal.atom_ = record.atom;
+          literal.path_size_ = record.path_size;
+          if (literal.value_type == value_type_DDL::STRING || literal.value_type == value_type_DDL::REF){
+            if (record.atom < 0 || (unsigned int)record.atom >= atoms.size())
+              return false;
+            literal.value.string_ = atoms.get_name(record.atom);
+            literal.size_string_ = record.size_string;
+            literal.global_ref_ = record.global_ref != 0;
+            if (literal.value_type == value_type_DDL::REF && record.path_size > 1){
+              if (record.first_path > header.num_paths || (uint32_t)record.path_size > header.num_paths - record.first_path)
+                return false;
+              const int32_t * path = (const int32_t *)(data + header.paths_offset) + record.first_path;
+              literal.path_ = (int *)arena.allocate(record.path_size * sizeof(int));
+              for (int i = 0; i < record.path_size; ++i){
+                if (path[i] < 0 || (unsigned int)path[i] >= atoms.size())
+                  return false;
+                literal.path_[i] = path[i];
+              }
+            }
+          }
+          else if (literal.value_type == value_type_DDL::BOOL)
+            literal.value.bool_ = record.value != 0;
+          else
+            memcpy(&literal.value, &record.value, sizeof(record.value));
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will rebuild the document from a cache already checked (check read_cache)
+        /// @param  header  The header of the cache
+        /// @param  data  The beginning of the cache, the numbers of the data lists are used in place
+        /// @return True if everything went right, and false if the cache is broken
+        ////////////////////////////////////////////////////////////////////////////////
+        bool read_cache_document(const openDDL_cache_header &header, const uint8_t * data){
+          //The names are interned in the same order, so they get the same atoms
+          const openDDL_cache_atom * atom_records = (const openDDL_cache_atom *)(data + header.atoms_offset);
+          for (uint32_t i = 0; i < header.num_atoms; ++i){
+            const openDDL_cache_atom &record = atom_records[i];
+            if (record.offset < header.chars_offset || record.offset >= header.cache_size || record.size >= header.cache_size - record.offset)
+              return false;
+            if (atoms.intern((const char *)data + record.offset, (int)record.size) != (int)i)
+              return false;
+          }
+
+          //The fathers are always before their substructures, so the structures are linked while they are created
+          const openDDL_cache_structure * structure_records = (const openDDL_cache_structure *)(data + header.structures_offset);
+          const openDDL_cache_literal * literal_records = (const openDDL_cache_literal *)(data + header.literals_offset);
+          dynarray<openDDL_structure *> structures;
+          structures.resize(header.num_structures);
+          for (uint32_t i = 0; i < header.num_structures; ++i){
+            const openDDL_cache_structure &record = structure_records[i];
+            openDDL_identifier_structure * father = NULL;
+            if (record.father >= 0){
+              if ((uint32_t)record.father >= i || structures[record.father]->get_type_structure() != IDENTIFIER_TYPE)
+                return false;
+              father = (openDDL_identifier_structure *)structures[record.father];
+            }
+            if (record.nameID < -1 || (record.nameID >= 0 && (unsigned int)record.nameID >= atoms.size()))
+              return false;
+            if (record.first_literal > header.num_literals || record.num_literals > header.num_literals - record.first_literal)
+              return false;
+            const openDDL_cache_literal * literals = literal_records + record.first_literal;
+
+            openDDL_structure * structure;
+            if (record.type == IDENTIFIER_TYPE){
+              openDDL_identifier_structure * identifier = arena.make<openDDL_identifier_structure>(record.id, father);
+              if (record.num_literals > 0){
+                openDDL_properties * properties = (openDDL_properties *)arena.allocate(record.num_literals * sizeof(openDDL_properties));
+                for (uint32_t j = 0; j < record.num_literals; ++j){
+                  properties[j].identifierID = literals[j].identifierID;
+                  if (!read_cache_literal(literals[j], properties[j].literal, header, data))
+                    return false;
+                }
+                identifier->set_properties(properties, (int)record.num_literals);
+              }
+              structure = identifier;
+            }
+            else if (record.type == DATA_TYPE_TYPE && record.id >= token_type::tok_bool && record.id <= token_type::tok_type){
+              openDDL_data_type_structure * data_type = arena.make<openDDL_data_type_structure>(record.id, record.integer_literal, father);
+              if (record.list == openDDL_cache::ARRAY_DATA && record.integer_literal <= 0)
+                return false;
+              if (record.list != openDDL_cache::NO_LIST){
+                openDDL_data_list * list = arena.make<openDDL_data_list>(record.id);
+                uint64_t element_size = openDDL_data_list::element_size(record.id);
+                if (element_size > 0){
+                  if (record.payload_offset > header.payload_size || record.num_elements > (header.payload_size - record.payload_offset) / element_size)
+                    return false;
+                  list->set_external_view(record.id, data + header.payload_offset + record.payload_offset, (size_t)record.num_elements);
+                }
+                else{
+                  if (record.num_elements != record.num_literals)
+                    return false;
+                  openDDL_data_literal * elements = (openDDL_data_literal *)arena.allocate(record.num_literals * sizeof(openDDL_data_literal));
+                  list->reserve(record.num_literals);
+                  for (uint32_t j = 0; j < record.num_literals; ++j){
+                    if (!read_cache_literal(literals[j], elements[j], header, data))
+                      return false;
+                    list->add_literal(&elements[j]);
+                  }
+                }
+                if (record.list == openDDL_cache::ARRAY_DATA)
+                  data_type->set_array_data(list);
+                else
+                  data_type->add_data_list(list);
+              }
+              structure = data_type;
+            }
+            else
+              return false;
+
+            //The names are checked like process_name: the first structure keeps the name, and the others are warned
+            if (record.nameID >= 0){
+              structure->set_nameID(record.nameID);
+              structure->set_name(atoms.get_name(record.nameID));
+              bool global = *structure->get_name() == 0x24; //24 = $
+              if (global || father == NULL){
+                openDDL_structure *&named = get_named(global ? global_names : root_names, record.nameID);
+                if (named != NULL)
+                  printf(global ? "This global name already exists!\n" : "This local name already exists!\n");
+                else
+                  named = structure;
+              }
+              else if (father->find_local_name(record.nameID) != NULL)
+                printf("This local name already exists!\n");
+            }
+            if (father != NULL)
+              father->add_structure(structure);
+            else
+              openDDL_file.push_back(structure);
+            structures[i] = structure;
+          }
+          return true;
+        }
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of lexer
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_lexer(){
+          init_ddl();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Destructor of lexer
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual ~openDDL_lexer(){}
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will decode the data lists that were not decoded while lexing (lazy mode)
+        /// @param  structure  The structure of data type that has the data lists
+        /// @param  begin  The first character of the data lists (after the { of a data list, or the { of a data array list)
+        /// @param  end  The } that closes the data lists
+        /// @param  count  The number of elements (counted while lexing)
+        /// @return True if everything went well, false if there was some problem
+        ///   The structures call to this the first time that their data lists are requested
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool decode_data_lists(openDDL_data_type_structure * structure, const uint8_t * begin, const uint8_t * end, size_t count){
+          //Keep the state of the lexer, the lists are decoded with the same functions used while lexing
+          const uint8_t * saved_char = currentChar;
+          int64_t saved_size = bufferSize;
+          openDDL_structure * saved_structure = current_structure;
+          openDDL_handler * saved_handler = handler;
+          bool saved_indexed = indexed;
+          currentChar = begin;
+          bufferSize = end + 1 - begin;
+          current_structure = structure;
+          handler = NULL;
+          indexed = false;
+          bool no_error;
+          if (structure->get_integer_literal() < 0)
+            no_error = process_data_list(structure->get_typeID(), count);
+          else
+            no_error = process_data_array_list(structure->get_typeID(), structure->get_integer_literal(), count);
+          currentChar = saved_char;
+          bufferSize = saved_size;
+          current_structure = saved_structure;
+          handler = saved_handler;
+          indexed = saved_indexed;
+          return no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will find a local name inside a structure
+        /// @param  scope  The structure with the local name (only the identifier structures have substructures)
+        /// @param  atom  The atom of the name
+        /// @return The substructure with this name, or NULL if it's not there
+        ////////////////////////////////////////////////////////////////////////////////
+        static openDDL_structure * find_local(openDDL_structure * scope, int atom){
+          if (scope->get_type_structure() != IDENTIFIER_TYPE)
+            return NULL;
+          return ((openDDL_identifier_structure *)scope)->find_local_name(atom);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will find the structure of a reference
+        /// @param  literal  The reference
+        /// @param  structure  The structure where the reference is
+        /// @return The structure referenced, or NULL if it was not found
+        ///   The first name is global ($), or local (%) of the structure, its fathers or the top level (the closest first)
+        ///   the rest of the names are local names of the structure found before
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_structure * find_reference(openDDL_data_literal * literal, openDDL_structure * structure){
+          int first = literal->path_ != NULL ? literal->path_[0] : literal->atom_;
+          openDDL_structure * target = NULL;
+          if (literal->global_ref_)
+            target = (unsigned int)first < global_names.size() ? global_names[first] : NULL;
+          else{
+            for (openDDL_structure * scope = structure; scope != NULL && target == NULL; scope = scope->get_father_structure())
+              target = find_local(scope, first);
+            if (target == NULL && (unsigned int)first < root_names.size())
+              target = root_names[first];
+          }
+          for (int i = 1; i < literal->path_size_ && target != NULL; ++i)
+            target = find_local(target, literal->path_[i]);
+          return target;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will set the structure of a reference (or warn if it does not exist)
+        /// @param  literal  The reference
+        /// @param  structure  The structure where the reference is
+        ////////////////////////////////////////////////////////////////////////////////
+        void resolve_literal(openDDL_data_literal * literal, openDDL_structure * structure){
+          char first = *literal->value.ref_;
+          //The null reference is not resolved (it's not an error)
+          if (first != 0x24 && first != 0x25)
+            return;
+          literal->target_ = find_reference(literal, structure);
+          if (literal->target_ == NULL){
+            printf("WARNING: The reference %s cannot be found!\n", literal->value.ref_);
+            ++unresolved_references;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will resolve the references of a structure and all its substructures
+        /// @param  structure  The structure
+        ////////////////////////////////////////////////////////////////////////////////
+        void resolve_structure(openDDL_structure * structure){
+          if (structure->get_type_structure() == IDENTIFIER_TYPE){
+            openDDL_identifier_structure * identifier = (openDDL_identifier_structure *)structure;
+            for (int i = 0; i < identifier->get_number_properties(); ++i){
+              openDDL_properties * property = identifier->get_property(i);
+              if (property->literal.value_type == value_type_DDL::REF)
+                resolve_literal(&property->literal, structure);
+            }
+            for (openDDL_structure * substructure = identifier->get_first_substructure(); substructure != NULL; substructure = substructure->get_next_sibling())
+              resolve_structure(substructure);
+          }
+          else{
+            openDDL_data_type_structure * data_type = (openDDL_data_type_structure *)structure;
+            if (data_type->get_typeID() != token_type::tok_ref)
+              return;
+            //The references are looked for from the father of the data list (the names are siblings of it)
+            for (int i = 0; i < data_type->get_number_lists(); ++i){
+              openDDL_data_list * list = data_type->get_data_list(i);
+              for (size_t j = 0; j < list->size(); ++j)
+                resolve_literal(list->get_literal(j), structure);
+            }
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will find the structure of every reference of the document, once all the names are known
+        /// @return The number of references that were not found (a warning is printed for each one)
+        ///   It's done after lexing in one pass, so the converters use the structures (get_target, target_) instead
+        ///   of looking for the names. It's called by lexer_memory and finish, call it again after lexer_append.
+        ////////////////////////////////////////////////////////////////////////////////
+        int resolve_references(){
+          unresolved_references = 0;
+          if (handler == NULL){
+            for (unsigned int i = 0; i < openDDL_file.size(); ++i)
+              resolve_structure(openDDL_file[i]);
+            for (unsigned int i = 0; i < schema_structures.size(); ++i)
+              resolve_structure(schema_structures[i]);
+          }
+          return unresolved_references;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will return the number of references not found by the last resolve_references
+        ////////////////////////////////////////////////////////////////////////////////
+        int get_unresolved_references(){
+          return unresolved_references;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will free all the structures of the document lexed, in one go
+        ////////////////////////////////////////////////////////////////////////////////
+        void release_document(){
+          openDDL_file.reset();
+          global_names.reset();
+          atoms.reset();
+          global_named.reset();
+          root_names.reset();
+          schema_structures.reset();
+          if (schema != NULL)
+            schema->release();
+          unresolved_references = 0;
+          current_data_list = NULL;
+          current_structure = NULL;
+          current_literal = NULL;
+          arena.reset();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will return the memory used by the document lexed
+        /// @return The number of bytes used by the structures, names and strings of the document
+        ////////////////////////////////////////////////////////////////////////////////
+        size_t get_bytes_used(){
+          return arena.get_bytes_used() + atoms.get_bytes_used();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will return the atom table of the document lexed (check openDDL_atoms.h)
+        ///   The names of the structures, the references and the strings have their atom (get_nameID, get_atom)
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_atom_table &get_atoms(){
+          return atoms;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will return the atom of octet of a name, reference or string of the document
+        /// @param  atom  The atom of the document (or -1)
+        /// @return The atom_t of octet (app_utils::get_atom is only called the first time), or atom_ if atom is -1
+        ////////////////////////////////////////////////////////////////////////////////
+        atom_t get_octet_atom(int atom){
+          return atoms.get_atom(atom);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will set the handler that receives the events of the lexer (streaming mode)
+        /// @param  new_handler  The handler, or NULL to store the document as usual
+        ///   While there is a handler the document is not stored: the structures of the top level are freed as soon
+        ///   as they are finished, and the names are not checked (the handler receives them)
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_handler(openDDL_handler * new_handler){
+          handler = new_handler;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will return the handler that receives the events of the lexer (NULL if it's not streaming)
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_handler * get_handler(){
+          return handler;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will set the schema that reads the content of the structures it knows (check openDDL_schema)
+        /// @param  new_schema  The schema, or NULL to store all the document in the tree
+        ///   The schema receives the records in the order of the file, so the buffers are not lexed in parallel.
+        ///   Its records are released with the document, so set it before lexing.
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_schema(openDDL_schema * new_schema){
+          if (schema != NULL && schema != new_schema)
+            schema->release();
+          schema = new_schema;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will be the function that creates de process of the lexer receiving as parameter the array of characters
+        /// @param  It will receive a dynarray of uint8, it will represente the content of the file
+        /// @return True if everything went well, false if there was some problem
+        ////////////////////////////////////////////////////////////////////////////////
+        bool lexer_file(const dynarray<uint8_t> &file){
+          return lexer_memory(file.data(), file.size());
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will do the process of the lexer reading the characters in place (they are not copied)
+        /// @param  data  The characters of the file in UTF8 (it can be a file mapped in memory)
+        /// @param  size  The number of characters (the lexer never reads after data + size)
+        /// @return True if everything went well, false if there was some problem
+        ///   The document does not point to the characters, so they can be freed once the lexer finishes
+        ///   (except with set_lazy_data, then the characters have to be valid till the document is released)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool lexer_memory(const uint8_t * data, size_t size){
+          //If there was a previous document, free it
+          release_document();
+          if (data == NULL || size < 5)
+            return false;
+          lazy = lazy_data && handler == NULL;
+          bool no_error = lexer_append(data, size);
+          lazy = false;
+          if (no_error)
+            resolve_references();
+          return no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will add to the current document the structures of more characters (they are not copied)
+        /// @param  data  The characters in UTF8, they have to contain only complete structures
+        /// @param  size  The number of characters (the lexer never reads after data + size)
+        /// @return True if everything went well, false if there was some problem
+        ///   This is used to read the big files in pieces, the names of the previous pieces can be used
+        ////////////////////////////////////////////////////////////////////////////////
+        bool lexer_append(const uint8_t * data, size_t size){
+          //The big buffers are lexed in parallel (not in streaming mode or with a schema, they receive the events in order)
+          int threads = num_threads > 0 ? num_threads : (int)std::thread::hardware_concurrency();
+          if (handler == NULL && schema == NULL && threads > 1 && size >= PARALLEL_MIN_SIZE)
+            return lexer_parallel(data, size, threads);
+          return lexer_range(data, size);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will set the number of threads used to lexer the big buffers
+        /// @param  threads  The number of threads, 0 to use one per core, or 1 to lexer always in one thread
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_threads(int threads){
+          num_threads = threads < 0 ? 1 : threads;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will choose if the lexer builds the structural index of the characters (check openDDL_index.h)
+        /// @param  enable  True to find the ends of the numbers and properties with the index
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_structural_index(bool enable){
+          use_index = enable;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will choose if lexer_memory decodes the data lists, or leaves them to be decoded when requested
+        /// @param  enable  True to decode the data lists the first time that get_number_lists or get_data_list is called
+        ///   The structures keep pointers to the characters lexed, so they have to be valid till the document is released
+        ///   (the loader keeps the file mapped). The data lists that are never requested are never converted to numbers.
+        ///   Only lexer_memory (and lexer_file) are lazy, feed and lexer_append reuse their characters so they decode everything.
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_lazy_data(bool enable){
+          lazy_data = enable;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will lexer the next piece of a file that arrives in pieces (a pipe, a decompressor, a slow disk...)
+        /// @param  data  The characters of the piece, they can finish in the middle of a structure or a token
+        /// @param  size  The number of characters
+        /// @return True if everything went well, false if there was some problem (in this piece or in a previous one)
+        ///   The structures of the top level are lexed as soon as they are complete, so the lexer works while the rest of
+        ///   the file arrives. Only the characters of the last structure (not finished) are copied, to wait for the rest.
+        ///   The first call starts a new document, and finish() has to be called after the last piece.
+        ////////////////////////////////////////////////////////////////////////////////
+        bool feed(const uint8_t * data, size_t size){
+          if (!feeding){
+            release_document();
+            feed_buffer.reset();
+            splitter.reset();
+            feeding = true;
+            feed_no_error = true;
+          }
+          if (!feed_no_error || data == NULL || size == 0)
+            return feed_no_error;
+
+          if (feed_buffer.size() == 0){
+            //There is nothing waiting, so the complete structures are lexed in place
+            const uint8_t * end = splitter.scan(data, data + size);
+            if (end != NULL){
+              feed_no_error = lexer_append(data, end - data);
+              size -= end - data;
+              data = end;
+            }
+            if (size > 0){
+              feed_buffer.resize((unsigned int)size);
+              memcpy(feed_buffer.data(), data, size);
+            }
+          }
+          else{
+            //Add the piece to the characters waiting, and check only the new ones
+            size_t waiting = feed_buffer.size();
+            feed_buffer.resize((unsigned int)(waiting + size));
+            memcpy(feed_buffer.data() + waiting, data, size);
+            const uint8_t * begin = feed_buffer.data();
+            const uint8_t * end = splitter.scan(begin + waiting, begin + waiting + size);
+            if (end != NULL){
+              feed_no_error = lexer_append(begin, end - begin);
+              size_t rest = (begin + waiting + size) - end;
+              memmove(feed_buffer.data(), end, rest);
+              feed_buffer.resize((unsigned int)rest);
+            }
+          }
+          return feed_no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will finish the file received with feed(), lexing the characters that were waiting
+        /// @return True if everything went well, false if there was some problem (or the last structure is not complete)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool finish(){
+          bool no_error = feed_no_error;
+          if (no_error && feed_buffer.size() > 0){
+            if (!splitter.is_top_level()){
+              printf("\nERROR: The file finished before the end of a structure (or a comment)!!!\n\n");
+              no_error = false;
+            }
+            else
+              no_error = lexer_append(feed_buffer.data(), feed_buffer.size());
+          }
+          feed_buffer.reset();
+          feeding = false;
+          if (no_error)
+            resolve_references();
+          return no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will check if the document can be saved in a binary cache (and loaded from it)
+        /// @return False in streaming mode, or with a schema (its records are not in the document)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool can_cache(){
+          return handler == NULL && schema == NULL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will save the document lexed in a binary cache (check openDDL_cache.h)
+        /// @param  file  The file of the cache, opened to write in binary mode
+        /// @param  source  The size, time of modification and hash of the file lexed
+        /// @return True if everything went well, false if the cache could not be written
+        ///   The header is written at the end, so a cache that was not finished is never used.
+        ///   The data lists not decoded yet (lazy mode) are decoded to save them.
+        ////////////////////////////////////////////////////////////////////////////////
+        bool write_cache(FILE * file, const openDDL_cache_source &source){
+          if (file == NULL || !can_cache())
+            return false;
+          cache_writer writer;
+          writer.payload_size = 0;
+          for (unsigned int i = 0; i < openDDL_file.size(); ++i)
+            cache_structure(writer, openDDL_file[i], -1);
+
+          dynarray<openDDL_cache_atom> atom_records;
+          atom_records.resize(atoms.size());
+          openDDL_cache_header header;
+          memset(&header, 0, sizeof(header));
+          header.version = openDDL_cache::OPENDDL_CACHE_VERSION;
+          header.byte_order = openDDL_cache::BYTE_ORDER_MARK;
+          header.source = source;
+          header.num_atoms = atoms.size();
+          header.num_structures = writer.structures.size();
+          header.num_literals = writer.literals.size();
+          header.num_paths = writer.paths.size();
+          header.atoms_offset = openDDL_cache::align(sizeof(header));
+          header.chars_offset = header.atoms_offset + header.num_atoms * sizeof(openDDL_cache_atom);
+          uint64_t chars_size = 0;
+          for (unsigned int i = 0; i < atoms.size(); ++i){
+            atom_records[i].offset = header.chars_offset + chars_size;
+            atom_records[i].size = (uint32_t)atoms.get_size(i);
+            atom_records[i].unused = 0;
+            chars_size += atoms.get_size(i) + 1;
+          }
+          header.structures_offset = openDDL_cache::align(header.chars_offset + chars_size);
+          header.literals_offset = header.structures_offset + header.num_structures * sizeof(openDDL_cache_structure);
+          header.paths_offset = header.literals_offset + header.num_literals * sizeof(openDDL_cache_literal);
+          header.payload_offset = openDDL_cache::align(header.paths_offset + header.num_paths * sizeof(int32_t));
+          header.payload_size = writer.payload_size;
+          header.cache_size = header.payload_offset + header.payload_size;
+
+          bool no_error = fwrite(&header, sizeof(header), 1, file) == 1 && write_cache_padding(file, sizeof(header));
+          if (no_error && atom_records.size() > 0)
+            no_error = fwrite(atom_records.data(), sizeof(openDDL_cache_atom), atom_records.size(), file) == atom_records.size();
+          for (unsigned int i = 0; i < atoms.size() && no_error; ++i)
+            no_error = fwrite(atoms.get_name(i), 1, atoms.get_size(i) + 1, file) == (size_t)atoms.get_size(i) + 1;
+          no_error = no_error && write_cache_padding(file, chars_size);
+          if (no_error && writer.structures.size() > 0)
+            no_error = fwrite(writer.structures.data(), sizeof(openDDL_cache_structure), writer.structures.size(), file) == writer.structures.size();
+          if (no_error && writer.literals.size() > 0)
+            no_error = fwrite(writer.literals.data(), sizeof(openDDL_cache_literal), writer.literals.size(), file) == writer.literals.size();
+          if (no_error && writer.paths.size() > 0)
+            no_error = fwrite(writer.paths.data(), sizeof(int32_t), writer.paths.size(), file) == writer.paths.size();
+          no_error = no_error && write_cache_padding(file, header.paths_offset + header.num_paths * sizeof(int32_t));
+          for (unsigned int i = 0; i < writer.payloads.size() && no_error; ++i){
+            openDDL_data_list * list = writer.payloads[i];
+            size_t bytes = list->size() * openDDL_data_list::element_size(list->token_type);
+            no_error = (bytes == 0 || fwrite(list->get_bytes(), 1, bytes, file) == bytes) && write_cache_padding(file, bytes);
+          }
+
+          //Now that everything is written, the header gets its magic characters
+          memcpy(header.magic, openDDL_cache::get_magic(), sizeof(header.magic));
+          no_error = no_error && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+          return fflush(file) == 0 && no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief  This will load the document from a binary cache, without lexing anything (check openDDL_cache.h)
+        /// @param  data  The cache (mapped in memory, aligned to 8 bytes)
+        /// @param  size  The size of the cache
+        /// @param  source  The size, time of modification and hash of the file that has to be in the cache
+        /// @return True if the document was loaded, false if the cache is from another file (or version) or it's broken
+        ///   The numbers of the data lists are not copied, so the cache has to be valid till the document is released.
+        ///   The references are resolved again, the warnings of the references not found are the same as lexing the file.
+        ////////////////////////////////////////////////////////////////////////////////
+        bool read_cache(const uint8_t * data, size_t size, const openDDL_cache_source &source){
+          if (!can_cache())
+            return false;
+          const openDDL_cache_header * header = openDDL_cache::check_header(data, size, source);
+          if (header == NULL)
+            return false;
+          release_document();
+          if (!read_cache_document(*header, data)){
+            printf("ERROR: The cache of the file is broken, it will not be used!\n");
+            release_document();
+            return false;
+          }
+          resolve_references();
+          return true;
+        }
       };
     }
   }
@@ -0,0 +1,446 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_scanner.h
+/// @author Juanmi Huertas Delgado
+/// @brief This are the functions used by the lexer to jump whitespaces and comments quickly
+///
+///   The files exported in openGEX are mostly indentation and line breaks between numbers, so instead
+///   of checking one character at a time, these functions check 32 (AVX2) or 16 (SSE2) characters at once.
+///   If the compiler does not have SSE2 (or OPENDDL_NO_SIMD is defined) it uses the scalar version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENDDL_SCANNER_INCLUDED
+#define OPENDDL_SCANNER_INCLUDED
+
+#if !defined(OPENDDL_NO_SIMD)
+  #if defined(__AVX2__)
+    #define OPENDDL_AVX2 1
+    #include <immintrin.h>
+  #endif
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define OPENDDL_SSE2 1
+    #include <emmintrin.h>
+  #endif
+#endif
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class contains the functions to scan the buffer of characters
+  ///   All the functions receive the current position and the end of the buffer, and never read after the end
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_scanner{
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the position of the first bit set of a mask (it cannot be 0)
+        ////////////////////////////////////////////////////////////////////////////////
+        static int first_bit(unsigned int mask){
+        #if defined(_MSC_VER)
+          unsigned long index;
+          _BitScanForward(&index, mask);
+          return (int)index;
+        #else
+          return __builtin_ctz(mask);
+        #endif
+        }
+
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will jump all the whitespaces (any value less or equal than 0x20)
+        /// @param  c    The current character
+        /// @param  end  The end of the buffer
+        /// @return The first character that is not a whitespace (or end)
+        ////////////////////////////////////////////////////////////////////////////////
+        static const uint8_t * skip_whitespace(const uint8_t * c, const uint8_t * end){
+          // Most of the times there is only one whitespace, so check it before going vectorial
+          if (c < end && *c > 0x20) return c;
+        #if defined(OPENDDL_AVX2)
+          const __m256i limit32 = _mm256_set1_epi8(0x21);
+          while (end - c >= 32){
+            __m256i chars = _mm256_loadu_si256((const __m256i *)c);
+            // The max is equal to the char only when the char >= 0x21 (it's not a whitespace)
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(chars, limit32), chars));
+            if (mask != 0) return c + first_bit(mask);
+            c += 32;
+          }
+        #endif
+        #if defined(OPENDDL_SSE2)
+          const __m128i limit16 = _mm_set1_epi8(0x21);
+          while (end - c >= 16){
+            __m128i chars = _mm_loadu_si128((const __m128i *)c);
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chars, limit16), chars));
+            if (mask != 0) return c + first_bit(mask);
+            c += 16;
+          }
+        #endif
+          while (c < end && *c <= 0x20) ++c;
+          return c;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will look for the end of a line (used by the comments //)
+        /// @param  c    The current character (after the //)
+        /// @param  end  The end of the buffer
+        /// @return The first character that is 0x0a or 0x0d (or end)
+        ////////////////////////////////////////////////////////////////////////////////
+        static const uint8_t * find_line_end(const uint8_t * c, const uint8_t * end){
+        #if defined(OPENDDL_AVX2)
+          const __m256i cr32 = _mm256_set1_epi8(0x0d);
+          const __m256i lf32 = _mm256_set1_epi8(0x0a);
+          while (end - c >= 32){
+            __m256i chars = _mm256_loadu_si256((const __m256i *)c);
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chars, cr32), _mm256_cmpeq_epi8(chars, lf32)));
+            if (mask != 0) return c + first_bit(mask);
+            c += 32;
+          }
+        #endif
+        #if defined(OPENDDL_SSE2)
+          const __m128i cr16 = _mm_set1_epi8(0x0d);
+          const __m128i lf16 = _mm_set1_epi8(0x0a);
+          while (end - c >= 16){
+            __m128i chars = _mm_loadu_si128((const __m128i *)c);
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chars, cr16), _mm_cmpeq_epi8(chars, lf16)));
+            if (mask != 0) return c + first_bit(mask);
+            c += 16;
+          }
+        #endif
+          while (c < end && *c != 0x0d && *c != 0x0a) ++c;
+          return c;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will look for the end of a block comment (the characters */)
+        /// @param  c    The current character (after the /*)
+        /// @param  end  The end of the buffer
+        /// @return A pointer to the * of the */ (or end if the comment is not closed)
+        ////////////////////////////////////////////////////////////////////////////////
+        static const uint8_t * find_comment_end(const uint8_t * c, const uint8_t * end){
+        #if defined(OPENDDL_AVX2)
+          const __m256i star32 = _mm256_set1_epi8(0x2a);
+          const __m256i slash32 = _mm256_set1_epi8(0x2f);
+          while (end - c >= 33){
+            // Check the * in one block and the / in the block starting one character after
+            __m256i stars = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)c), star32);
+            __m256i slashes = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(c + 1)), slash32);
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(stars, slashes));
+            if (mask != 0) return c + first_bit(mask);
+            c += 32;
+          }
+        #endif
+        #if defined(OPENDDL_SSE2)
+          const __m128i star16 = _mm_set1_epi8(0x2a);
+          const __m128i slash16 = _mm_set1_epi8(0x2f);
+          while (end - c >= 17){
+            __m128i stars = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)c), star16);
+            __m128i slashes = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(c + 1)), slash16);
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(stars, slashes));
+            if (mask != 0) return c + first_bit(mask);
+            c += 16;
+          }
+        #endif
+          while (end - c >= 2){
+            if (c[0] == 0x2a && c[1] == 0x2f) return c;
+            ++c;
+          }
+          return end;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will look for the characters that change the nesting of the structures ({ } " ' /)
+        /// @param  c    The current character
+        /// @param  end  The end of the buffer
+        /// @return The first character that is { } " ' or / (or end)
+        ///   Everything else (names, numbers, whitespaces...) is jumped 32 or 16 characters at a time
+        ////////////////////////////////////////////////////////////////////////////////
+        static const uint8_t * find_nesting_char(const uint8_t * c, const uint8_t * end){
+        #if defined(OPENDDL_AVX2)
+          const __m256i lbrace32 = _mm256_set1_epi8(0x7b);
+          const __m256i rbrace32 = _mm256_set1_epi8(0x7d);
+          const __m256i quote32 = _mm256_set1_epi8(0x22);
+          const __m256i apostrophe32 = _mm256_set1_epi8(0x27);
+          const __m256i slash32 = _mm256_set1_epi8(0x2f);
+          while (end - c >= 32){
+            __m256i chars = _mm256_loadu_si256((const __m256i *)c);
+            __m256i found = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chars, lbrace32), _mm256_cmpeq_epi8(chars, rbrace32)),
+              _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chars, quote32), _mm256_cmpeq_epi8(chars, apostrophe32)), _mm256_cmpeq_epi8(chars, slash32)));
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(found);
+            if (mask != 0) return c + first_bit(mask);
+            c += 32;
+          }
+        #endif
+        #if defined(OPENDDL_SSE2)
+          const __m128i lbrace16 = _mm_set1_epi8(0x7b);
+          const __m128i rbrace16 = _mm_set1_epi8(0x7d);
+          const __m128i quote16 = _mm_set1_epi8(0x22);
+          const __m128i apostrophe16 = _mm_set1_epi8(0x27);
+          const __m128i slash16 = _mm_set1_epi8(0x2f);
+          while (end - c >= 16){
+            __m128i chars = _mm_loadu_si128((const __m128i *)c);
+            __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, lbrace16), _mm_cmpeq_epi8(chars, rbrace16)),
+              _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, quote16), _mm_cmpeq_epi8(chars, apostrophe16)), _mm_cmpeq_epi8(chars, slash16)));
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(found);
+            if (mask != 0) return c + first_bit(mask);
+            c += 16;
+          }
+        #endif
+          while (c < end && *c != 0x7b && *c != 0x7d && *c != 0x22 && *c != 0x27 && *c != 0x2f) ++c;
+          return c;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will jump all the whitespaces and comments (// and /* */)
+        /// @param  c    The current character
+        /// @param  end  The end of the buffer
+        /// @return The first character that is not a whitespace or part of a comment (or end)
+        ////////////////////////////////////////////////////////////////////////////////
+        static const uint8_t * skip_whitespace_comments(const uint8_t * c, const uint8_t * end){
+          for (;;){
+            c = skip_whitespace(c, end);
+            if (end - c < 2 || *c != 0x2f) //2f = /
+              return c;
+            if (c[1] == 0x2f){ //2f = / so it's a // comment
+              c = find_line_end(c + 2, end);
+            }
+            else if (c[1] == 0x2a){ //2a = * so it's a /* comment
+              c = find_comment_end(c + 2, end);
+              if (c == end){
+                printf("ERROR: It's missing the */ of a comment\n");
+                return end;
+              }
+              c += 2;
+            }
+            else
+              return c;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will look for the end of the last structure of the top level (the last } closing a structure)
+        ///   It's used to split a big file in chunks, so every chunk contains only complete structures.
+        ///   It jumps the strings, the char literals and the comments, so the { } inside them are not counted.
+        /// @param  c    The first character, it has to be in the top level (outside any structure)
+        /// @param  end  The end of the buffer
+        /// @return The character after the last } of the top level, or NULL if there is no complete structure
+        ////////////////////////////////////////////////////////////////////////////////
+        static const uint8_t * find_last_structure_end(const uint8_t * c, const uint8_t * end){
+          const uint8_t * last = NULL;
+          int depth = 0;
+          while (c < end){
+            uint8_t character = *c;
+            if (character == 0x22 || character == 0x27){ //22 = " and 27 = ' (jumping the escaped characters)
+              ++c;
+              while (c < end && *c != character){
+                if (*c == 0x5c) ++c; //5c = backslash, so the next character is escaped
+                ++c;
+              }
+              if (c >= end) break;
+              ++c;
+            }
+            else if (character == 0x2f && end - c >= 2 && c[1] == 0x2f){ //2f = / so it's a // comment
+              c = find_line_end(c + 2, end);
+            }
+            else if (character == 0x2f && end - c >= 2 && c[1] == 0x2a){ //2a = * so it's a /* comment
+              c = find_comment_end(c + 2, end);
+              if (c == end) break;
+              c += 2;
+            }
+            else{
+              if (character == 0x7b) //7b = {
+                ++depth;
+              else if (character == 0x7d && --depth == 0) //7d = }
+                last = c + 1;
+              ++c;
+            }
+          }
+          return last;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will count how many times a character appears
+        /// @param  c    The first character
+        /// @param  end  The end of the characters to check
+        /// @param  character  The character to count
+        /// @return The number of times that character is between c and end
+        ////////////////////////////////////////////////////////////////////////////////
+        static size_t count_char(const uint8_t * c, const uint8_t * end, uint8_t character){
+          size_t count = 0;
+        #if defined(OPENDDL_SSE2)
+          const __m128i character16 = _mm_set1_epi8((char)character);
+          while (end - c >= 16){
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)c), character16));
+            for (; mask != 0; mask &= mask - 1)
+              ++count;
+            c += 16;
+          }
+        #endif
+          for (; c < end; ++c)
+            count += *c == character;
+          return count;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will look for the } that closes a data list (or a data array list) without decoding it
+        ///   It jumps the strings, the char literals and the comments, like find_last_structure_end
+        /// @param  c    The first character after the { of the list
+        /// @param  end  The end of the buffer
+        /// @param  commas  It returns the number of , of the list (not counting the ones inside the subarrays)
+        /// @param  subarrays  It returns the number of subarrays { } of the list (only in the data array lists)
+        /// @return The } that closes the list, or end if it's not closed
+        ////////////////////////////////////////////////////////////////////////////////
+        static const uint8_t * find_data_list_end(const uint8_t * c, const uint8_t * end, size_t &commas, size_t &subarrays){
+          int depth = 0;
+          commas = 0;
+          subarrays = 0;
+          for (;;){
+            const uint8_t * next = find_nesting_char(c, end);
+            if (depth == 0)
+              commas += count_char(c, next, 0x2c); //2c = ,
+            if (next == end)
+              return end;
+            c = next;
+            uint8_t character = *c;
+            if (character == 0x7b){ //7b = {
+              if (depth == 0) ++subarrays;
+              ++depth;
+              ++c;
+            }
+            else if (character == 0x7d){ //7d = }
+              if (depth == 0) return c;
+              --depth;
+              ++c;
+            }
+            else if (character == 0x22 || character == 0x27){ //22 = " and 27 = ' (jumping the escaped characters)
+              ++c;
+              while (c < end && *c != character){
+                if (*c == 0x5c) ++c; //5c = backslash, so the next character is escaped
+                ++c;
+              }
+              if (c >= end) return end;
+              ++c;
+            }
+            else if (end - c >= 2 && c[1] == 0x2f){ //2f = / so it's a // comment
+              c = find_line_end(c + 2, end);
+            }
+            else if (end - c >= 2 && c[1] == 0x2a){ //2a = * so it's a /* comment
+              c = find_comment_end(c + 2, end);
+              if (c == end) return end;
+              c += 2;
+            }
+            else
+              ++c;
+          }
+        }
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class looks for the ends of the structures of the top level in characters that arrive in pieces
+  ///   It's the same as find_last_structure_end, but it remembers where it was (inside a string, a comment...)
+  ///   so every character is checked only once, even if a piece ends in the middle of a token
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_splitter{
+        enum { NORMAL, STRING, STRING_ESCAPE, CHAR, CHAR_ESCAPE, SLASH, LINE_COMMENT, BLOCK_COMMENT, BLOCK_COMMENT_STAR };
+        // Where the last character checked was (one of the enum), and the number of { not closed
+        int state;
+        int depth;
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the splitter, it starts at the top level
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_splitter(){
+          reset();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will go back to the top level (to start a new file)
+        ////////////////////////////////////////////////////////////////////////////////
+        void reset(){
+          state = NORMAL;
+          depth = 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check the next characters of the file
+        /// @param  c    The first character not checked yet
+        /// @param  end  The end of the characters received
+        /// @param  ends  If it's not NULL, the end of every structure of the top level found is added to it (in order)
+        /// @return The character after the last } of the top level found in these characters, or NULL if there is none
+        ////////////////////////////////////////////////////////////////////////////////
+        const uint8_t * scan(const uint8_t * c, const uint8_t * end, dynarray<const uint8_t *> * ends = NULL){
+          const uint8_t * last = NULL;
+          while (c < end){
+            uint8_t character = *c;
+            switch (state){
+            case NORMAL:
+              c = openDDL_scanner::find_nesting_char(c, end);
+              if (c == end) return last;
+              character = *c;
+              if (character == 0x7b) //7b = {
+                ++depth;
+              else if (character == 0x7d){ //7d = }
+                if (--depth == 0){
+                  last = c + 1;
+                  if (ends != NULL) ends->push_back(last);
+                }
+              }
+              else if (character == 0x22) state = STRING; //22 = "
+              else if (character == 0x27) state = CHAR; //27 = '
+              else if (character == 0x2f) state = SLASH; //2f = /
+              break;
+            case STRING:
+              if (character == 0x5c) state = STRING_ESCAPE; //5c = backslash
+              else if (character == 0x22) state = NORMAL;
+              break;
+            case CHAR:
+              if (character == 0x5c) state = CHAR_ESCAPE;
+              else if (character == 0x27) state = NORMAL;
+              break;
+            case STRING_ESCAPE:
+              state = STRING;
+              break;
+            case CHAR_ESCAPE:
+              state = CHAR;
+              break;
+            case SLASH:
+              if (character == 0x2f) state = LINE_COMMENT;
+              else if (character == 0x2a) state = BLOCK_COMMENT; //2a = *
+              else{ //It was only a /, so check this character again as a normal one
+                state = NORMAL;
+                continue;
+              }
+              break;
+            case LINE_COMMENT:
+              c = openDDL_scanner::find_line_end(c, end);
+              if (c == end) return last;
+              state = NORMAL;
+              break;
+            case BLOCK_COMMENT:
+              if (character == 0x2a) state = BLOCK_COMMENT_STAR;
+              break;
+            case BLOCK_COMMENT_STAR:
+              if (character == 0x2f) state = NORMAL;
+              else if (character != 0x2a) state = BLOCK_COMMENT;
+              break;
+            }
+            ++c;
+          }
+          return last;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if the characters checked finish at the top level (no structure or comment open)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool is_top_level(){
+          return depth == 0 && (state == NORMAL || state == LINE_COMMENT);
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
@@ -11,6 +11,11 @@
 ///   struct openDDL_properties;
 ///   struct openDDL_data_literal;
 ///     It contains also some enums (for structureType, and value_type_DDL)
+///
+///   The structures are a flat tree: they are stored in the arena of the document one after the other (in the order
+///   of the file), each one is linked to its first substructure and to the next structure of its father, and the
+///   properties of a structure are one array. They are not resources (no refcount, no virtual functions), so they are
+///   small and the arena does not need to destroy them.
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifndef OPENDDL_STRUCTURES_INCLUDED
@@ -45,7 +50,7 @@ namespace octet
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief This struct is represent a data_literal
   ////////////////////////////////////////////////////////////////////////////////
-      struct openDDL_data_literal : public resource{
+      struct openDDL_data_literal{
       public:
         value_type_DDL value_type;
         union my_literal {
@@ -59,41 +64,389 @@ namespace octet
         } value;
         int size_string_;
         bool global_ref_;
+        // The atom of the string or the reference in the atom table of the document (only STRING and REF, check openDDL_atoms.h)
+        int atom_;
+        // The atoms of the names of a reference with more than one name ($a%b%c has 3), or NULL if it has one (atom_)
+        int * path_;
+        int path_size_;
+        // The structure referenced, found after lexing by resolve_references (NULL if it's null or it was not found)
+        openDDL_structure * target_;
       };
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief This struct is represent some properties in openDDL
   ////////////////////////////////////////////////////////////////////////////////
-      struct openDDL_properties : public resource {
-        int identifierID;
+      struct openDDL_properties{
+        int identifierID; //The identifier of the language (for openGEX, the value of gex_ident_list)
         openDDL_data_literal literal;
       };
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This struct is a view of a contiguous array (pointer to the first element and number of elements)
+  ///   It does not own the memory, it's only a handy way to read the typed arrays of a data_list
+  ////////////////////////////////////////////////////////////////////////////////
+      template <class element_type> struct openDDL_span{
+        element_type * data_;
+        size_t size_;
+
+        openDDL_span(){
+          data_ = NULL;
+          size_ = 0;
+        }
+
+        openDDL_span(element_type * n_data, size_t n_size){
+          data_ = n_data;
+          size_ = n_size;
+        }
+
+        size_t size(){
+          return size_;
+        }
+
+        element_type * data(){
+          return data_;
+        }
+
+        element_type &operator[](size_t index){
+          return data_[index];
+        }
+      };
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief This struct is represent some data_list in openDDL
+  ///   The numbers (and bools) are stored in a contiguous array with their native type (float, double, int8...uint64)
+  ///   so there is no allocation per element. Only strings, refs and types keep one openDDL_data_literal per element.
   ////////////////////////////////////////////////////////////////////////////////
       struct openDDL_data_list : public resource{
         value_type_DDL value_type;
+        // This is the token of the type of the elements (tok_bool ... tok_type)
+        int token_type;
+        // Literals of the elements that are not numbers (string, ref and type)
         dynarray<openDDL_data_literal*> data_list;
+      protected:
+        // Contiguous storage of the numbers with their native type (malloc'ed, so it can be bigger than 4GB)
+        uint8_t * payload;
+        // Capacity of the payload in bytes
+        size_t payload_capacity;
+        // Number of elements of the list
+        size_t num_elements;
+        // False if the list is a view of the elements of another list (a subarray), then the payload is not freed
+        bool owns_payload;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will make the payload bigger (keeping the elements already stored)
+        /// @param  bytes The new capacity in bytes
+        ////////////////////////////////////////////////////////////////////////////////
+        void grow_payload(size_t bytes){
+          assert(owns_payload && "Adding elements to a view of a data_list!");
+          uint8_t * new_payload = (uint8_t *)realloc(payload, bytes);
+          if (new_payload == NULL){
+            printf("ERROR: There is not enough memory for the data_list!\n");
+            assert(0 && "There is not enough memory for the data_list!");
+            return;
+          }
+          payload = new_payload;
+          payload_capacity = bytes;
+        }
+
+        // The data_list owns its payload, so it cannot be copied
+        openDDL_data_list(const openDDL_data_list &);
+        openDDL_data_list &operator=(const openDDL_data_list &);
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the data_list
+        /// @param  n_token_type  This is the token of the type of the elements of the list
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_data_list(int n_token_type = -1){
+          token_type = n_token_type;
+          value_type = n_token_type < 0 ? UINT : (value_type_DDL)convert_type_token_to_DDL(n_token_type);
+          payload = NULL;
+          payload_capacity = 0;
+          num_elements = 0;
+          owns_payload = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Destructor of the data_list, it frees the payload
+        ////////////////////////////////////////////////////////////////////////////////
+        ~openDDL_data_list(){
+          if (owns_payload)
+            free(payload);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will make this list a view of some elements of another list (used for the subarrays)
+        /// @param  source  The list with the elements, it has to live longer than the view
+        /// @param  first The index of the first element of the view
+        /// @param  count The number of elements of the view
+        ///   The numbers are not copied (the view points to the payload of source), the literals are
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_view(openDDL_data_list &source, size_t first, size_t count){
+          clear(source.token_type);
+          if (owns_payload)
+            free(payload);
+          owns_payload = false;
+          payload_capacity = 0;
+          if (is_numeric())
+            payload = source.payload + first * element_size(token_type);
+          else{
+            payload = NULL;
+            data_list.reserve((unsigned int)count);
+            for (size_t i = 0; i < count; ++i)
+              data_list.push_back(source.data_list[(unsigned int)(first + i)]);
+          }
+          num_elements = count;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will make this list a view of numbers stored outside the document (used by the binary cache)
+        /// @param  n_token_type  This is the token of the type of the numbers (it has to be numeric)
+        /// @param  values  The numbers with their native type, they have to live longer than the view
+        /// @param  count The number of elements
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_external_view(int n_token_type, const void * values, size_t count){
+          clear(n_token_type);
+          if (owns_payload)
+            free(payload);
+          owns_payload = false;
+          payload_capacity = 0;
+          payload = (uint8_t *)values;
+          num_elements = count;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the size in bytes of an element stored natively
+        /// @param  token The token of the type of the element
+        /// @return The size in bytes of the element, or 0 if it's not stored natively (string, ref, type)
+        ////////////////////////////////////////////////////////////////////////////////
+        static int element_size(int token){
+          switch (token){
+          case 0: case 1: case 5: //bool, int8, unsigned_int8
+            return 1;
+          case 2: case 6: //int16, unsigned_int16
+            return 2;
+          case 3: case 7: case 9: //int32, unsigned_int32, float
+            return 4;
+          case 4: case 8: case 10: //int64, unsigned_int64, double
+            return 8;
+          default:
+            return 0;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if the elements are stored in the contiguous typed array
+        /// @return True if the elements of this list are numbers (or bools)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool is_numeric(){
+          return element_size(token_type) > 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the number of elements of the list
+        /// @return The number of elements
+        ////////////////////////////////////////////////////////////////////////////////
+        size_t size(){
+          return num_elements;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will reserve memory for a given number of elements
+        /// @param  num_reserve The number of elements to reserve
+        ////////////////////////////////////////////////////////////////////////////////
+        void reserve(size_t num_reserve){
+          if (is_numeric()){
+            size_t bytes = num_reserve * element_size(token_type);
+            if (payload_capacity < bytes)
+              grow_payload(bytes);
+          }
+          else
+            data_list.reserve((unsigned int)num_reserve);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a new number at the end of the contiguous array
+        /// @param  value The value to add, it has to be of the native type of the list
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class element_type> void add_value(element_type value){
+          assert(sizeof(element_type) == element_size(token_type) && "Adding a value with a wrong type to the data_list!");
+          size_t needed = (num_elements + 1) * sizeof(element_type);
+          if (payload_capacity < needed)
+            grow_payload(needed < 2 * payload_capacity ? 2 * payload_capacity : needed);
+          ((element_type*)payload)[num_elements] = value;
+          ++num_elements;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add some numbers at the end of the contiguous array, to be written directly
+        /// @param  count The number of elements to add
+        /// @return A pointer to the first new element, it's valid till the list grows again
+        ///   It's used to decode the subarrays of a data array list without adding the elements one by one
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class element_type> element_type * append_values(size_t count){
+          assert(sizeof(element_type) == element_size(token_type) && "Adding a value with a wrong type to the data_list!");
+          size_t needed = (num_elements + count) * sizeof(element_type);
+          if (payload_capacity < needed)
+            grow_payload(needed < 2 * payload_capacity ? 2 * payload_capacity : needed);
+          element_type * values = (element_type*)payload + num_elements;
+          num_elements += count;
+          return values;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a new literal (string, ref or type) to the list
+        /// @param  literal The literal to add
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_literal(openDDL_data_literal * literal){
+          data_list.push_back(literal);
+          ++num_elements;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will empty the list to reuse it (the memory of the payload is kept)
+        /// @param  n_token_type  This is the token of the type of the new elements of the list
+        ////////////////////////////////////////////////////////////////////////////////
+        void clear(int n_token_type){
+          token_type = n_token_type;
+          value_type = n_token_type < 0 ? UINT : (value_type_DDL)convert_type_token_to_DDL(n_token_type);
+          data_list.reset();
+          num_elements = 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the contiguous array with the native type of the list
+        /// @return A span with the elements (it has to be requested with the native type of the list)
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class element_type> openDDL_span<element_type> get_span(){
+          assert(sizeof(element_type) == element_size(token_type) && "Reading the data_list with a wrong type!");
+          return openDDL_span<element_type>((element_type*)payload, num_elements);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the bytes of the contiguous array, whatever the type of the list (to save them in a file)
+        /// @return The first byte of the numbers (there are size() * element_size(token_type) bytes)
+        ////////////////////////////////////////////////////////////////////////////////
+        const uint8_t * get_bytes(){
+          return payload;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will copy (and convert) the elements of the list into an array of any numeric type
+        /// @param  dest  The array where to copy the elements, it has to have space for count elements
+        /// @param  first The index of the first element to copy
+        /// @param  count The number of elements to copy
+        ///   The switch is done once per call, not per element, so it's the fast way to read big lists
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class dest_type> void get_values(dest_type * dest, size_t first, size_t count){
+          assert(first + count <= num_elements && "Reading out of the data_list!");
+          const uint8_t * src = payload;
+          switch (token_type){
+          case 0:  copy_values(dest, (const bool *)src + first, count); break;
+          case 1:  copy_values(dest, (const int8_t *)src + first, count); break;
+          case 2:  copy_values(dest, (const int16_t *)src + first, count); break;
+          case 3:  copy_values(dest, (const int32_t *)src + first, count); break;
+          case 4:  copy_values(dest, (const int64_t *)src + first, count); break;
+          case 5:  copy_values(dest, (const uint8_t *)src + first, count); break;
+          case 6:  copy_values(dest, (const uint16_t *)src + first, count); break;
+          case 7:  copy_values(dest, (const uint32_t *)src + first, count); break;
+          case 8:  copy_values(dest, (const uint64_t *)src + first, count); break;
+          case 9:  copy_values(dest, (const float *)src + first, count); break;
+          case 10: copy_values(dest, (const double *)src + first, count); break;
+          default:
+            assert(0 && "This data_list does not contain numbers!");
+            break;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Some handy functions to read a single element of the list (converting it to the type requested)
+        /// @param  index The index of the element
+        /// @return The value of the element
+        ////////////////////////////////////////////////////////////////////////////////
+        float get_float(size_t index){
+          float value;
+          get_values(&value, index, 1);
+          return value;
+        }
+
+        double get_double(size_t index){
+          double value;
+          get_values(&value, index, 1);
+          return value;
+        }
+
+        int64_t get_integer(size_t index){
+          int64_t value;
+          get_values(&value, index, 1);
+          return value;
+        }
+
+        uint64_t get_unsigned(size_t index){
+          uint64_t value;
+          get_values(&value, index, 1);
+          return value;
+        }
+
+        bool get_bool(size_t index){
+          return get_unsigned(index) != 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Some handy functions to read the literals of the list (strings, refs and types)
+        /// @param  index The index of the element
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_data_literal * get_literal(size_t index){
+          return data_list[(unsigned int)index];
+        }
+
+        char * get_string(size_t index){
+          return data_list[(unsigned int)index]->value.string_;
+        }
+
+        int get_string_size(size_t index){
+          return data_list[(unsigned int)index]->size_string_;
+        }
+
+        char * get_ref(size_t index){
+          return data_list[(unsigned int)index]->value.ref_;
+        }
+
+        int get_atom(size_t index){
+          return data_list[(unsigned int)index]->atom_;
+        }
+
+        openDDL_structure * get_target(size_t index){
+          return data_list[(unsigned int)index]->target_;
+        }
+
+      protected:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is the tight loop used by get_values once the type of the source is known
+        ////////////////////////////////////////////////////////////////////////////////
+        template <class dest_type, class src_type> static void copy_values(dest_type * dest, const src_type * src, size_t count){
+          for (size_t i = 0; i < count; ++i)
+            dest[i] = (dest_type)src[i];
+        }
       };
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief This class represents structures in openDDL, it will be a parent class for the different types of structures
   ////////////////////////////////////////////////////////////////////////////////
-      class openDDL_structure : public resource{
+      class openDDL_structure{
       protected:
         structureType type;
         int nameID;
         char * name;
         openDDL_identifier_structure * father_structure;
-        //Local names and references
-        dictionary<openDDL_structure *> names_;
+        // The next substructure of the father (NULL if this is the last one)
+        openDDL_structure * next_sibling;
       
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This will initialize the structure with no name and no type
         ////////////////////////////////////////////////////////////////////////////////
         void init(){
           father_structure = NULL;
+          next_sibling = NULL;
           name = NULL;
           nameID = -1;
           type = NOT_YET_TYPE;
@@ -108,7 +461,7 @@ namespace octet
 
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This will get the name identificator of the class
-        /// @return The identificator of the name. If it has no name it will return -1
+        /// @return The atom of the name in the atom table of the document. If it has no name it will return -1
         ////////////////////////////////////////////////////////////////////////////////
         int get_nameID(){
           return nameID;
@@ -171,49 +524,19 @@ namespace octet
         }
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will get the index of the name
-        /// @param  name  A char pointer that contains the name
-        /// @return -1 if the name has not been initialized yet or the index of the name
-        ////////////////////////////////////////////////////////////////////////////////
-        int get_local_index(char *name){
-          return names_.get_index(name);
-        }
-
-        ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will get the index of the name
-        /// @param  name  A char pointer that contains the name
-        /// @return -1 if the name has not been initialized yet or the index of the name
+        /// @brief This will get the next substructure of the father of this structure
+        /// @return The next structure, or NULL if this is the last substructure (or a structure of the top level)
         ////////////////////////////////////////////////////////////////////////////////
-        int set_local_name(char *name, openDDL_structure * structure){
-          names_[name] = structure;
-          return names_.get_index(name);
+        openDDL_structure * get_next_sibling(){
+          return next_sibling;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will get the structure being part of a local name (by index)
-        /// @param  index The index to the local name willing to obtain
-        /// @return The pointer to the structure with that name
+        /// @brief This will set the next substructure of the father of this structure
+        /// @param  n_next_sibling  The next structure
         ////////////////////////////////////////////////////////////////////////////////
-        openDDL_structure * get_local_name(int index){
-          return names_.get_value(index);
-        }
-
-        ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will get the structure being part of a local name (by name)
-        /// @param  name  A char pointer that contains the name
-        /// @return The pointer to the structure with that name
-        ////////////////////////////////////////////////////////////////////////////////
-        openDDL_structure * get_local_name(char *name){
-          return names_[name];
-        }
-
-        ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will get the structure being part of a local name (by index)
-        /// @param  index The index to the local name willing to obtain
-        /// @return The pointer to the char of the name
-        ////////////////////////////////////////////////////////////////////////////////
-        const char * get_local_name_char(int index){
-          return names_.get_key(index);
+        void set_next_sibling(openDDL_structure * n_next_sibling){
+          next_sibling = n_next_sibling;
         }
 
       };
@@ -224,14 +547,29 @@ namespace octet
       class openDDL_identifier_structure : public openDDL_structure{
       protected:
         int identifierID;
-        dynarray<openDDL_properties*> propertiesList;
-        dynarray<openDDL_structure*> substructureList;
+        // The properties, one after the other (they are copied in the arena once they are all read)
+        openDDL_properties * properties;
+        int num_properties;
+        // The substructures are linked with next_sibling, from the first one to the last one
+        openDDL_structure * first_substructure;
+        openDDL_structure * last_substructure;
+        int num_substructures;
+        // The last substructure returned by get_substructure (and its index), so the loops by index don't walk the list
+        openDDL_structure * cursor_substructure;
+        int cursor_index;
 
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This will initialize the structure with type "identifier"
         ////////////////////////////////////////////////////////////////////////////////
         void init(){
           type = IDENTIFIER_TYPE;
+          properties = NULL;
+          num_properties = 0;
+          first_substructure = NULL;
+          last_substructure = NULL;
+          num_substructures = 0;
+          cursor_substructure = NULL;
+          cursor_index = -1;
         }
       public:
         ////////////////////////////////////////////////////////////////////////////////
@@ -273,11 +611,13 @@ namespace octet
         }
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will add a new property to the structure
-        /// @param  new_property  The new property to add
+        /// @brief This will set the properties of the structure
+        /// @param  new_properties  The array of properties (it's not copied, it has to live as long as the structure)
+        /// @param  count  The number of properties
         ////////////////////////////////////////////////////////////////////////////////
-        void add_property(openDDL_properties * new_property){
-          propertiesList.push_back(new_property);
+        void set_properties(openDDL_properties * new_properties, int count){
+          properties = new_properties;
+          num_properties = count;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -285,7 +625,7 @@ namespace octet
         /// @return Int with the ammount of properties
         ////////////////////////////////////////////////////////////////////////////////
         int get_number_properties(){
-          return propertiesList.size();
+          return num_properties;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -294,15 +634,22 @@ namespace octet
         /// @return A pointer to the given property
         ////////////////////////////////////////////////////////////////////////////////
         openDDL_properties *get_property(int index){
-          return propertiesList[index];
+          assert((unsigned int)index < (unsigned int)num_properties);
+          return &properties[index];
         }
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will add a new structure to the structure
+        /// @brief This will add a new structure to the structure (after the last one)
         /// @param  new_structure  The new structure to add
         ////////////////////////////////////////////////////////////////////////////////
         void add_structure(openDDL_structure *new_structure){
-          substructureList.push_back(new_structure);
+          new_structure->set_next_sibling(NULL);
+          if (last_substructure == NULL)
+            first_substructure = new_structure;
+          else
+            last_substructure->set_next_sibling(new_structure);
+          last_substructure = new_structure;
+          ++num_substructures;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -310,33 +657,126 @@ namespace octet
         /// @return Int with the ammount of substructures
         ////////////////////////////////////////////////////////////////////////////////
         int get_number_substructures(){
-          return substructureList.size();
+          return num_substructures;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the first substructure (use get_next_sibling to get the next ones)
+        /// @return A pointer to the first substructure, or NULL if it has no substructures
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_structure *get_first_substructure(){
+          return first_substructure;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This will return a given substructure by an index
         /// @param  index The index of the substructure to get
         /// @return A pointer to the given substructure
+        ///   The list is walked from the last substructure returned, so asking them in order is as fast as an array
         ////////////////////////////////////////////////////////////////////////////////
         openDDL_structure *get_substructure(int index){
-          return substructureList[index];
+          assert((unsigned int)index < (unsigned int)num_substructures);
+          if (cursor_substructure == NULL || index < cursor_index){
+            cursor_substructure = first_substructure;
+            cursor_index = 0;
+          }
+          for (; cursor_index < index; ++cursor_index)
+            cursor_substructure = cursor_substructure->get_next_sibling();
+          return cursor_substructure;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the substructure with a local name
+        /// @param  atom  The atom of the name (with the %)
+        /// @return The substructure with this name, or NULL if there is none
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_structure *find_local_name(int atom){
+          for (openDDL_structure * substructure = first_substructure; substructure != NULL; substructure = substructure->get_next_sibling()){
+            if (substructure->get_nameID() == atom)
+              return substructure;
+          }
+          return NULL;
         }
       };
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is the interface of who decodes the data lists that were not decoded while lexing (lazy mode)
+  ///   The lexer implements it, the structures only know this interface
+  ////////////////////////////////////////////////////////////////////////////////
+      class openDDL_lazy_decoder{
+      public:
+        virtual ~openDDL_lazy_decoder(){}
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will decode the data lists of a structure, and add them to it
+        /// @param  structure  The structure of data type that has the data lists
+        /// @param  begin  The first character of the data lists (after the { of a data list, or the { of a data array list)
+        /// @param  end  The } that closes the data lists
+        /// @param  count  The number of elements (counted while lexing), to reserve the memory at once
+        /// @return True if everything went well, false if there was some problem
+        ////////////////////////////////////////////////////////////////////////////////
+        virtual bool decode_data_lists(openDDL_data_type_structure * structure, const uint8_t * begin, const uint8_t * end, size_t count) = 0;
+      };
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief This class represents structures of data type, it may be data_list or data_list_array
+  ///   In lazy mode the data lists are not decoded by the lexer, the structure keeps the characters of the lists
+  ///   and they are decoded the first time that they are requested (get_number_lists or get_data_list)
+  ///   All the subarrays of a data array list are stored one after the other in one list (get_contiguous_list),
+  ///   get_data_list only makes views of the subarrays if they are requested one by one
   ////////////////////////////////////////////////////////////////////////////////
       class openDDL_data_type_structure : public openDDL_structure{
       protected:
         int typeID;
         int integer_literal;
-        dynarray<ref<openDDL_data_list>> data_list_array;
+        // The data list (a structure of data type has one, or none if it's empty)
+        openDDL_data_list * data_list;
+        // The elements of all the subarrays of a data array list, and the views of each subarray (made when requested)
+        openDDL_data_list * array_data;
+        openDDL_data_list * subarrays;
+        // The characters of the data lists not decoded yet (lazy_begin is NULL once they are decoded), and who decodes them
+        const uint8_t * lazy_begin;
+        const uint8_t * lazy_end;
+        openDDL_lazy_decoder * lazy_decoder;
+        // The number of elements of the data lists (counted by the lexer, before decoding them)
+        size_t lazy_count;
       
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This will initialize the structure with type "data_type"
         ////////////////////////////////////////////////////////////////////////////////
         void init(){
           type = DATA_TYPE_TYPE;
+          lazy_begin = NULL;
+          lazy_end = NULL;
+          lazy_decoder = NULL;
+          lazy_count = 0;
+          data_list = NULL;
+          array_data = NULL;
+          subarrays = NULL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will decode the data lists if they were not decoded yet (only the first call does something)
+        ////////////////////////////////////////////////////////////////////////////////
+        void decode(){
+          if (lazy_begin != NULL){
+            const uint8_t * begin = lazy_begin;
+            lazy_begin = NULL;
+            if (!lazy_decoder->decode_data_lists(this, begin, lazy_end, lazy_count))
+              printf("ERROR: The data list could not be decoded!\n");
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will make the views of the subarrays of a data array list (only the first call does something)
+        ////////////////////////////////////////////////////////////////////////////////
+        void make_subarrays(){
+          if (array_data == NULL || subarrays != NULL)
+            return;
+          size_t num_subarrays = array_data->size() / integer_literal;
+          subarrays = new openDDL_data_list[num_subarrays > 0 ? num_subarrays : 1];
+          for (size_t i = 0; i < num_subarrays; ++i)
+            subarrays[i].set_view(*array_data, i * integer_literal, integer_literal);
         }
       public:
         ////////////////////////////////////////////////////////////////////////////////
@@ -364,6 +804,13 @@ namespace octet
           father_structure = father;
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Destructor, it frees the views of the subarrays (the data lists are freed with the document)
+        ////////////////////////////////////////////////////////////////////////////////
+        ~openDDL_data_type_structure(){
+          delete[] subarrays;
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This will get the data type of the structure
         /// @return The identificator of the data type. If it has no data type it will return -1
@@ -397,11 +844,64 @@ namespace octet
         }
 
         ////////////////////////////////////////////////////////////////////////////////
-        /// @brief This will add a new data_list to the structure
-        /// @param  new_data_list  The new data_list to add
+        /// @brief This will set the data_list of the structure
+        /// @param  new_data_list  The data_list
         ////////////////////////////////////////////////////////////////////////////////
         void add_data_list(openDDL_data_list * new_data_list){
-          data_list_array.push_back(new_data_list);
+          data_list = new_data_list;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will set the list with the elements of all the subarrays of a data array list
+        /// @param  new_array_data  The list, with integer_literal elements per subarray
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_array_data(openDDL_data_list * new_array_data){
+          array_data = new_array_data;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This get all the elements of the structure in one list (the fast way to read the data array lists)
+        /// @returns The data list, or all the subarrays one after the other, or NULL if there are no elements
+        ////////////////////////////////////////////////////////////////////////////////
+        openDDL_data_list *get_contiguous_list(){
+          decode();
+          if (array_data != NULL)
+            return array_data;
+          return data_list;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will keep the characters of the data lists to decode them later (lazy mode)
+        /// @param  begin  The first character of the data lists (after the { of a data list, or the { of a data array list)
+        /// @param  end  The } that closes the data lists
+        /// @param  count  The number of elements of the data lists
+        /// @param  decoder  Who will decode the data lists, the characters have to be valid till then
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_lazy_data(const uint8_t * begin, const uint8_t * end, size_t count, openDDL_lazy_decoder * decoder){
+          lazy_begin = begin;
+          lazy_end = end;
+          lazy_count = count;
+          lazy_decoder = decoder;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if the data lists are already decoded
+        /// @returns False if the data lists are waiting to be decoded (lazy mode)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool is_decoded(){
+          return lazy_begin == NULL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This obtain the number of elements of all the data_lists, without decoding them
+        /// @returns The ammount of elements (the sum of the sizes of the data_lists)
+        ////////////////////////////////////////////////////////////////////////////////
+        size_t get_number_elements(){
+          if (lazy_begin != NULL)
+            return lazy_count;
+          if (array_data != NULL)
+            return array_data->size();
+          return data_list != NULL ? data_list->size() : 0;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -409,7 +909,10 @@ namespace octet
         /// @returns The ammount of data_lists inside the structure
         ////////////////////////////////////////////////////////////////////////////////
         int get_number_lists(){
-          return data_list_array.size();
+          decode();
+          if (array_data != NULL)
+            return (int)(array_data->size() / integer_literal);
+          return data_list != NULL ? 1 : 0;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -418,7 +921,14 @@ namespace octet
         /// @returns A pointer to the asked data_list
         ////////////////////////////////////////////////////////////////////////////////
         openDDL_data_list *get_data_list(int index){
-          return data_list_array[index];
+          decode();
+          if (array_data == NULL){
+            assert(index == 0 && data_list != NULL);
+            return data_list;
+          }
+          make_subarrays();
+          assert((size_t)index < array_data->size() / integer_literal);
+          return &subarrays[index];
         }
       };
     }
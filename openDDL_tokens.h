@@ -54,10 +54,10 @@ namespace octet
       public:
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This function will return the token_name of the given token identifier
-        ///
+        ///   The names are constant data, so nothing is created when calling this function
         ////////////////////////////////////////////////////////////////////////////////
-        static const string token_name(unsigned t){
-          static const string token_names[tok_last] = {
+        static const char * token_name(unsigned t){
+          static const char * const token_names[tok_last] = {
             "bool", 
             "int8", "int16", "int32", "int64", 
             "unsigned_int8", "unsigned_int16", "unsigned_int32", "unsigned_int64", 
@@ -70,6 +70,70 @@ namespace octet
           return token_names[(int)t];
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is the hash used to find the types and identifiers (perfect hash, it has no collisions)
+        /// @param  word  The first character of the word
+        /// @param  size  The size of the word (at least 1)
+        /// @param  seed  The multiplier of the hash, it has to be searched for every list of names
+        /// @param  bits  The number of bits of the hash (the table has 1 << bits elements)
+        /// @return The position of the word in the table
+        ///   It only uses the size and the first, middle and last characters, so it's faster than reading all the word.
+        ///   The seeds of the tables were searched offline trying all of them till the names had no collisions
+        ////////////////////////////////////////////////////////////////////////////////
+        static unsigned int hash_word(const char * word, int size, unsigned int seed, int bits){
+          unsigned int key = (uint8_t)word[0] | ((uint8_t)word[size - 1] << 8) | ((uint8_t)word[size / 2] << 16) | ((unsigned int)size << 24);
+          return (key * seed) >> (32 - bits);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if a word is exactly the name given (the word does not need to end with \0)
+        /// @param  name  The name, ended with \0
+        /// @param  word  The first character of the word
+        /// @param  size  The size of the word
+        /// @return True if they are the same
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool equal_name(const char * name, const char * word, int size){
+          return strncmp(name, word, size) == 0 && name[size] == '\0';
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the type of a word (bool, int8 ... type) without creating strings or dictionaries
+        /// @param  word  The first character of the word
+        /// @param  size  The size of the word
+        /// @return The token of the type, or -1 if the word is not a type
+        ////////////////////////////////////////////////////////////////////////////////
+        static int find_type(const char * word, int size){
+          // The 14 types (tok_bool ... tok_type) in their position of the hash (seed 282103, 4 bits)
+          static const signed char type_table[16] = {
+             4,  2,  1, -1,  5, 10, 12,  0, 11,  9, 13, -1,  7,  8,  6,  3
+          };
+          if (size < 3)
+            return -1;
+          int token = type_table[hash_word(word, size, 282103u, 4)];
+          if (token < 0 || !equal_name(token_name(token), word, size))
+            return -1;
+          return token;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the symbol of a character ({ } [ ] ( ) , =)
+        /// @param  character The character
+        /// @return The token of the symbol, or -1 if it's not a symbol
+        ////////////////////////////////////////////////////////////////////////////////
+        static int find_symbol(uint8_t character){
+          switch (character){
+          case 0x7b: return tok_lbrace;   //7b = {
+          case 0x7d: return tok_rbrace;   //7d = }
+          case 0x5b: return tok_lbracket; //5b = [
+          case 0x5d: return tok_rbracket; //5d = ]
+          case 0x28: return tok_lparen;   //28 = (
+          case 0x29: return tok_rparen;   //29 = )
+          case 0x2c: return tok_comma;    //2c = ,
+          case 0x3d: return tok_equal;    //3d = =
+          default: return -1;
+          }
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This will return the enum token_type bool, that it's the first type of the enum
         ////////////////////////////////////////////////////////////////////////////////
@@ -92,9 +92,10 @@ namespace octet
       public:
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief This function will return the token_name of the given openGEX identifiers (and properties)
+        ///   The names are constant data, so nothing is created when calling this function
         ////////////////////////////////////////////////////////////////////////////////
-        static const string ident_name(unsigned t){
-          static const string ident_names[ident_last] = {
+        static const char * ident_name(unsigned t){
+          static const char * const ident_names[ident_last] = {
             "Animation",      // identificator 00
             "Atten",          // identificator 01
             "BoneCountArray", // identificator 02
@@ -158,6 +159,33 @@ namespace octet
           assert((t < ident_last) && "Calling a token bigger than the token list!");
           return ident_names[(int)t];
         }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the openGEX identifier (or property) of a word, without creating strings or dictionaries
+        /// @param  word  The first character of the word
+        /// @param  size  The size of the word
+        /// @return The identifier (id_Animation ... prop_visible), or -1 if the word is not an identifier
+        ///   It uses the perfect hash of ddl_token::hash_word, if an identifier is added the seed has to be searched again
+        ////////////////////////////////////////////////////////////////////////////////
+        static int find_ident(const char * word, int size){
+          // The 58 identifiers in their position of the hash (seed 6467407, 7 bits)
+          static const signed char ident_table[128] = {
+            11, 23, -1, 26, -1, 56, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, 27, -1, 57, -1, 18, 19, 54, -1, -1,  3, -1, -1,
+            55, 14, 44, 53, 16,  5, -1, -1, -1, 15, 46, 31, 35, 12, -1, -1,
+            52, -1,  2, -1, -1, -1, 41, 25, 42, -1, -1, 38, -1,  1, 51, -1,
+            -1, -1, -1, -1, -1,  7,  9, -1, 34, -1, -1, -1, -1, -1, -1,  8,
+            37, -1, -1, 45, 29, 28, 32, -1, 39, -1,  0, -1, -1, 17, -1, 24,
+            -1, -1, 22, -1, 50, -1, -1, 10, 20, -1, 48, 36, 13, -1, 47, -1,
+            -1, 33, 43, 49,  6,  4, 21, -1, 30, -1, 40, -1, -1, -1, -1, -1
+          };
+          if (size < 3)
+            return -1;
+          int ident = ident_table[ddl_token::hash_word(word, size, 6467407u, 7)];
+          if (ident < 0 || !ddl_token::equal_name(ident_name(ident), word, size))
+            return -1;
+          return ident;
+        }
       };
     }
   }
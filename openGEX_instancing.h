@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openGEX_instancing.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the instanced representation of the GeometryNodes that use the same GeometryObject
+///
+///   Each GeometryNode of a file gets its own mesh_instance, even when a lot of them have the same ObjectRef.
+///   With set_instancing (check openGEX_parser), the mesh_instances of a GeometryObject used by more than one
+///   node are not added to the dictionary, they are added to an openGEX_instanced_mesh (one for each IndexArray).
+///   It has the mesh, shared by all of them, and after update() the transforms of the instances packed one after
+///   the other (modelToWorld), grouped by their material: every group can be drawn with one instanced call.
+///   The mesh_instances are kept in it as well, so a renderer without instancing (or a test without a GPU) can
+///   still draw or check them one by one, as if the instancing was not used.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENGEX_INSTANCING_INCLUDED
+#define OPENGEX_INSTANCING_INCLUDED
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is a group of instances with the same material (the ones drawn by one instanced call)
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openGEX_instance_batch{
+        // The index of the material (get_material) and the first and number of instances of the packed arrays
+        unsigned int material_index;
+        unsigned int first_instance;
+        unsigned int num_instances;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class has one mesh and all the instances of it (check the beginning of the file)
+  ////////////////////////////////////////////////////////////////////////////////
+      class openGEX_instanced_mesh : public resource{
+        ref<mesh> instanced_mesh;
+        // The layout of the vertices of the mesh (check openGEX_vertex_format.h)
+        int vertex_format;
+        // The instances, in the order they were added (the CPU path)
+        dynarray<ref<mesh_instance>> instances;
+        // The packed arrays, filled by update(): one element for each instance, in the order of the batches
+        dynarray<mat4t> transforms;
+        dynarray<unsigned int> material_indices;
+        dynarray<unsigned int> packed_instances;
+        // The different materials of the instances (an instance can have NULL if its Material was not found)
+        dynarray<material *> materials;
+        dynarray<openGEX_instance_batch> batches;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the index of a material in the list of materials, adding it if it's not there
+        /// @param  last  The index of the material of the previous instance (usually the same one), or -1
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int find_material(material * instance_material, int last){
+          if (last >= 0 && materials[last] == instance_material)
+            return (unsigned int)last;
+          for (unsigned int i = 0; i < materials.size(); ++i){
+            if (materials[i] == instance_material)
+              return i;
+          }
+          materials.push_back(instance_material);
+          return materials.size() - 1;
+        }
+
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the instanced mesh
+        /// @param  new_mesh  The mesh of all the instances
+        /// @param  format  The layout of its vertices
+        ////////////////////////////////////////////////////////////////////////////////
+        openGEX_instanced_mesh(mesh * new_mesh, int format){
+          instanced_mesh = new_mesh;
+          vertex_format = format;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add an instance (it has to use the mesh of the instanced mesh)
+        ///   The packed arrays are not valid till update() is called again
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_instance(mesh_instance * instance){
+          instances.push_back(instance);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will fill the packed arrays with the transforms and the materials that the instances have now
+        ///   The materials of the instances can be set after the instance is added (the Materials after the nodes),
+        ///   and the nodes can be animated, so it has to be called after loading and whenever the nodes move.
+        ////////////////////////////////////////////////////////////////////////////////
+        void update(){
+          unsigned int num_instances = instances.size();
+          materials.reset();
+          batches.reset();
+          transforms.resize(num_instances);
+          material_indices.resize(num_instances);
+          packed_instances.resize(num_instances);
+          //First find the material of every instance, and count how many instances has each one of them
+          dynarray<unsigned int> instance_materials(num_instances);
+          dynarray<unsigned int> counts;
+          int last = -1;
+          for (unsigned int i = 0; i < num_instances; ++i){
+            unsigned int material_index = find_material(instances[i]->get_material(), last);
+            if (material_index == counts.size())
+              counts.push_back(0);
+            ++counts[material_index];
+            instance_materials[i] = material_index;
+            last = (int)material_index;
+          }
+          //Then the batches are one after the other, in the order of the materials
+          unsigned int first = 0;
+          for (unsigned int i = 0; i < counts.size(); ++i){
+            openGEX_instance_batch batch;
+            batch.material_index = i;
+            batch.first_instance = first;
+            batch.num_instances = counts[i];
+            batches.push_back(batch);
+            counts[i] = first;
+            first += batch.num_instances;
+          }
+          //And finally the instances are packed in their batch, keeping their order inside it
+          for (unsigned int i = 0; i < num_instances; ++i){
+            unsigned int packed = counts[instance_materials[i]]++;
+            transforms[packed] = instances[i]->get_node()->calcModelToWorld();
+            material_indices[packed] = instance_materials[i];
+            packed_instances[packed] = i;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the mesh of all the instances
+        ////////////////////////////////////////////////////////////////////////////////
+        mesh * get_mesh(){
+          return instanced_mesh;
+        }
+
+        int get_vertex_format() const{
+          return vertex_format;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the number of instances
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int get_num_instances() const{
+          return instances.size();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return an instance, in the order they were added (to draw them one by one)
+        ////////////////////////////////////////////////////////////////////////////////
+        mesh_instance * get_instance(unsigned int index){
+          return instances[index];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the transforms of the instances (modelToWorld), packed in the order of the batches
+        ///   There are get_num_instances() of them, it's the array to copy to the buffer of the instanced call
+        ////////////////////////////////////////////////////////////////////////////////
+        const mat4t * get_transforms() const{
+          return transforms.data();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the index of the material of each one of the packed transforms
+        ////////////////////////////////////////////////////////////////////////////////
+        const unsigned int * get_material_indices() const{
+          return material_indices.data();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return which instance (get_instance) is each one of the packed transforms
+        ////////////////////////////////////////////////////////////////////////////////
+        const unsigned int * get_packed_instances() const{
+          return packed_instances.data();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the number of different materials of the instances (after update)
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int get_num_materials() const{
+          return materials.size();
+        }
+
+        material * get_material(unsigned int index){
+          return materials[index];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the number of batches (one for each material, after update)
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int get_num_batches() const{
+          return batches.size();
+        }
+
+        const openGEX_instance_batch &get_batch(unsigned int index) const{
+          return batches[index];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will transform the positions of the vertices of the mesh with the packed transforms, in the CPU
+        /// @param  positions  It returns the positions in the world of every vertex of every packed instance
+        ///   It's what the instanced call would draw, without a GPU (to test the instancing with no window)
+        ////////////////////////////////////////////////////////////////////////////////
+        void get_world_positions(dynarray<vec3> &positions){
+          unsigned int num_vertexes = instanced_mesh->get_num_vertices();
+          positions.resize(num_vertexes * transforms.size());
+          if (num_vertexes == 0)
+            return;
+          //The positions are decoded once (with the compact layouts they are in the AABB of the mesh)
+          dynarray<mesh::vertex> decoded(num_vertexes);
+          const aabb &bounds = instanced_mesh->get_aabb();
+          vec3 center = bounds.get_center();
+          vec3 half_extent = bounds.get_half_extent();
+          const float bounds_center[3] = { center[0], center[1], center[2] };
+          const float bounds_half[3] = { half_extent[0], half_extent[1], half_extent[2] };
+          unsigned int stride = openGEX_vertex_format::get_stride(vertex_format);
+          {
+            gl_resource::rolock vl(instanced_mesh->get_vertices());
+            const uint8_t * vertices = vl.u8();
+            for (unsigned int j = 0; j < num_vertexes; ++j)
+              openGEX_vertex_format::decode(vertex_format, vertices + j * stride, bounds_center, bounds_half, decoded[j]);
+          }
+          for (unsigned int i = 0; i < transforms.size(); ++i){
+            //octet works with the transpose matrices, so the position is a row multiplied by the matrix
+            const mat4t &matrix = transforms[i];
+            for (unsigned int j = 0; j < num_vertexes; ++j){
+              const float * position = (const float *)&decoded[j];
+              float world[3];
+              for (int k = 0; k < 3; ++k)
+                world[k] = position[0] * matrix[0][k] + position[1] * matrix[1][k] + position[2] * matrix[2][k] + matrix[3][k];
+              positions[i * num_vertexes + j] = vec3(world[0], world[1], world[2]);
+            }
+          }
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
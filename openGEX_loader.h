@@ -9,6 +9,8 @@
 #define OPENGEX_LOADER_INCLUDED
 
 #include "openGEX_parser.h"
+#include "openDDL_file_map.h"
+#include <chrono>
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief This class is the openGEX loader. 
@@ -27,41 +29,459 @@ namespace octet
       class openGEX_loader {
         /// Source for the image for reloads
         string url;
-        /// Buffer of the file to process
+        /// Buffer of the file to process (only used if the file cannot be mapped in memory)
         dynarray<uint8_t> buffer;
+        /// The file mapped in memory, the lexer reads it in place
+        openDDL_file_map file_map;
+        /// The binary cache mapped in memory (the numbers of the document loaded from it are read in place)
+        openDDL_file_map cache_map;
+        /// If it's true, load_file uses the binary cache of the file (and writes it when it's not valid)
+        bool use_cache;
+        /// The converted scene mapped in memory (check openGEX_scene.h), process_resources replays it
+        openDDL_file_map scene_map;
+        const openGEX_scene_header * scene_header;
+        /// If it's true, process_resources saves the scenes converted, and load_file loads them
+        bool use_scene;
+        /// The file loaded by load_file (with use_scene), to save its scene or to load its document later
+        dynarray<char> scene_file;
+        openDDL_cache_source scene_source;
+        /// It's false when load_file found the scene, and the document was not loaded
+        bool document_loaded;
+
+        /// The files bigger than this are mapped in chunks, so the memory mapped at the same time is limited
+        size_t max_view_size;
+        /// The size of the chunks used to map the big files (it grows if a structure does not fit in a chunk)
+        size_t chunk_size;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will show the time used by the lexer and the memory used by the document
+        /// @param start is the moment when the lexer started
+        /// @param size is the number of characters lexed
+        ////////////////////////////////////////////////////////////////////////////////
+        void print_lexer_stats(std::chrono::high_resolution_clock::time_point start, uint64_t size){
+          double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+          printf("The lexer DDL process has finished successfully!\n");
+          printf("The lexer took %f seconds (%.1f MB/s)\n", seconds, seconds > 0 ? size / (seconds * 1024.0 * 1024.0) : 0.0);
+          printf("The document uses %llu bytes of memory.\n", (unsigned long long)lexer.get_bytes_used());
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will do the lexer process of the characters, and show the time used
+        /// @param data is the first character of the openGEX file
+        /// @param size is the number of characters
+        /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ////////////////////////////////////////////////////////////////////////////////
+        bool lexer_characters(const uint8_t * data, size_t size){
+          //Process the file (lexer) (return false if there was any problem)
+          printf("Starting the lexer process\n");
+          std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+          if (!lexer.lexer_memory(data, size)){
+            printf("Error loading the openGEX file (openDDL process)!\n");
+            return false;
+          }
+          print_lexer_stats(start, size);
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will do the lexer process of the file opened in file_map, mapping a chunk at a time
+        /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ///   Each chunk is cut after the last structure of the top level that it contains, so the lexer only receives
+        ///   complete structures. The previous chunk is unmapped before mapping the next one.
+        ////////////////////////////////////////////////////////////////////////////////
+        bool lexer_chunks(){
+          uint64_t file_size = file_map.get_file_size();
+          uint64_t offset = 0;
+          size_t current_chunk_size = chunk_size;
+          printf("Starting the lexer process (in chunks of %llu bytes)\n", (unsigned long long)chunk_size);
+          std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+          lexer.release_document();
+          while (offset < file_size){
+            size_t size = file_size - offset < current_chunk_size ? (size_t)(file_size - offset) : current_chunk_size;
+            const uint8_t * data = file_map.map(offset, size);
+            if (data == NULL){
+              printf("Error mapping the openGEX file (the chunk at %llu)!\n", (unsigned long long)offset);
+              return false;
+            }
+            // The last chunk goes till the end of the file, the others till the end of their last structure
+            const uint8_t * end = offset + size == file_size ? data + size : openDDL_scanner::find_last_structure_end(data, data + size);
+            if (end == NULL){
+              // There is a structure bigger than the chunk, so try again with a bigger chunk
+              if (current_chunk_size > ((size_t)-1) / 2){
+                printf("Error loading the openGEX file (a structure is too big to be mapped)!\n");
+                return false;
+              }
+              current_chunk_size *= 2;
+              continue;
+            }
+            if (!lexer.lexer_append(data, end - data)){
+              printf("Error loading the openGEX file (openDDL process)!\n");
+              return false;
+            }
+            offset += end - data;
+            current_chunk_size = chunk_size;
+          }
+          file_map.close();
+          // The names of all the chunks are known now, so the references can be resolved
+          lexer.resolve_references();
+          print_lexer_stats(start, file_size);
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will lexer a file (mapped in memory, or read with app_utils::get_url if it cannot be mapped)
+        /// @param name is a constant pointer to a character (it will be the address of the file to open)
+        /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ///   The file is mapped from the path of the name (app_utils::get_path), the same file that get_url reads
+        ////////////////////////////////////////////////////////////////////////////////
+        bool lexer_file(const char * name){
+          string path = app_utils::get_path(name);
+          if (file_map.open(path.c_str())){
+            uint64_t file_size = file_map.get_file_size();
+            if (file_size > max_view_size)
+              return lexer_chunks();
+            const uint8_t * data = file_map.map(0, (size_t)file_size);
+            if (data != NULL)
+              return lexer_characters(data, (size_t)file_size);
+            file_map.close();
+          }
+          app_utils::get_url(buffer, name);
+          return lexer_characters(buffer.data(), buffer.size());
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get the name of a file saved next to another one (the same path with an extension at the end)
+        /// @param name is the address of the file (it's resolved with app_utils::get_path)
+        /// @param extension is the extension added (.ddlc for the binary cache, .gexc for the converted scene)
+        /// @param cache_name returns the path of the new file (ended with \0)
+        ////////////////////////////////////////////////////////////////////////////////
+        static void get_cache_name(const char * name, const char * extension, dynarray<char> &cache_name){
+          string path = app_utils::get_path(name);
+          size_t size = strlen(path.c_str());
+          size_t extension_size = strlen(extension) + 1;
+          cache_name.resize((unsigned int)(size + extension_size));
+          memcpy(cache_name.data(), path.c_str(), size);
+          memcpy(cache_name.data() + size, extension, extension_size);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get the size, the time of modification and the hash of a file (to check its cache)
+        /// @param name is the address of the file (it's resolved with app_utils::get_path)
+        /// @param source returns what the cache of the file has to match
+        /// @return It will return true if the file exists and it could be read
+        ///   The file is mapped in chunks to compute the hash, so it does not need to fit in memory
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool get_source_info(const char * name, openDDL_cache_source &source){
+          string path = app_utils::get_path(name);
+          if (!openDDL_cache::get_file_stat(path.c_str(), source.size, source.mtime))
+            return false;
+          openDDL_file_map source_map;
+          if (!source_map.open(path.c_str()) || source_map.get_file_size() != source.size)
+            return false;
+          source.hash = openDDL_cache::get_initial_hash();
+          for (uint64_t offset = 0; offset < source.size; offset += openDDL_cache::HASH_CHUNK_SIZE){
+            size_t size = source.size - offset < openDDL_cache::HASH_CHUNK_SIZE ? (size_t)(source.size - offset) : openDDL_cache::HASH_CHUNK_SIZE;
+            const uint8_t * data = source_map.map(offset, size);
+            if (data == NULL)
+              return false;
+            source.hash = openDDL_cache::hash_bytes(source.hash, data, size);
+          }
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will load the document from the binary cache of a file, if the cache is valid
+        /// @param cache_name is the address of the cache
+        /// @param source is the size, time of modification and hash of the file now
+        /// @return It will return true if the document was loaded from the cache
+        ///   The cache is kept mapped, the data lists of the document read their numbers from it
+        ////////////////////////////////////////////////////////////////////////////////
+        bool load_cache(const char * cache_name, const openDDL_cache_source &source){
+          if (!cache_map.open(cache_name))
+            return false;
+          std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+          uint64_t cache_size = cache_map.get_file_size();
+          const uint8_t * data = cache_size == (size_t)cache_size ? cache_map.map(0, (size_t)cache_size) : NULL;
+          if (data == NULL || !lexer.read_cache(data, (size_t)cache_size, source)){
+            cache_map.close();
+            return false;
+          }
+          double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+          printf("The document was loaded from the cache %s in %f seconds\n", cache_name, seconds);
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will write the binary cache of the document lexed
+        /// @param cache_name is the address of the cache
+        /// @param source is the size, time of modification and hash of the file lexed
+        ///   If the cache cannot be written it's removed (the file is loaded anyway)
+        ////////////////////////////////////////////////////////////////////////////////
+        void save_cache(const char * cache_name, const openDDL_cache_source &source){
+          FILE * file = fopen(cache_name, "wb");
+          if (file == NULL){
+            printf("WARNING: The cache %s cannot be created!\n", cache_name);
+            return;
+          }
+          bool no_error = lexer.write_cache(file, source);
+          no_error = fclose(file) == 0 && no_error;
+          if (!no_error){
+            printf("WARNING: The cache %s could not be written!\n", cache_name);
+            remove(cache_name);
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will load the document of a file (from its binary cache if it's valid, or with the lexer)
+        /// @param name is the address of the file
+        /// @param source is the size, time of modification and hash of the file (if has_source is true)
+        /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ////////////////////////////////////////////////////////////////////////////////
+        bool load_document(const char * name, const openDDL_cache_source &source, bool has_source){
+          dynarray<char> cache_name;
+          bool cached = use_cache && lexer.can_cache() && has_source;
+          if (cached){
+            get_cache_name(name, ".ddlc", cache_name);
+            if (load_cache(cache_name.data(), source))
+              return true;
+          }
+          bool no_error = lexer_file(name);
+          if (no_error && cached)
+            save_cache(cache_name.data(), source);
+          return no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will map the converted scene of a file, if it's valid
+        /// @param scene_name is the address of the scene
+        /// @param source is the size, time of modification and hash of the file now
+        /// @return It will return true if the scene is mapped in scene_map (and scene_header points to it)
+        ////////////////////////////////////////////////////////////////////////////////
+        bool map_scene(const char * scene_name, const openDDL_cache_source &source){
+          if (!scene_map.open(scene_name))
+            return false;
+          uint64_t scene_size = scene_map.get_file_size();
+          const uint8_t * data = scene_size == (size_t)scene_size ? scene_map.map(0, (size_t)scene_size) : NULL;
+          scene_header = openGEX_scene::check_header(data, (size_t)scene_size, source);
+          if (scene_header == NULL)
+            scene_map.close();
+          return scene_header != NULL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will close the converted scene mapped (before loading another file, or writing the scene again)
+        ////////////////////////////////////////////////////////////////////////////////
+        void close_scene(){
+          scene_map.close();
+          scene_header = NULL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will write the scene recorded by the parser while converting the file
+        /// @param flags are the options of openGEX_data used (check openGEX_scene)
+        ///   If the scene cannot be written it's removed (the resources were created anyway)
+        ////////////////////////////////////////////////////////////////////////////////
+        void save_scene(uint32_t flags){
+          dynarray<char> scene_name;
+          get_cache_name(scene_file.data(), ".gexc", scene_name);
+          FILE * file = fopen(scene_name.data(), "wb");
+          if (file == NULL){
+            printf("WARNING: The converted scene %s cannot be created!\n", scene_name.data());
+            return;
+          }
+          bool no_error = lexer.get_scene().write(file, scene_source, flags, lexer.get_welding_epsilon());
+          no_error = fclose(file) == 0 && no_error;
+          if (!no_error){
+            printf("WARNING: The converted scene %s could not be written!\n", scene_name.data());
+            remove(scene_name.data());
+          }
+        }
       public:
         /// This is the lexer that decodes each block of text from the buffer
         openGEX_parser lexer;
         /// Constructor of the openGEX_loader class
         openGEX_loader(){
+          // In 64 bits the files are mapped at once till 1GB, in 32 bits the address space is smaller
+          max_view_size = sizeof(void *) >= 8 ? 1024 * 1024 * 1024 : 256 * 1024 * 1024;
+          chunk_size = 64 * 1024 * 1024;
+          use_cache = false;
+          use_scene = false;
+          scene_header = NULL;
+          document_loaded = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will change the sizes used to map the files in memory
+        /// @param n_max_view_size is the biggest file that will be mapped at once
+        /// @param n_chunk_size is the size of the chunks used to map the files bigger than n_max_view_size
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_mapping_sizes(size_t n_max_view_size, size_t n_chunk_size){
+          max_view_size = n_max_view_size;
+          chunk_size = n_chunk_size > 0 ? n_chunk_size : 1;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will choose if load_file uses a binary cache of the files (check openDDL_cache.h)
+        /// @param enable is true to use the cache (name.ddlc, next to the file)
+        ///   The cache is used only if the size, the time of modification and the hash of the file are the ones saved
+        ///   in it, if not (or if there is no cache) the file is lexed and the cache is written again.
+        ///   It's not used with a handler or a schema (set_typed_geometry), their documents are not complete.
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_cache(bool enable){
+          use_cache = enable;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will choose if the scenes converted by process_resources are saved and loaded (check openGEX_scene.h)
+        /// @param enable is true to use the converted scene (name.gexc, next to the file)
+        ///   When load_file finds a valid scene of the file, the document is not loaded: process_resources creates the
+        ///   resources from the scene. If the scene was converted with other options of process_resources, the document
+        ///   is loaded then, converted and the scene is saved again. It's not used with stream_file.
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_scene_cache(bool enable){
+          use_scene = enable;
         }
 
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief Loads the file with the "name" name of file. First it test if it exists
         /// @param name is a constant pointer to a character (it will be the address of the file to open)
         /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ///   The file is mapped in memory and read in place (in chunks if it's bigger than max_view_size).
+        ///   If it cannot be mapped it's read with app_utils::get_url
+        ///   With set_cache the document is loaded from the binary cache of the file, if it's valid
+        ///   With set_scene_cache the document is not loaded if the file has a valid converted scene
         ////////////////////////////////////////////////////////////////////////////////
         bool load_file(const char * name){
-          app_utils::get_url(buffer, name);
-          //Process the file (lexer) (return false if there was any problem)
-          printf("Starting the lexer process\n");
-          if (!lexer.lexer_file(buffer)){
+          buffer.reset();
+          cache_map.close();
+          close_scene();
+          scene_file.reset();
+          document_loaded = true;
+          openDDL_cache_source source;
+          bool scene = use_scene && lexer.get_handler() == NULL;
+          bool has_source = (scene || (use_cache && lexer.can_cache())) && get_source_info(name, source);
+          if (scene && has_source){
+            scene_file.resize((unsigned int)strlen(name) + 1);
+            memcpy(scene_file.data(), name, scene_file.size());
+            scene_source = source;
+            dynarray<char> scene_name;
+            get_cache_name(name, ".gexc", scene_name);
+            if (map_scene(scene_name.data(), source)){
+              printf("The converted scene %s is valid, the document is not loaded\n", scene_name.data());
+              document_loaded = false;
+              return true;
+            }
+          }
+          return load_document(name, source, has_source);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Loads an openGEX file that is already in memory, the characters are read in place (not copied)
+        /// @param data is the first character of the openGEX file
+        /// @param size is the number of characters
+        /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ////////////////////////////////////////////////////////////////////////////////
+        bool load_memory(const uint8_t * data, size_t size){
+          file_map.close();
+          cache_map.close();
+          close_scene();
+          scene_file.reset();
+          document_loaded = true;
+          buffer.reset();
+          return lexer_characters(data, size);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Loads an openGEX file that arrives in pieces (a pipe, the standard input, a decompressor...)
+        /// @param file is the stream to read, it's read till its end
+        /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ///   The structures are lexed as soon as they are complete, while the rest of the file is still arriving
+        ////////////////////////////////////////////////////////////////////////////////
+        bool load_stream(FILE * file){
+          enum { READ_SIZE = 1024 * 1024 };
+          file_map.close();
+          cache_map.close();
+          close_scene();
+          scene_file.reset();
+          document_loaded = true;
+          buffer.resize(READ_SIZE);
+          printf("Starting the lexer process (reading a stream)\n");
+          std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+          uint64_t total_size = 0;
+          bool no_error = true;
+          size_t size_read;
+          while (no_error && (size_read = fread(buffer.data(), 1, READ_SIZE, file)) > 0){
+            no_error = lexer.feed(buffer.data(), size_read);
+            total_size += size_read;
+          }
+          //finish() has to be called always, to leave the lexer ready for the next file
+          no_error = lexer.finish() && no_error && !ferror(file);
+          buffer.reset();
+          if (!no_error){
             printf("Error loading the openGEX file (openDDL process)!\n");
             return false;
           }
-          printf("The lexer DDL process has finished successfully!\n");
+          print_lexer_stats(start, total_size);
           return true;
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Reads the file sending its structures to a handler, instead of storing the document
+        /// @param name is a constant pointer to a character (it will be the address of the file to open)
+        /// @param handler will receive the events of the lexer (begin_structure, property, data_list_chunk and end_structure)
+        /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ///   Only one structure of the top level is in memory at a time, so there is nothing to process after this
+        ////////////////////////////////////////////////////////////////////////////////
+        bool stream_file(const char * name, openDDL_handler * handler){
+          lexer.set_handler(handler);
+          bool no_error = load_file(name);
+          lexer.set_handler(NULL);
+          return no_error;
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         /// @brief Process the resources of the file previously processed with the openDDL_lexer
         /// @param dict is a constant pointer to a character (it will be the address of the file to open)
         /// @param skin_skeleton is a constant pointer to a character (it will be the address of the file to open)
         /// @return It will return true if everything went well and false if there was some problems while reading the file
+        ///   With set_scene_cache the resources are created from the converted scene of the file when it's valid, and
+        ///   if not, the scene converted now is saved
         ////////////////////////////////////////////////////////////////////////////////
         bool process_resources(resource_dict *dict, bool animation, bool skin_skeleton = false){
+          uint32_t flags = (animation ? openGEX_scene::FLAG_ANIMATION : 0) | (skin_skeleton ? openGEX_scene::FLAG_SKIN_SKELETON : 0) |
+            (lexer.get_instancing() ? openGEX_scene::FLAG_INSTANCING : 0) | (lexer.get_mesh_optimization() ? openGEX_scene::FLAG_OPTIMIZATION : 0);
+          if (lexer.get_vertex_welding() == openGEX_vertex_welder::WELD_EXACT)
+            flags |= openGEX_scene::FLAG_WELD_EXACT;
+          else if (lexer.get_vertex_welding() == openGEX_vertex_welder::WELD_EPSILON)
+            flags |= openGEX_scene::FLAG_WELD_EPSILON;
+          if (lexer.get_vertex_format() == openGEX_vertex_format::VERTEX_COMPACT)
+            flags |= openGEX_scene::FLAG_VERTEX_COMPACT;
+          else if (lexer.get_vertex_format() == openGEX_vertex_format::VERTEX_SMALL)
+            flags |= openGEX_scene::FLAG_VERTEX_SMALL;
+          if (scene_header != NULL && scene_header->flags == flags && scene_header->welding_epsilon == lexer.get_welding_epsilon()){
+            std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+            if (lexer.get_scene().replay(dict, *scene_header)){
+              double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+              printf("The resources were created from the converted scene in %f seconds\n", seconds);
+              return true;
+            }
+          }
+          //The scene is going to be written again, so it cannot be mapped
+          close_scene();
+          if (!document_loaded){
+            if (!load_document(scene_file.data(), scene_source, true))
+              return false;
+            document_loaded = true;
+          }
+          bool record = scene_file.size() > 0;
           printf("And now start the openGEX process...\n");
-          if (!lexer.openGEX_data(dict, animation, skin_skeleton)){
+          lexer.get_scene().set_recording(record);
+          bool no_error = lexer.openGEX_data(dict, animation, skin_skeleton);
+          lexer.get_scene().set_recording(false);
+          if (no_error && record)
+            save_scene(flags);
+          lexer.get_scene().reset();
+          if (!no_error){
             printf("Error loading the openGEX file (openGEX process)!\n");
             return false;
           }
@@ -0,0 +1,481 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openGEX_model.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the typed model of the geometry of an openGEX document
+///
+///   The GeometryObjects are most of the characters of the files (the vertices and the indices of the meshes).
+///   When the model is the schema of the lexer (check openDDL_schema), their content is not stored in the tree:
+///   every Mesh is read straight into a record, with the vertices already interleaved as mesh::vertex and the
+///   indices as uint32_t, so there are no data lists or literals in between. The GeometryObject stays in the tree
+///   with its name and properties (so the ObjectRefs find it), and the substructures the model does not know
+///   (the Skin) are stored as usual and kept in the record. The rest of the document is the usual tree.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENGEX_MODEL_INCLUDED
+#define OPENGEX_MODEL_INCLUDED
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This struct contains an IndexArray read by the model
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openGEX_index_record{
+        // The index of the material of the mesh_instance that uses these indices (property material)
+        unsigned int material_index;
+        dynarray<uint32_t> indices;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This struct contains a Mesh read by the model
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openGEX_mesh_record{
+        int lod;
+        uint16_t primitive;
+        // The vertices with their final layout (position, normal and uv), the VertexArrays are written into their column
+        dynarray<mesh::vertex> vertices;
+        // The number of vertices of the last VertexArray (like the converter of the tree does)
+        int num_vertexes;
+        int num_vertex_arrays;
+        // Which columns of the vertices were found
+        bool position;
+        bool normal;
+        bool texcoord;
+        dynarray<openGEX_index_record *> index_arrays;
+        // The Skin of the mesh, it's stored in the document as usual (NULL if there is no Skin)
+        openDDL_identifier_structure * skin;
+        bool no_error;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This struct contains the content of a GeometryObject read by the model
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openGEX_geometry_record{
+        // The GeometryObject in the tree (with its name and properties, but without substructures)
+        openDDL_identifier_structure * structure;
+        dynarray<openGEX_mesh_record *> meshes;
+        bool no_error;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class reads the GeometryObjects of the document into records (it's the schema of the lexer)
+  ///   The errors are printed while reading, and the records with errors are marked (no_error), the lexer goes on
+  ////////////////////////////////////////////////////////////////////////////////
+      class openGEX_model : public openDDL_schema{
+        enum { RECORD = 0, MESH = 1, VERTEX_ARRAY = 2, INDEX_ARRAY = 3, DATA = 4 };
+
+        // This is one of the structures being read (the structures inside the record are read as a stack)
+        struct frame{
+          int kind;
+          // The attrib of a VertexArray (position = 0, normal = 1, texcoord = 2, tangent = 3, bitangent = 4, color = 5)
+          int attrib;
+          // The number of substructures of a VertexArray or an IndexArray (it has to be 1)
+          int num_substructures;
+          // The size of the subarrays of the data (-1 if it's not a data array list), and the elements already read
+          int array_size;
+          size_t num_elements;
+          bool no_error;
+        };
+
+        dynarray<frame> frames;
+        // All the records of the document (in order), and the records of the GeometryObjects with a name
+        dynarray<openGEX_geometry_record *> records;
+        openDDL_atom_map<openGEX_geometry_record *> named_records;
+        openGEX_geometry_record * current_record;
+        openGEX_mesh_record * current_mesh;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will compare a string of the document with a word
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool is_word(const char * word, const openDDL_data_literal &literal, int size){
+          return literal.value_type == value_type_DDL::STRING && (int)strlen(word) == size && memcmp(word, literal.value.string_, size) == 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will mark the current mesh and record as wrong (the error is already printed)
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_error(){
+          if (current_mesh != NULL)
+            current_mesh->no_error = false;
+          current_record->no_error = false;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will read the properties of a Mesh (lod and primitive)
+        ////////////////////////////////////////////////////////////////////////////////
+        void mesh_property(int identifier, const openDDL_data_literal &literal){
+          if (identifier == gex_ident::prop_lod)
+            current_mesh->lod = literal.value.u_integer_literal_;
+          else if (identifier == gex_ident::prop_primitive){
+            int size = literal.size_string_;
+            if (is_word("points", literal, size)) current_mesh->primitive = GL_POINTS;
+            else if (is_word("lines", literal, size)) current_mesh->primitive = GL_LINES;
+            else if (is_word("quads", literal, size)) current_mesh->primitive = GL_QUADS;
+            else if (is_word("line_strip", literal, size)) current_mesh->primitive = GL_LINE_STRIP;
+            else if (is_word("triangles", literal, size)) current_mesh->primitive = GL_TRIANGLES;
+            else if (is_word("triangle_strip", literal, size)) current_mesh->primitive = GL_TRIANGLE_STRIP;
+            else{
+              printf("(((ERROR! The property primitive has a wrong content!)))\n");
+              set_error();
+            }
+          }
+          else{
+            printf("(((ERROR: Property %i non valid!)))\n", identifier);
+            set_error();
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will read the properties of a VertexArray (attrib and morph)
+        ////////////////////////////////////////////////////////////////////////////////
+        void vertex_array_property(frame &vertex_array, int identifier, const openDDL_data_literal &literal){
+          if (identifier == gex_ident::prop_attrib){
+            int size = literal.size_string_;
+            //The [0] or [1] at the end is the index of the attrib
+            if (literal.value_type == value_type_DDL::STRING && size > 3 && literal.value.string_[size - 1] == ']')
+              size -= 3;
+            if (is_word("position", literal, size)) vertex_array.attrib = 0;
+            else if (is_word("normal", literal, size)) vertex_array.attrib = 1;
+            else if (is_word("texcoord", literal, size)) vertex_array.attrib = 2;
+            else if (is_word("tangent", literal, size)) vertex_array.attrib = 3;
+            else if (is_word("bitangent", literal, size)) vertex_array.attrib = 4;
+            else if (is_word("color", literal, size)) vertex_array.attrib = 5;
+            else{
+              printf("(((ERRROR!! This is not a valid value for attrib)))\n");
+              set_error();
+            }
+          }
+          else if (identifier != gex_ident::prop_morph){
+            printf("(((ERROR: This cannot be a property of this structure!)))\n");
+            set_error();
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will read the properties of an IndexArray (material, restart and front)
+        ////////////////////////////////////////////////////////////////////////////////
+        void index_array_property(int identifier, const openDDL_data_literal &literal){
+          if (identifier == gex_ident::prop_material)
+            current_mesh->index_arrays[current_mesh->index_arrays.size() - 1]->material_index = (unsigned int)literal.value.float_;
+          else if (identifier == gex_ident::prop_front){
+            if (!is_word("cw", literal, literal.size_string_) && !is_word("ccw", literal, literal.size_string_)){
+              printf("(((ERRROR: The string in the property front is wrong!)))\n");
+              set_error();
+            }
+          }
+          else if (identifier != gex_ident::prop_restart){
+            printf("(((ERROR: This cannot be a property of this structure!)))\n");
+            set_error();
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will write some floats of a VertexArray in their column of the vertices
+        /// @param  vertex_array  The frame of the VertexArray
+        /// @param  values  The floats, they go after the ones already read
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_vertex_values(frame &vertex_array, openDDL_span<float> values){
+          //The number of floats of each vertex, and where they go in the mesh::vertex (pos, normal and uv are 8 floats)
+          int components = 0, offset = 0;
+          if (vertex_array.array_size > 1){
+            if (vertex_array.array_size == 2 && vertex_array.attrib == 2)
+              components = 2, offset = 6;
+            else if (vertex_array.array_size == 3 && vertex_array.attrib <= 1)
+              components = 3, offset = vertex_array.attrib * 3;
+          }
+          else if (vertex_array.attrib <= 1)
+            components = 3, offset = vertex_array.attrib * 3;
+          else if (vertex_array.attrib == 2)
+            components = 2, offset = 6;
+          size_t first = vertex_array.num_elements;
+          vertex_array.num_elements += values.size();
+          if (components == 0)
+            return;
+          size_t num_vertices = (vertex_array.num_elements + components - 1) / components;
+          if (current_mesh->vertices.size() < num_vertices)
+            current_mesh->vertices.resize((unsigned int)num_vertices);
+          float * vertices = (float *)current_mesh->vertices.data();
+          for (size_t i = 0; i < values.size(); ++i){
+            size_t element = first + i;
+            vertices[(element / components) * 8 + offset + element % components] = values[i];
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will finish a VertexArray, giving the number of vertices to the mesh
+        ////////////////////////////////////////////////////////////////////////////////
+        void end_vertex_array(frame &vertex_array){
+          if (vertex_array.num_substructures != 1){
+            printf("(((ERROR! The VertexArray has to have a substructure, only one, but at least one!)))\n");
+            set_error();
+            return;
+          }
+          if (!vertex_array.no_error)
+            return;
+          if (vertex_array.array_size > 1){
+            current_mesh->num_vertexes = (int)(vertex_array.num_elements / vertex_array.array_size);
+            if (vertex_array.array_size >= 4)
+              printf("(((ERROR! This case has not yet been developed!)))\n");
+            else if (vertex_array.array_size == 3 && vertex_array.attrib == 2){
+              printf("(((ERROR! There is some problem with the amount of elements in the VertexArray...)))\n");
+              set_error();
+            }
+          }
+          else if (vertex_array.attrib <= 1)
+            current_mesh->num_vertexes = (int)(vertex_array.num_elements / 3);
+          else if (vertex_array.attrib == 2)
+            current_mesh->num_vertexes = (int)(vertex_array.num_elements / 2);
+          if (vertex_array.attrib == 0)
+            current_mesh->position = true;
+          else if (vertex_array.attrib == 1)
+            current_mesh->normal = true;
+          else if (vertex_array.attrib == 2)
+            current_mesh->texcoord = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create the record of a new Mesh
+        ////////////////////////////////////////////////////////////////////////////////
+        void begin_mesh(){
+          current_mesh = new openGEX_mesh_record;
+          current_mesh->lod = 0;
+          current_mesh->primitive = GL_TRIANGLES;
+          current_mesh->num_vertexes = 0;
+          current_mesh->num_vertex_arrays = 0;
+          current_mesh->position = false;
+          current_mesh->normal = false;
+          current_mesh->texcoord = false;
+          current_mesh->skin = NULL;
+          current_mesh->no_error = true;
+          current_record->meshes.push_back(current_mesh);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a new frame to the stack
+        ////////////////////////////////////////////////////////////////////////////////
+        void push_frame(int kind){
+          frame new_frame;
+          new_frame.kind = kind;
+          new_frame.attrib = 0;
+          new_frame.num_substructures = 0;
+          new_frame.array_size = -1;
+          new_frame.num_elements = 0;
+          new_frame.no_error = true;
+          frames.push_back(new_frame);
+        }
+
+        // The records are owned by the model, so it cannot be copied
+        openGEX_model(const openGEX_model &);
+        openGEX_model &operator=(const openGEX_model &);
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the model, it's empty till a document is lexed with it
+        ////////////////////////////////////////////////////////////////////////////////
+        openGEX_model(){
+          current_record = NULL;
+          current_mesh = NULL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Destructor of the model, it frees the records
+        ////////////////////////////////////////////////////////////////////////////////
+        ~openGEX_model(){
+          release();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief The model reads the GeometryObjects, the Meshes inside them, and the VertexArrays and IndexArrays
+        ///   inside the Meshes (with their data). The rest (Skin...) is stored in the tree and given to generic_structure
+        ////////////////////////////////////////////////////////////////////////////////
+        bool accepts(structureType type_structure, int identifier){
+          if (frames.size() == 0)
+            return type_structure == IDENTIFIER_TYPE && identifier == gex_ident::id_GeometryObject;
+          switch (frames[frames.size() - 1].kind){
+          case RECORD:
+            return type_structure == IDENTIFIER_TYPE && identifier == gex_ident::id_Mesh;
+          case MESH:
+            return type_structure == IDENTIFIER_TYPE && (identifier == gex_ident::id_VertexArray || identifier == gex_ident::id_IndexArray);
+          case VERTEX_ARRAY:
+          case INDEX_ARRAY:
+            return type_structure == DATA_TYPE_TYPE;
+          default:
+            return false;
+          }
+        }
+
+        bool begin_record(openDDL_identifier_structure * structure){
+          current_record = new openGEX_geometry_record;
+          current_record->structure = structure;
+          current_record->no_error = true;
+          current_mesh = NULL;
+          records.push_back(current_record);
+          if (structure->get_nameID() >= 0)
+            named_records[structure->get_nameID()] = current_record;
+          push_frame(RECORD);
+          return true;
+        }
+
+        bool begin_structure(structureType type_structure, int identifier, const char * name, int array_size){
+          if (type_structure == DATA_TYPE_TYPE){
+            frame &array = frames[frames.size() - 1];
+            ++array.num_substructures;
+            array.array_size = array_size;
+            if (array.kind == VERTEX_ARRAY && identifier != ddl_token_enum::tok_float){
+              printf("(((ERROR! The VertexArray has to contain floats!)))\n");
+              array.no_error = false;
+              set_error();
+            }
+            push_frame(DATA);
+          }
+          else if (identifier == gex_ident::id_Mesh){
+            begin_mesh();
+            push_frame(MESH);
+          }
+          else if (identifier == gex_ident::id_VertexArray){
+            ++current_mesh->num_vertex_arrays;
+            push_frame(VERTEX_ARRAY);
+          }
+          else{ //IndexArray
+            openGEX_index_record * index_array = new openGEX_index_record;
+            index_array->material_index = 0;
+            current_mesh->index_arrays.push_back(index_array);
+            push_frame(INDEX_ARRAY);
+          }
+          return true;
+        }
+
+        bool property(int identifier, const openDDL_data_literal &literal){
+          frame &current = frames[frames.size() - 1];
+          if (current.kind == MESH)
+            mesh_property(identifier, literal);
+          else if (current.kind == VERTEX_ARRAY)
+            vertex_array_property(current, identifier, literal);
+          else if (current.kind == INDEX_ARRAY)
+            index_array_property(identifier, literal);
+          return true;
+        }
+
+        bool data_list_chunk(int type, openDDL_data_list &chunk){
+          frame &array = frames[frames.size() - 2];
+          if (!array.no_error)
+            return true;
+          if (array.kind == VERTEX_ARRAY)
+            add_vertex_values(array, chunk.get_span<float>());
+          else if (!chunk.is_numeric()){
+            printf("(((ERROR! The IndexArray has to contain integers!)))\n");
+            array.no_error = false;
+            set_error();
+          }
+          else{
+            //The indices are converted to uint32_t and copied after the ones already read
+            dynarray<uint32_t> &indices = current_mesh->index_arrays[current_mesh->index_arrays.size() - 1]->indices;
+            unsigned int first = indices.size();
+            indices.resize(first + (unsigned int)chunk.size());
+            chunk.get_values(indices.data() + first, 0, chunk.size());
+          }
+          return true;
+        }
+
+        bool end_structure(){
+          frame current = frames[frames.size() - 1];
+          frames.resize(frames.size() - 1);
+          if (current.kind == VERTEX_ARRAY)
+            end_vertex_array(current);
+          else if (current.kind == INDEX_ARRAY && current.num_substructures != 1){
+            printf("(((ERROR! The VertexArray has to have a substructure, only one, but at least one!)))\n");
+            set_error();
+          }
+          else if (current.kind == MESH){
+            if (current_mesh->num_vertex_arrays < 1){
+              printf("(((ERROR: The structure Mesh has to have one VertexArray substructure)))\n");
+              set_error();
+            }
+            current_mesh = NULL;
+          }
+          return true;
+        }
+
+        bool generic_structure(openDDL_structure * structure){
+          frame &current = frames[frames.size() - 1];
+          bool skin = structure->get_type_structure() == IDENTIFIER_TYPE && ((openDDL_identifier_structure *)structure)->get_identifierID() == gex_ident::id_Skin;
+          if (current.kind == MESH && skin && current_mesh->skin == NULL)
+            current_mesh->skin = (openDDL_identifier_structure *)structure;
+          else if (current.kind == MESH && skin){
+            printf("(((ERROR: The structure Mesh can only have one Skin substructure)))\n");
+            set_error();
+          }
+          else if (current.kind == MESH){
+            printf("(((ERROR: The structure Mesh can only have as substructure a Mesh)))\n");
+            set_error();
+          }
+          else if (current.kind == RECORD){
+            printf("(((ERROR: The structure GeometricObject can only have as substructure a Mesh)))\n");
+            set_error();
+          }
+          else //The VertexArrays and IndexArrays only have one data structure
+            ++current.num_substructures;
+          return true;
+        }
+
+        bool end_record(){
+          frames.resize(0);
+          current_record = NULL;
+          current_mesh = NULL;
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will free all the records of the document
+        ////////////////////////////////////////////////////////////////////////////////
+        void release(){
+          for (unsigned int i = 0; i < records.size(); ++i){
+            for (unsigned int j = 0; j < records[i]->meshes.size(); ++j){
+              openGEX_mesh_record * mesh_record = records[i]->meshes[j];
+              for (unsigned int k = 0; k < mesh_record->index_arrays.size(); ++k)
+                delete mesh_record->index_arrays[k];
+              delete mesh_record;
+            }
+            delete records[i];
+          }
+          records.reset();
+          named_records.reset();
+          frames.reset();
+          current_record = NULL;
+          current_mesh = NULL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the record with the content of a GeometryObject of the tree
+        /// @param  structure  The GeometryObject
+        /// @return The record, or NULL if its content was not read by the model (then it's in the tree)
+        ////////////////////////////////////////////////////////////////////////////////
+        openGEX_geometry_record * get_record(openDDL_identifier_structure * structure){
+          int nameID = structure->get_nameID();
+          if (named_records.contains(nameID) && named_records[nameID]->structure == structure)
+            return named_records[nameID];
+          for (unsigned int i = 0; i < records.size(); ++i){
+            if (records[i]->structure == structure)
+              return records[i];
+          }
+          return NULL;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the number of records of the document, and each one of them (in the order of the file)
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int get_number_records(){
+          return records.size();
+        }
+
+        openGEX_geometry_record * get_record(unsigned int index){
+          return records[index];
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,471 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openGEX_optimizer.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the optimization of the meshes after they are read (with set_mesh_optimization of openGEX_parser)
+///
+///   The exporters write the triangles in any order, so the meshes are drawn as they come. With the optimization,
+///   the triangles of every IndexArray go through these steps before the mesh is created:
+///   - The degenerate triangles (two equal indices, or two vertices in the same position) are removed
+///   - The triangles are reordered for the vertex cache of the GPU (Tipsify, by Sander, Nehab and Barczak)
+///   - The triangles are split in clusters that can be moved without losing much of the cache, and the clusters
+///     are sorted from the outside of the mesh to the inside, so less pixels are drawn twice (overdraw)
+///   - The vertices are reordered in the order the triangles use them (for the fetch), and the indices remapped.
+///     All the IndexArrays of a Mesh share its vertices, so this is done once for all of them.
+///   The ACMR (cache misses per triangle) and the ATVR (cache misses per vertex) of a FIFO cache are measured
+///   before and after, so the gain can be checked for every mesh. Only the triangles are optimized.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENGEX_OPTIMIZER_INCLUDED
+#define OPENGEX_OPTIMIZER_INCLUDED
+
+#include <algorithm>
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is the efficiency of the vertex cache with some triangles (check openGEX_mesh_optimizer::measure)
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openGEX_cache_stats{
+        unsigned int num_triangles;
+        unsigned int num_vertices;
+        unsigned int num_misses;
+
+        float get_acmr() const{
+          return num_triangles > 0 ? (float)num_misses / num_triangles : 0.0f;
+        }
+
+        float get_atvr() const{
+          return num_vertices > 0 ? (float)num_misses / num_vertices : 0.0f;
+        }
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class optimizes the vertices and the IndexArrays of a Mesh (check the beginning of the file)
+  ///   The vertices and indices optimized are kept in it till the next mesh is optimized, so the buffers are reused
+  ////////////////////////////////////////////////////////////////////////////////
+      class openGEX_mesh_optimizer{
+      public:
+        // The size of the FIFO cache used by Tipsify and by the stats, and how much the ACMR of a cluster can be
+        // worse than the one of the whole sequence (in percentage) when the sequence is split for the overdraw
+        enum { CACHE_SIZE = 16, CLUSTER_THRESHOLD = 105 };
+
+      private:
+        // The mesh optimized
+        dynarray<mesh::vertex> vertices;
+        dynarray<uint32_t> indices;
+        // Where the indices of each IndexArray start in indices (and one more with the end)
+        dynarray<unsigned int> index_offsets;
+        openGEX_cache_stats stats_before;
+        openGEX_cache_stats stats_after;
+        unsigned int num_degenerates;
+
+        // Temporary arrays of the steps (members, to reuse their memory)
+        dynarray<uint32_t> triangles;
+        dynarray<unsigned int> adjacency_offsets;
+        dynarray<unsigned int> adjacency;
+        dynarray<int> live_triangles;
+        dynarray<unsigned int> cache_time;
+        dynarray<uint8_t> emitted;
+        dynarray<uint32_t> dead_end;
+        dynarray<uint32_t> candidates;
+        dynarray<unsigned int> hard_clusters;
+        dynarray<unsigned int> clusters;
+        dynarray<float> cluster_keys;
+        dynarray<unsigned int> cluster_order;
+        dynarray<uint32_t> remap;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This is used to sort the clusters by their key (the biggest first)
+        ////////////////////////////////////////////////////////////////////////////////
+        struct compare_clusters{
+          const float * keys;
+          bool operator()(unsigned int a, unsigned int b) const{
+            return keys[a] > keys[b] || (keys[a] == keys[b] && a < b);
+          }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the position of a vertex (it's the first attribute of mesh::vertex)
+        ////////////////////////////////////////////////////////////////////////////////
+        static const float * get_position(const mesh::vertex * mesh_vertices, uint32_t index){
+          return (const float *)(mesh_vertices + index);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if a triangle has no area (two equal indices, or two vertices in the same position)
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool is_degenerate(const mesh::vertex * mesh_vertices, const uint32_t * triangle){
+          if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+            return true;
+          for (int i = 0; i < 3; ++i){
+            if (memcmp(get_position(mesh_vertices, triangle[i]), get_position(mesh_vertices, triangle[(i + 1) % 3]), sizeof(float) * 3) == 0)
+              return true;
+          }
+          return false;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will simulate a FIFO cache with some triangles
+        /// @param  cache  The time when each vertex entered the cache, they are in it while time - cache[v] <= CACHE_SIZE
+        ///   (all of them have to be 0 the first time, or time has to be bigger than CACHE_SIZE to start with it empty)
+        ///   It's the same cache of CACHE_SIZE vertices that tipsify optimizes for
+        /// @param  time  The number of misses till now, it's incremented with the misses of these triangles
+        /// @return The number of misses of these triangles
+        ////////////////////////////////////////////////////////////////////////////////
+        static unsigned int simulate_cache(const uint32_t * triangle_indices, unsigned int num_indices, dynarray<unsigned int> &cache, unsigned int &time){
+          unsigned int misses = 0;
+          for (unsigned int i = 0; i < num_indices; ++i){
+            uint32_t v = triangle_indices[i];
+            if (time - cache[v] > CACHE_SIZE){
+              cache[v] = time;
+              ++time;
+              ++misses;
+            }
+          }
+          return misses;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the vertex where Tipsify continues when the current fan has no more triangles
+        /// @param  cursor  The last vertex checked in order (the vertices before it have no live triangles)
+        /// @return The vertex, or -1 if all the triangles are emitted
+        ////////////////////////////////////////////////////////////////////////////////
+        int skip_dead_end(unsigned int &cursor, unsigned int num_vertexes){
+          while (dead_end.size() > 0){
+            uint32_t v = dead_end[dead_end.size() - 1];
+            dead_end.pop_back();
+            if (live_triangles[v] > 0)
+              return (int)v;
+          }
+          for (; cursor < num_vertexes; ++cursor){
+            if (live_triangles[cursor] > 0)
+              return (int)cursor;
+          }
+          return -1;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will reorder the triangles for the vertex cache (Tipsify)
+        /// @param  source  The triangles (3 indices each one), and the number of triangles
+        /// @param  output  The triangles reordered (it can't be source)
+        ///   The indices in hard_clusters are the triangles where the sequence jumped to another part of the mesh
+        ////////////////////////////////////////////////////////////////////////////////
+        void tipsify(const uint32_t * source, unsigned int num_triangles, unsigned int num_vertexes, uint32_t * output){
+          //The triangles of every vertex
+          adjacency_offsets.resize(num_vertexes + 1);
+          live_triangles.resize(num_vertexes);
+          cache_time.resize(num_vertexes);
+          for (unsigned int v = 0; v < num_vertexes; ++v){
+            live_triangles[v] = 0;
+            cache_time[v] = 0;
+          }
+          for (unsigned int i = 0; i < num_triangles * 3; ++i)
+            ++live_triangles[source[i]];
+          unsigned int offset = 0;
+          for (unsigned int v = 0; v < num_vertexes; ++v){
+            adjacency_offsets[v] = offset;
+            offset += live_triangles[v];
+          }
+          adjacency_offsets[num_vertexes] = offset;
+          adjacency.resize(num_triangles * 3);
+          for (unsigned int i = 0; i < num_triangles * 3; ++i)
+            adjacency[adjacency_offsets[source[i]]++] = i / 3;
+          for (unsigned int v = 0; v < num_vertexes; ++v)
+            adjacency_offsets[v] -= live_triangles[v];
+          emitted.resize(num_triangles);
+          for (unsigned int t = 0; t < num_triangles; ++t)
+            emitted[t] = 0;
+          dead_end.reset();
+          hard_clusters.reset();
+          //The time starts after the size of the cache, so all the vertices are out of it
+          unsigned int time = CACHE_SIZE + 1;
+          unsigned int cursor = 0;
+          unsigned int num_output = 0;
+          int fan = skip_dead_end(cursor, num_vertexes);
+          bool jumped = true;
+          while (fan >= 0){
+            if (jumped)
+              hard_clusters.push_back(num_output);
+            //Emit all the triangles of the fan that are not emitted yet
+            candidates.reset();
+            for (unsigned int a = adjacency_offsets[fan]; a < adjacency_offsets[fan + 1]; ++a){
+              unsigned int t = adjacency[a];
+              if (emitted[t])
+                continue;
+              for (int k = 0; k < 3; ++k){
+                uint32_t v = source[t * 3 + k];
+                output[num_output * 3 + k] = v;
+                dead_end.push_back(v);
+                candidates.push_back(v);
+                --live_triangles[v];
+                if (time - cache_time[v] > CACHE_SIZE){
+                  cache_time[v] = time;
+                  ++time;
+                }
+              }
+              emitted[t] = 1;
+              ++num_output;
+            }
+            //The next fan is the vertex of this one that will still be in the cache, and has more triangles
+            int next = -1;
+            int best_priority = -1;
+            for (unsigned int c = 0; c < candidates.size(); ++c){
+              uint32_t v = candidates[c];
+              if (live_triangles[v] <= 0)
+                continue;
+              int priority = 0;
+              if (time - cache_time[v] + 2 * live_triangles[v] <= CACHE_SIZE)
+                priority = (int)(time - cache_time[v]);
+              if (priority > best_priority){
+                best_priority = priority;
+                next = (int)v;
+              }
+            }
+            jumped = next < 0;
+            fan = jumped ? skip_dead_end(cursor, num_vertexes) : next;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will split the sequence of Tipsify in clusters, and sort them to reduce the overdraw
+        /// @param  source  The triangles from tipsify (with their hard_clusters)
+        /// @param  output  The triangles with the clusters sorted (it can't be source)
+        ///   A cluster ends when, starting with an empty cache, its ACMR is already near the one of the sequence: then
+        ///   it can be drawn after any other cluster. The clusters facing outwards (from the center of the mesh) are
+        ///   drawn first, they are the ones most likely to hide the others.
+        ////////////////////////////////////////////////////////////////////////////////
+        void sort_clusters(const uint32_t * source, unsigned int num_triangles, const mesh::vertex * mesh_vertices, uint32_t * output){
+          clusters.reset();
+          for (unsigned int i = 0; i < num_triangles * 3; ++i)
+            cache_time[source[i]] = 0;
+          unsigned int time = CACHE_SIZE + 1;
+          for (unsigned int h = 0; h < hard_clusters.size(); ++h){
+            unsigned int first = hard_clusters[h];
+            unsigned int end = h + 1 < hard_clusters.size() ? hard_clusters[h + 1] : num_triangles;
+            //The ACMR of the whole hard cluster
+            time += CACHE_SIZE + 1;
+            unsigned int hard_misses = simulate_cache(source + first * 3, (end - first) * 3, cache_time, time);
+            //And the soft clusters inside it, each one starting with the cache empty
+            time += CACHE_SIZE + 1;
+            clusters.push_back(first);
+            unsigned int cluster_triangles = 0;
+            unsigned int cluster_misses = 0;
+            for (unsigned int t = first; t < end; ++t){
+              cluster_misses += simulate_cache(source + t * 3, 3, cache_time, time);
+              ++cluster_triangles;
+              if (t + 1 < end && (uint64_t)cluster_misses * (end - first) * 100 <= (uint64_t)cluster_triangles * hard_misses * CLUSTER_THRESHOLD){
+                clusters.push_back(t + 1);
+                time += CACHE_SIZE + 1;
+                cluster_triangles = 0;
+                cluster_misses = 0;
+              }
+            }
+          }
+          unsigned int num_clusters = clusters.size();
+          //The center of the mesh (of the triangles, weighted by their area)
+          float mesh_center[3] = { 0, 0, 0 };
+          float mesh_area = 0;
+          cluster_keys.resize(num_clusters * 7);
+          for (unsigned int c = 0; c < num_clusters; ++c){
+            unsigned int end = c + 1 < num_clusters ? clusters[c + 1] : num_triangles;
+            float * center = &cluster_keys[num_clusters + c * 6];
+            float * normal = center + 3;
+            float area = 0;
+            for (int k = 0; k < 3; ++k)
+              center[k] = normal[k] = 0;
+            for (unsigned int t = clusters[c]; t < end; ++t){
+              const float * p0 = get_position(mesh_vertices, source[t * 3]);
+              const float * p1 = get_position(mesh_vertices, source[t * 3 + 1]);
+              const float * p2 = get_position(mesh_vertices, source[t * 3 + 2]);
+              float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+              float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+              float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+              float triangle_area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+              for (int k = 0; k < 3; ++k){
+                center[k] += (p0[k] + p1[k] + p2[k]) * triangle_area / 3.0f;
+                normal[k] += n[k];
+              }
+              area += triangle_area;
+            }
+            for (int k = 0; k < 3; ++k)
+              mesh_center[k] += center[k];
+            mesh_area += area;
+            if (area > 0){
+              for (int k = 0; k < 3; ++k)
+                center[k] /= area;
+            }
+          }
+          if (mesh_area > 0){
+            for (int k = 0; k < 3; ++k)
+              mesh_center[k] /= mesh_area;
+          }
+          //The key is how much the cluster faces outwards (the distance to the center, along its normal)
+          cluster_order.resize(num_clusters);
+          for (unsigned int c = 0; c < num_clusters; ++c){
+            const float * center = &cluster_keys[num_clusters + c * 6];
+            const float * normal = center + 3;
+            float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            float key = 0;
+            if (length > 0){
+              for (int k = 0; k < 3; ++k)
+                key += (center[k] - mesh_center[k]) * normal[k] / length;
+            }
+            cluster_keys[c] = key;
+            cluster_order[c] = c;
+          }
+          compare_clusters compare;
+          compare.keys = cluster_keys.data();
+          std::sort(cluster_order.data(), cluster_order.data() + num_clusters, compare);
+          unsigned int num_output = 0;
+          for (unsigned int i = 0; i < num_clusters; ++i){
+            unsigned int c = cluster_order[i];
+            unsigned int end = c + 1 < num_clusters ? clusters[c + 1] : num_triangles;
+            memcpy(output + num_output * 3, source + clusters[c] * 3, sizeof(uint32_t) * 3 * (end - clusters[c]));
+            num_output += end - clusters[c];
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will measure the cache with the IndexArrays (the cache is empty at the beginning of each one)
+        ////////////////////////////////////////////////////////////////////////////////
+        void measure(openGEX_cache_stats &stats, const dynarray<uint32_t *> &index_arrays, const dynarray<int> &num_indices, unsigned int num_vertexes){
+          stats.num_triangles = 0;
+          stats.num_vertices = 0;
+          stats.num_misses = 0;
+          cache_time.resize(num_vertexes);
+          emitted.resize(num_vertexes);
+          for (unsigned int v = 0; v < num_vertexes; ++v){
+            cache_time[v] = 0;
+            emitted[v] = 0;
+          }
+          unsigned int time = CACHE_SIZE + 1;
+          for (unsigned int i = 0; i < index_arrays.size(); ++i){
+            time += CACHE_SIZE + 1;
+            stats.num_misses += simulate_cache(index_arrays[i], num_indices[i], cache_time, time);
+            stats.num_triangles += num_indices[i] / 3;
+            for (int j = 0; j < num_indices[i]; ++j){
+              if (!emitted[index_arrays[i][j]]){
+                emitted[index_arrays[i][j]] = 1;
+                ++stats.num_vertices;
+              }
+            }
+          }
+        }
+
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the optimizer
+        ////////////////////////////////////////////////////////////////////////////////
+        openGEX_mesh_optimizer(){
+          num_degenerates = 0;
+          memset(&stats_before, 0, sizeof(stats_before));
+          memset(&stats_after, 0, sizeof(stats_after));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will optimize the triangles and the vertices of a Mesh
+        /// @param  mesh_vertices  The vertices of the Mesh, and the number of them (it returns the new ones)
+        /// @param  index_arrays  The indices of each IndexArray (it returns the new ones), they have to be triangles
+        /// @param  num_indices  The number of indices of each IndexArray (it returns the new ones)
+        /// @return False if the Mesh can't be optimized (an index out of the vertices, or an incomplete triangle),
+        ///   then nothing is changed. The new vertices and indices are valid till the next optimize
+        ////////////////////////////////////////////////////////////////////////////////
+        bool optimize(mesh::vertex *&mesh_vertices, int &num_vertexes, dynarray<uint32_t *> &index_arrays, dynarray<int> &num_indices){
+          if (mesh_vertices == NULL || num_vertexes <= 0)
+            return false;
+          unsigned int num_arrays = index_arrays.size();
+          for (unsigned int i = 0; i < num_arrays; ++i){
+            if (num_indices[i] % 3 != 0 || (num_indices[i] > 0 && index_arrays[i] == NULL))
+              return false;
+            for (int j = 0; j < num_indices[i]; ++j){
+              if (index_arrays[i][j] >= (uint32_t)num_vertexes)
+                return false;
+            }
+          }
+          measure(stats_before, index_arrays, num_indices, num_vertexes);
+          //First the degenerate triangles are removed, and then every IndexArray is optimized for the cache and overdraw
+          unsigned int total_indices = 0;
+          for (unsigned int i = 0; i < num_arrays; ++i)
+            total_indices += num_indices[i];
+          indices.resize(total_indices);
+          index_offsets.resize(num_arrays + 1);
+          num_degenerates = 0;
+          unsigned int offset = 0;
+          for (unsigned int i = 0; i < num_arrays; ++i){
+            index_offsets[i] = offset;
+            triangles.resize(num_indices[i]);
+            unsigned int num_triangles = 0;
+            for (int j = 0; j < num_indices[i]; j += 3){
+              const uint32_t * triangle = index_arrays[i] + j;
+              if (is_degenerate(mesh_vertices, triangle)){
+                ++num_degenerates;
+                continue;
+              }
+              for (int k = 0; k < 3; ++k)
+                triangles[num_triangles * 3 + k] = triangle[k];
+              ++num_triangles;
+            }
+            if (num_triangles > 0){
+              tipsify(triangles.data(), num_triangles, num_vertexes, indices.data() + offset);
+              memcpy(triangles.data(), indices.data() + offset, sizeof(uint32_t) * 3 * num_triangles);
+              sort_clusters(triangles.data(), num_triangles, mesh_vertices, indices.data() + offset);
+            }
+            offset += num_triangles * 3;
+          }
+          index_offsets[num_arrays] = offset;
+          //Then the vertices are sorted in the order they are used, the ones not used are removed
+          remap.resize(num_vertexes);
+          for (int v = 0; v < num_vertexes; ++v)
+            remap[v] = ~(uint32_t)0;
+          uint32_t num_used = 0;
+          for (unsigned int i = 0; i < offset; ++i){
+            uint32_t v = indices[i];
+            if (remap[v] == ~(uint32_t)0)
+              remap[v] = num_used++;
+            indices[i] = remap[v];
+          }
+          vertices.resize(num_used);
+          for (int v = 0; v < num_vertexes; ++v){
+            if (remap[v] != ~(uint32_t)0)
+              vertices[remap[v]] = mesh_vertices[v];
+          }
+          //Nothing is left of a Mesh with only degenerate triangles, it keeps its vertices to have a valid mesh
+          if (num_used == 0)
+            return false;
+          mesh_vertices = vertices.data();
+          num_vertexes = (int)num_used;
+          for (unsigned int i = 0; i < num_arrays; ++i){
+            index_arrays[i] = indices.data() + index_offsets[i];
+            num_indices[i] = (int)(index_offsets[i + 1] - index_offsets[i]);
+          }
+          measure(stats_after, index_arrays, num_indices, num_vertexes);
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the stats of the cache of the last mesh optimized, before and after
+        ////////////////////////////////////////////////////////////////////////////////
+        const openGEX_cache_stats &get_stats_before() const{
+          return stats_before;
+        }
+
+        const openGEX_cache_stats &get_stats_after() const{
+          return stats_after;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the number of degenerate triangles removed from the last mesh optimized
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int get_num_degenerates() const{
+          return num_degenerates;
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
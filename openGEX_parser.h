@@ -15,6 +15,12 @@
 
 #include "openDDL_lexer.h"
 #include "openGEX_identifiers.h"
+#include "openGEX_model.h"
+#include "openGEX_vertex_format.h"
+#include "openGEX_instancing.h"
+#include "openGEX_welder.h"
+#include "openGEX_optimizer.h"
+#include "openGEX_scene.h"
 
 namespace octet
 {
@@ -48,6 +54,8 @@ namespace octet
       ////////////////////////////////////////////////////////////////////////////////
       struct ref_transform{
         atom_t ref;
+        // The structure of the transform, the targets of the Tracks are compared with it
+        openDDL_structure * structure;
         TYPE_TRANSFORM type;
         SUBTYPE_TRANSFORM subtype;
         mat4t matrix;
@@ -86,7 +94,8 @@ namespace octet
         ref<mesh_instance> ref_instance;
         ref<scene_node> node;
         atom_t name;
-        dynarray<char *> ref_materials;
+        // The atom of the name of each material (of the Material structure referenced), or -1 to use the default one
+        dynarray<int> ref_materials;
         dynarray<index_mesh> index_and_meshes;
       };
 
@@ -102,17 +111,19 @@ namespace octet
 
       typedef gex_ident::gex_ident_enum gex_ident_list;
       //This will be used to handle the references to meshes and materials (and more will be probably added)
-      dictionary<dynarray<ref<info_mesh_instance>>> info_meshes_from_objectRef;  //This contains all the info required for a mesh_instance, knowing the mesh
+      openDDL_atom_map<dynarray<ref<info_mesh_instance>>> info_meshes_from_objectRef;  //This contains all the info required for a mesh_instance, knowing the mesh
       //This is the list of materials!
-      dictionary<ref<material>> ref_materials;      
+      openDDL_atom_map<ref<material>> ref_materials;
       //from a materialRef (Material) gets which objectRef is using it
-      dictionary<dynarray<ref<mesh_instance>>> ref_materials_inv;             
+      openDDL_atom_map<dynarray<ref<mesh_instance>>> ref_materials_inv;
       //This will be used to handle the references to cameras
-      dictionary<dynarray<ref<info_camera_instance>>> info_cameras_from_objectRef;  //This contains all the info required for a mesh_instance, knowing the mesh
+      openDDL_atom_map<dynarray<ref<info_camera_instance>>> info_cameras_from_objectRef;  //This contains all the info required for a mesh_instance, knowing the mesh
+      //The instanced meshes of the document (they are updated at the end, when all the Materials are found)
+      dynarray<ref<openGEX_instanced_mesh>> document_instanced_meshes;
 
-      //This dictionary is indexed with the openDDL name, not the structure name! (CAUTION!!)
-      dictionary<ref<scene_node>> dict_nodes;
-      dictionary<ref<scene_node>> dict_bone_nodes;
+      //This dictionary is indexed with the atom of the openDDL name, not the structure name! (CAUTION!!)
+      openDDL_atom_map<ref<scene_node>> dict_nodes;
+      openDDL_atom_map<ref<scene_node>> dict_bone_nodes;
 
       //This is (a pointer to) the dictionary where everything will need to be stored! The octet dict! Be careful!
       resource_dict *dict;
@@ -120,6 +131,17 @@ namespace octet
       //This boolean will be used to check if the bones & skin & skeleton has to be processed
       bool check_skin_skeleton;
       bool check_animation;
+      //If it's true, the GeometryObjects used by more than one node are instanced (check openGEX_instancing.h)
+      bool use_instancing;
+      //The mode of the welding of the vertices (one of the enum of openGEX_vertex_welder), and its epsilon
+      int welding_mode;
+      float welding_epsilon;
+      openGEX_vertex_welder welder;
+      //If it's true, the triangles of the meshes are optimized by the optimizer (check openGEX_optimizer.h)
+      bool use_optimization;
+      openGEX_mesh_optimizer optimizer;
+      //The layout of the vertices of the meshes (one of the enum of openGEX_vertex_format)
+      int vertex_format;
 
       //Some values needed to process correctly the file
       //This are the values that are obtained by Metric structures and that define the measurement and orientation
@@ -129,15 +151,15 @@ namespace octet
       bool z_up_direction; //default value = true  (z), if false (y)
       //This will be used to be able to access to the currentStructure while working with the data_lists.
       openDDL_structure * currentStructure;
+      //This reads the GeometryObjects into records while lexing, when set_typed_geometry is enabled
+      openGEX_model model;
+      //This creates the resources of octet (and records them, to save the scene converted)
+      openGEX_scene scene;
 
       ////////////////////////////////////////////////////////////////////////////////
-      /// @brief This will initialize some structures of the lexer (dictionary of identifiers of openGEX)
+      /// @brief This will initialize some values of the parser (the identifiers of openGEX don't need it)
       ////////////////////////////////////////////////////////////////////////////////
       void init_gex(){
-        //Load the identifiers of openGEX in identifeirs_ dictionary
-        for (int i = gex_ident_list::id_Animation; i != gex_ident_list::ident_last; ++i){
-          add_identifier(gex_ident::ident_name(i).c_str(), i);
-        }
         //Set the default values of the Metric structures
         distance_multiplier = 1.0f;
         angle_multiplier = 1.0f;
@@ -145,6 +167,16 @@ namespace octet
         z_up_direction = true;
       }
 
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This function will find the identifiers of openGEX for the lexer (using its perfect hash)
+      /// @param  word  The first character of the word
+      /// @param  size  The size of the word
+      /// @return The identifier of openGEX (gex_ident_list), or -1 if the word is not an identifier
+      ////////////////////////////////////////////////////////////////////////////////
+      int find_identifier(const char * word, int size){
+        return gex_ident::find_ident(word, size);
+      }
+
       ////////////////////////////////////////////////////////////////////////////////
       /// @brief This function will translate from the char* to the proper GEX_ATTRIB
       /// @param  attrib  The attrib to be translated
@@ -213,9 +245,24 @@ namespace octet
         }
       }
 
-      //Aux function
-      char get_char_from_int(int number){
-        return number + 48;
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This is an aux function to obtain the name of the resource of an IndexArray after the first one
+      /// @param  new_name  It returns the name, ended with \0
+      /// @param  name  The name of the resource of the first IndexArray
+      /// @param  index  The index of the IndexArray, it's added after the name with a _ (name_1, name_2...)
+      ////////////////////////////////////////////////////////////////////////////////
+      static void get_indexed_name(dynarray<char> &new_name, const char * name, unsigned int index){
+        char digits[10];
+        int num_digits = 0;
+        for (unsigned int value = index; value > 0; value /= 10)
+          digits[num_digits++] = (char)('0' + value % 10);
+        unsigned int size = (unsigned int)strlen(name);
+        new_name.resize(size + num_digits + 2);
+        memcpy(new_name.data(), name, size);
+        new_name[size] = '_';
+        for (int i = 0; i < num_digits; ++i)
+          new_name[size + 1 + i] = digits[num_digits - 1 - i];
+        new_name[size + num_digits + 1] = '\0';
       }
 
       ////////////////////////////////////////////////////////////////////////////////
@@ -406,7 +453,7 @@ namespace octet
         if (tempID < 0)
           printf("(((ERROR)))\n");
         else{
-          if (DEBUGSTRUCTURE) printf("%s", ddl_token::token_name(tempID).c_str());
+          if (DEBUGSTRUCTURE) printf("%s", ddl_token::token_name(tempID));
           if (DEBUGSTRUCTURE) printf("\n");
         }
         //Check the name of the structure!
@@ -414,7 +461,7 @@ namespace octet
         if (tempID >= 0){
           if (DEBUGSTRUCTURE) printfNesting();
           if (DEBUGSTRUCTURE) printf("The name is ");
-          if (DEBUGSTRUCTURE) printf("%s", names_.get_key(tempID));
+          if (DEBUGSTRUCTURE) printf("%s", atoms.get_name(tempID));
           if (DEBUGSTRUCTURE) printf(" = %s", structure->get_name());
           if (DEBUGSTRUCTURE) printf("\n");
         }
@@ -436,13 +483,16 @@ namespace octet
           int sizeDataList;
           for (int i = 0; i < numLists; ++i){
             currentDataList = structure->get_data_list(i);
-            sizeDataList = currentDataList->data_list.size();
+            sizeDataList = (int)currentDataList->size();
             if(DEBUGDATA) printfNesting();
             if(DEBUGDATA) printf("Occurency %i with %i elements.\n", i+1, sizeDataList);
             for (int j = 0; j < sizeDataList; ++j){
               if (DEBUGDATA) printfNesting();
               if (DEBUGDATA) printf("\t");
-              if (DEBUGDATA) printfDDLliteral(*(currentDataList->data_list[j]));
+              if (DEBUGDATA){
+                if (currentDataList->is_numeric()) printf("%f", currentDataList->get_double(j));
+                else printfDDLliteral(*(currentDataList->get_literal(j)));
+              }
             }
             if (DEBUGDATA) printf("\n");
           }
@@ -467,7 +517,7 @@ namespace octet
         if (tempID < 0)
           printf("(((ERROR)))\n");
         else{
-          if (DEBUGSTRUCTURE) printf("%s", gex_ident::ident_name(tempID).c_str());
+          if (DEBUGSTRUCTURE) printf("%s", gex_ident::ident_name(tempID));
           if (DEBUGSTRUCTURE) printf("\n");
         }
         //Check the name of the structure!
@@ -494,7 +544,7 @@ namespace octet
             if (DEBUGSTRUCTURE) printfNesting();
             if (DEBUGSTRUCTURE) printf("Property <");
             tempID = current_property->identifierID;
-            if (DEBUGSTRUCTURE) printf("%s", identifiers_.get_key(tempID));
+            if (DEBUGSTRUCTURE) printf("%s", gex_ident::ident_name(tempID));
             if (DEBUGSTRUCTURE) printf("> with value <");
             if (DEBUGSTRUCTURE) printfDDLliteral(current_property->literal);
             if (DEBUGSTRUCTURE) printf(">\n");
@@ -532,8 +582,8 @@ namespace octet
           openDDL_properties *current_property;
           current_property = structure->get_property(0);
           //Check that the property is correct!
-          tempID = identifiers_.get_value(current_property->identifierID);
-          if (tempID != 43){ // 43 = key
+          tempID = current_property->identifierID;
+          if (tempID != gex_ident::prop_key){
             printf("(((ERROR: The property in Metric has to be key and it's %i)))\n",tempID);
             return false;
           }
@@ -550,8 +600,8 @@ namespace octet
                 data_structure = (openDDL_data_type_structure *)structure->get_substructure(0);
                 if (data_structure->get_type_structure() == 1 && data_structure->get_typeID() == 11){
                   // Obtain data
-                  char * value = data_structure->get_data_list(0)->data_list[0]->value.string_;
-                  int value_size = data_structure->get_data_list(0)->data_list[0]->size_string_;
+                  char * value = data_structure->get_data_list(0)->get_string(0);
+                  int value_size = data_structure->get_data_list(0)->get_string_size(0);
                   //Analyze data (it can be "z" or "y")
                   if (value_size == 1){
                     if (value[0] == 'z') z_up_direction = true;
@@ -579,7 +629,7 @@ namespace octet
                 data_structure = (openDDL_data_type_structure *)structure->get_substructure(0);
                 if (data_structure->get_type_structure() == 1 && data_structure->get_typeID() == 9){
                   // Obtain data
-                  float value = data_structure->get_data_list(0)->data_list[0]->value.float_;
+                  float value = data_structure->get_data_list(0)->get_float(0);
                   time_multiplier = value;
                   if (DEBUGOPENGEX) printf("The new time multiplier is %f\n", time_multiplier);
                 }
@@ -599,7 +649,7 @@ namespace octet
                 data_structure = (openDDL_data_type_structure *)structure->get_substructure(0);
                 if (data_structure->get_type_structure() == 1 && data_structure->get_typeID() == 9){
                   // Obtain data
-                  float value = data_structure->get_data_list(0)->data_list[0]->value.float_;
+                  float value = data_structure->get_data_list(0)->get_float(0);
                   angle_multiplier = value;
                   if (DEBUGOPENGEX) printf("The new angle multiplier is %f\n", angle_multiplier);
                 }
@@ -619,7 +669,7 @@ namespace octet
                 data_structure = (openDDL_data_type_structure *)structure->get_substructure(0);
                 if (data_structure->get_type_structure() == 1 && data_structure->get_typeID() == 9){
                   // Obtain data
-                  float value = data_structure->get_data_list(0)->data_list[0]->value.float_;
+                  float value = data_structure->get_data_list(0)->get_float(0);
                   distance_multiplier = value;
                   if (DEBUGOPENGEX) printf("The new distance multiplier is %f\n", distance_multiplier);
                 }
@@ -666,8 +716,8 @@ namespace octet
         else if (num_properties == 1){
           openDDL_properties *current_property = structure->get_property(0);
           //check type of property
-          if (identifiers_.get_value(current_property->identifierID) == 39){ //curve property
-            curve = app_utils::get_atom(current_property->literal.value.string_);
+          if (current_property->identifierID == gex_ident::prop_curve){ //curve property
+            curve = get_octet_atom(current_property->literal.atom_);
           }
           else{
             no_error = false;
@@ -698,8 +748,8 @@ namespace octet
             for (int i_data_list = 0; i_data_list < values_substructure->get_number_lists(); ++i_data_list){
               openDDL_data_list *data_list = values_substructure->get_data_list(i_data_list);
               //obtain all the data inside the data list
-              for (unsigned int i = 0; i < data_list->data_list.size(); ++i){
-                values[i_key].push_back(data_list->data_list[i]->value.float_);
+              for (unsigned int i = 0; i < (unsigned int)data_list->size(); ++i){
+                values[i_key].push_back(data_list->get_float(i));
               }
             }
           }
@@ -725,8 +775,8 @@ namespace octet
         else if (num_properties == 1){
           openDDL_properties *current_property = structure->get_property(0);
           //check type of property
-          if (identifiers_.get_value(current_property->identifierID) == 39){ //curve property
-            curve = app_utils::get_atom(current_property->literal.value.string_);
+          if (current_property->identifierID == gex_ident::prop_curve){ //curve property
+            curve = get_octet_atom(current_property->literal.atom_);
           }
           else{
             no_error = false;
@@ -757,27 +807,24 @@ namespace octet
             int number_lists = values_substructure->get_number_lists();
             //if there is only one list, it's a data_list, so divide that data_list into different data_array_lists with one value each
             if (number_lists != 1){
-              //Obtain each of the data_lists
+              //Obtain each of the subarrays (they are one after the other in the same list)
               values[i_key].resize(number_lists);
+              openDDL_data_list *data_list = values_substructure->get_contiguous_list();
               for (int i_data_list = 0; i_data_list < number_lists; ++i_data_list){
-                openDDL_data_list *data_list = values_substructure->get_data_list(i_data_list);
-                unsigned int data_list_size = data_list->data_list.size();
-                //obtain all the data inside the data list
+                unsigned int data_list_size = (unsigned int)values_substructure->get_integer_literal();
+                //obtain all the data inside the subarray
                 values[i_key][i_data_list].resize(data_list_size);
-                for (unsigned int i = 0; i < data_list_size; ++i){
-                  float value_temp = data_list->data_list[i]->value.float_;
-                  values[i_key][i_data_list][i] = value_temp;
-                }
+                data_list->get_values(values[i_key][i_data_list].data(), i_data_list * data_list_size, data_list_size);
               }
             }
             else{//if the final list is just one, avoid 
               //Obtain each of the data_lists
               openDDL_data_list *data_list = values_substructure->get_data_list(0);
-              unsigned int data_list_size = data_list->data_list.size();
+              unsigned int data_list_size = (unsigned int)data_list->size();
               values[i_key].resize(data_list_size);
               for (unsigned int i = 0; i < data_list_size; ++i){
                 values[i_key][i].resize(1);
-                float value_temp = data_list->data_list[i]->value.float_;
+                float value_temp = data_list->get_float(i);
                 values[i_key][i][0] = value_temp;
               }
             }
@@ -806,19 +853,19 @@ namespace octet
         }
         else{//It has only one property, so analize it
           openDDL_properties * current_property = structure->get_property(0);
-          if (identifiers_.get_value(current_property->identifierID) != 53){ //If the property it's not target, it's an error
+          if (current_property->identifierID != gex_ident::prop_target){ //If the property it's not target, it's an error
             no_error = false;
             printf("(((ERROR--> The Track structure can have only target property)))\n");
           }
           else{
-            //as is a target property, get the reference of it
-            current_property->literal.value.string_;
-            atom_t reference = app_utils::get_atom(current_property->literal.value.ref_);
+            //as is a target property, get the structure referenced (it was found by resolve_references)
+            openDDL_structure * reference = current_property->literal.target_;
             ref_transform current_transform;
             current_transform.ref = atom_;
+            current_transform.structure = NULL;
             //Check what is the transform referenced
-            for (int i_ref = 0; i_ref < list_ref.size(); ++i_ref){
-              if (list_ref[i_ref].ref == reference){
+            for (int i_ref = 0; i_ref < list_ref.size() && reference != NULL; ++i_ref){
+              if (list_ref[i_ref].structure == reference){
                 current_transform = list_ref[i_ref];
               }
             }
@@ -837,7 +884,7 @@ namespace octet
                 openDDL_identifier_structure * substructure = (openDDL_identifier_structure *)structure->get_substructure(j);
                 int tempID = substructure->get_identifierID();
                 switch (tempID){
-                case 30: //Time
+                case gex_ident::id_Time:
                   if (time_detected){
                     no_error = false;
                     printf("(((ERROR! This structure Track can only have one Time substructure!)))\n");
@@ -847,7 +894,7 @@ namespace octet
                     no_error = openGEX_Time(values_time, curve_time, substructure);
                   }
                   break;
-                case 34: //Value
+                case gex_ident::id_Value:
                   if (value_detected){
                     no_error = false;
                     printf("(((ERROR! This structure Track can only have one Value substructure!)))\n");
@@ -883,7 +930,7 @@ namespace octet
                 transformB.multMatrix(list_ref[i_transform].matrix);
               }
               //The current transform is current_transform
-              animation *new_animation = new animation();
+              animation *new_animation = scene.new_animation();
               dynarray<float> final_values;
               int size_animation = values_time[0].size();
               final_values.reserve(16 * size_animation);
@@ -911,9 +958,9 @@ namespace octet
                   final_values.push_back(final_transform.get()[j]);
                 }
               }
-              new_animation->add_channel(father, father->get_sid(), atom_transform, app_utils::get_atom("pos_x"),values_time[0],final_values);
-              animation_instance *new_instance = new animation_instance(new_animation, father);
-              dict->set_resource(app_utils::get_atom_name(current_transform.ref), new_instance);
+              scene.add_channel(new_animation, father, father->get_sid(), atom_transform, app_utils::get_atom("pos_x"), values_time[0], final_values);
+              animation_instance *new_instance = scene.new_animation_instance(new_animation, father);
+              scene.set_resource(dict, app_utils::get_atom_name(current_transform.ref), new_instance);
             }
           }
         }
@@ -937,15 +984,15 @@ namespace octet
         unsigned int num_properties = structure->get_number_properties();
         for (unsigned int i = 0; i < num_properties; ++i){
           openDDL_properties * current_property = structure->get_property(i);
-          int tempID = identifiers_.get_value(current_property->identifierID);
+          int tempID = current_property->identifierID;
           switch(tempID){
-          case 38: //clip
+          case gex_ident::prop_clip:
             clip = current_property->literal.value.integer_;
             break;
-          case 37: //begin
+          case gex_ident::prop_begin:
             begin = current_property->literal.value.float_;
             break;
-          case 40: //end
+          case gex_ident::prop_end:
             end = current_property->literal.value.float_;
             break;
           default:
@@ -958,7 +1005,7 @@ namespace octet
         unsigned int num_substructures = structure->get_number_substructures();
         for (unsigned int i_substructure = 0; i_substructure < num_substructures; ++i_substructure){
           openDDL_identifier_structure *substructure = (openDDL_identifier_structure *)structure->get_substructure(i_substructure);
-          if (substructure->get_identifierID() == 31){//Track
+          if (substructure->get_identifierID() == gex_ident::id_Track){
             no_error = openGEX_Track(list_ref, substructure, father);
           }
           else{//This is not a Track structure
@@ -973,10 +1020,11 @@ namespace octet
       /// @brief This will obtain all the info from a Name structure
       /// @param  name  This is a pointer to char, it will return here the value of the Name
       /// @param  nameSize  This is the size of the name that it's obtained by this structure
+      /// @param  nameAtom  This is the atom of the name in the atom table of the document
       /// @param  structure This is the structure to be analized, it has to be Name.
       /// @return True if everything went well, false if there was some problem
       ////////////////////////////////////////////////////////////////////////////////
-      bool openGEX_Name(char *&name, int &nameSize, openDDL_identifier_structure *structure){
+      bool openGEX_Name(char *&name, int &nameSize, int &nameAtom, openDDL_identifier_structure *structure){
         bool no_error = true;
         if (structure->get_number_properties() != 0){
           printf("(((ERROR: A structure of the type Name cannot have properties)))\n");
@@ -995,8 +1043,9 @@ namespace octet
           }
           else{
             delete name;
-            name = data_list_name->data_list[0]->value.string_;
-            nameSize = data_list_name->data_list[0]->size_string_;
+            name = data_list_name->get_string(0);
+            nameSize = data_list_name->get_string_size(0);
+            nameAtom = data_list_name->get_atom(0);
           }
         }
         return no_error;
@@ -1014,8 +1063,8 @@ namespace octet
         //Check properties (has to have one, attrib)
         if (structure->get_number_properties() == 1){
           openDDL_properties * current_property = structure->get_property(0);
-          int tempID = identifiers_.get_value(current_property->identifierID);
-          if (tempID == 36){ //attrib
+          int tempID = current_property->identifierID;
+          if (tempID == gex_ident::prop_attrib){
             //attrib might have different values:
             // "diffuse", "specular", "emission", "opacity", "transparency", "light"
             int size_attrib = current_property->literal.size_string_;
@@ -1047,7 +1096,7 @@ namespace octet
             color = vec4(0);
             openDDL_data_list *data_list = substructure->get_data_list(0);
             for (int i = 0; i < size_display; ++i){
-              color[i] = data_list->data_list[i]->value.float_;
+              color[i] = data_list->get_float(i);
             }
           }
         }
@@ -1070,7 +1119,7 @@ namespace octet
         //Check the property (has to have only one, param)
         if (structure->get_number_properties() == 1){
           openDDL_properties * current_property = structure->get_property(0);
-          if (identifiers_.get_value(current_property->identifierID == 36)){ //attrib
+          if (current_property->identifierID == gex_ident::prop_attrib){ //attrib
             //Some of the possible values of attrib are:
             //"specular_power" (for Material), 
             //"intensity" (for LightObject), 
@@ -1160,7 +1209,7 @@ namespace octet
           openDDL_data_type_structure *substructure = (openDDL_data_type_structure *)structure->get_substructure(0);
           int size_display = substructure->get_integer_literal();
           if (size_display == 1){
-            value = substructure->get_data_list(0)->data_list[0]->value.float_;
+            value = substructure->get_data_list(0)->get_float(0);
           }
           else{
             no_error = false;
@@ -1190,11 +1239,11 @@ namespace octet
         type = GEX_NO_VALUE;
         for (int i = 0; i < num_properties; ++i){
           openDDL_properties * current_property = structure->get_property(i);
-          int tempID = identifiers_.get_value(current_property->identifierID);
+          int tempID = current_property->identifierID;
           int size_attrib;
           char * value_attrib;
           switch (tempID){
-          case 36: //attrib
+          case gex_ident::prop_attrib:
             size_attrib = current_property->literal.size_string_;
             value_attrib = current_property->literal.value.string_;
             type = obtain_attrib(value_attrib, size_attrib);
@@ -1203,7 +1252,7 @@ namespace octet
               no_error = false;
             }
             break;
-          case 54: //textcoord
+          case gex_ident::prop_texcoord:
             index = current_property->literal.value.u_integer_literal_;
             break;
           default:
@@ -1229,35 +1278,35 @@ namespace octet
           openDDL_structure *substructure = structure->get_substructure(counter_substructure);
           if (substructure->get_type_structure() == DATA_TYPE_TYPE){
             openDDL_data_list *data_list = ((openDDL_data_type_structure *)substructure)->get_data_list(0);
-            size_url = data_list->data_list[0]->size_string_;
-            texture_url = data_list->data_list[0]->value.string_;
+            size_url = data_list->get_string_size(0);
+            texture_url = data_list->get_string(0);
           }
           else if (substructure->get_type_structure() == IDENTIFIER_TYPE){
             int tempID = ((openDDL_identifier_structure *)substructure)->get_identifierID();
             switch (tempID){
               //Get Transforms (may not have)
-            case 32://Transform
+            case gex_ident::id_Transform:
               no_error = openGEX_Transform(current_ref, transformMatrixes, object_only, (openDDL_identifier_structure *)substructure);
               nodeToParent.multMatrix(transformMatrixes[0]);
               if (current_ref.ref != atom_){
                 list_ref.push_back(current_ref);
               }
               break;
-            case 33://Translation
+            case gex_ident::id_Translation:
               no_error = openGEX_Translate(current_ref, transformMatrixes[0], object_only, (openDDL_identifier_structure *)substructure);
               nodeToParent.multMatrix(transformMatrixes[0]);
               if (current_ref.ref != atom_){
                 list_ref.push_back(current_ref);
               }
               break;
-            case 25://Rotation
+            case gex_ident::id_Rotation:
               no_error = openGEX_Rotate(current_ref, transformMatrixes[0], object_only, (openDDL_identifier_structure *)substructure);
               nodeToParent.multMatrix(transformMatrixes[0]);
               if (current_ref.ref != atom_){
                 list_ref.push_back(current_ref);
               }
               break;
-            case 26://Scale
+            case gex_ident::id_Scale:
               no_error = openGEX_Scale(current_ref, transformMatrixes[0], object_only, (openDDL_identifier_structure *)substructure);
               nodeToParent.multMatrix(transformMatrixes[0]);
               if (current_ref.ref != atom_){
@@ -1265,7 +1314,7 @@ namespace octet
               }
               break;
               //Get Animation
-            case 0://Animation
+            case gex_ident::id_Animation:
             //IGNORE ANIMATIONS FOR NOW!!!! TO DO!
               break;
             default:
@@ -1286,35 +1335,35 @@ namespace octet
           int tempID = (substructure)->get_identifierID();
           switch (tempID){
             //Get Transforms (may not have)
-          case 32://Transform
+          case gex_ident::id_Transform:
             no_error = openGEX_Transform(current_ref, transformMatrixes, object_only, (openDDL_identifier_structure *)substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             if (current_ref.ref != atom_){
               list_ref.push_back(current_ref);
             }
             break;
-          case 33://Translation
+          case gex_ident::id_Translation:
             no_error = openGEX_Translate(current_ref, transformMatrixes[0], object_only, (openDDL_identifier_structure *)substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             if (current_ref.ref != atom_){
               list_ref.push_back(current_ref);
             }
             break;
-          case 25://Rotation
+          case gex_ident::id_Rotation:
             no_error = openGEX_Rotate(current_ref, transformMatrixes[0], object_only, (openDDL_identifier_structure *)substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             if (current_ref.ref != atom_){
               list_ref.push_back(current_ref);
             }
             break;
-          case 26://Scale
+          case gex_ident::id_Scale:
             no_error = openGEX_Scale(current_ref, transformMatrixes[0], object_only, (openDDL_identifier_structure *)substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             if (current_ref.ref != atom_){
               list_ref.push_back(current_ref);
             }
             break;
-          case 0://Animation
+          case gex_ident::id_Animation:
             //IGNORE ANIMATIONS FOR NOW!!!! TO DO!
             break;
           default:
@@ -1328,11 +1377,11 @@ namespace octet
 
       ////////////////////////////////////////////////////////////////////////////////
       /// @brief This will obtain all the info from a ObjectRef structure
-      /// @param  object_ref  This is a pointer to char, it will return here the value of the ObjectRef
+      /// @param  object_ref  This will return here the atom of the name of the object referenced (-1 if it was not found)
       /// @param  structure This is the structure to be analized, it has to be ObjectRef.
       /// @return True if everything went well, false if there was some problem
       ////////////////////////////////////////////////////////////////////////////////
-      bool openGEX_ObjectRef(char *&object_ref, openDDL_identifier_structure *structure){
+      bool openGEX_ObjectRef(int &object_ref, openDDL_identifier_structure *structure){
         bool no_error = true;
         //This structure cannot have properties
         if (structure->get_number_properties() > 0){
@@ -1342,8 +1391,8 @@ namespace octet
         //And it has to have one single substructure of data type ref
         if (structure->get_number_substructures() == 1){
           openDDL_data_type_structure * substructure = (openDDL_data_type_structure *)structure->get_substructure(0);
-          openDDL_data_list * data_list_ref = substructure->get_data_list(0);
-          object_ref = data_list_ref->data_list[0]->value.ref_;
+          openDDL_structure * target = substructure->get_data_list(0)->get_target(0);
+          object_ref = target != NULL ? target->get_nameID() : -1;
         }
         else{
           no_error = true;
@@ -1354,12 +1403,12 @@ namespace octet
 
       ////////////////////////////////////////////////////////////////////////////////
       /// @brief This will obtain all the info from a MaterialRef structure
-      /// @param  material_ref  This is a pointer to char, it will return here the value of the MaterialRef
+      /// @param  material_ref  This will return here the atom of the name of the material referenced (-1 if it was not found)
       /// @param  index  This will return the index of the material (this has to come with a value of 0, default value)
       /// @param  structure This is the structure to be analized, it has to be MaterialRef.
       /// @return True if everything went well, false if there was some problem
       ////////////////////////////////////////////////////////////////////////////////
-      bool openGEX_MaterialRef(char *&material_ref, uint32_t &index, openDDL_identifier_structure *structure){
+      bool openGEX_MaterialRef(int &material_ref, uint32_t &index, openDDL_identifier_structure *structure){
         bool no_error = true;
         //This structure cannot have properties
         if (structure->get_number_properties() > 1){
@@ -1368,15 +1417,16 @@ namespace octet
         }
         else if (structure->get_number_properties() == 1){
           openDDL_properties * current_property = structure->get_property(0);
-          int tempID = identifiers_.get_value(current_property->identifierID);
-          if (tempID == 42){ //index
+          int tempID = current_property->identifierID;
+          if (tempID == gex_ident::prop_index){
             index = current_property->literal.value.float_;
           }
         }
         //And it has to have one single substructure of data type ref
         if (structure->get_number_substructures() == 1){
           openDDL_data_type_structure * substructure = (openDDL_data_type_structure *)structure->get_substructure(0);
-          material_ref = substructure->get_data_list(0)->data_list[0]->value.ref_;
+          openDDL_structure * target = substructure->get_data_list(0)->get_target(0);
+          material_ref = target != NULL ? target->get_nameID() : -1;
         }
         else{
           no_error = true;
@@ -1409,11 +1459,8 @@ namespace octet
       bool openGEX_Transform(ref_transform &ref, dynarray<mat4t> &transformMatrix, bool &object_only, openDDL_identifier_structure *structure){
         bool no_error = true;
         //Check that the structure is correct!
-        char * name = structure->get_name();
-        if (name != NULL)
-          ref.ref = app_utils::get_atom(name);
-        else
-          ref.ref = atom_;
+        ref.ref = get_octet_atom(structure->get_nameID());
+        ref.structure = structure;
         ref.type = _TRANSFORM;
         //Get the value of the properties!
         if (structure->get_number_properties() > 1){
@@ -1435,12 +1482,11 @@ namespace octet
           unsigned int size_data_list = substructure->get_number_lists();
           if (transformMatrix.size() < size_data_list)
             transformMatrix.resize(size_data_list);
+          //All the matrices are one after the other in the same list
+          openDDL_data_list * data_list_values = substructure->get_contiguous_list();
           for (unsigned int i = 0; i < size_data_list; ++i){
             float values[16];
-            openDDL_data_list * data_list_values = substructure->get_data_list(i);
-            for (int j = 0; j < 16; ++j){
-              values[j] = data_list_values->data_list[j]->value.float_;
-            }
+            data_list_values->get_values(values, 16 * i, 16);
             //Obtain the matrix from this values
             transformMatrix[i].init_transpose(values);
           }
@@ -1461,11 +1507,8 @@ namespace octet
         bool no_error = true;
         int coordinates = 3;
         //Check that the structure is correct!
-        char * name = structure->get_name();
-        if (name != NULL)
-          ref.ref = app_utils::get_atom(name);
-        else
-          ref.ref = atom_;
+        ref.ref = get_octet_atom(structure->get_nameID());
+        ref.structure = structure;
         ref.type = _TRANSLATE;
         //Get the value of the properties!
         int numProperties = structure->get_number_properties();
@@ -1476,11 +1519,11 @@ namespace octet
         else{
           for (int i = 0; i < numProperties && no_error; ++i){
             openDDL_properties * current_property = structure->get_property(i);
-            int typeProperty = identifiers_.get_value(current_property->identifierID);
-            if (typeProperty == 49){//object
+            int typeProperty = current_property->identifierID;
+            if (typeProperty == gex_ident::prop_object){
               object_only = current_property->literal.value.bool_;
             }
-            else if (typeProperty == 44){//kind
+            else if (typeProperty == gex_ident::prop_kind){
               if (current_property->literal.size_string_ == 1)
                 switch (current_property->literal.value.string_[0]){
                 case 'x':
@@ -1516,8 +1559,8 @@ namespace octet
           value_list.resize(3);
           //Obtain the values from the substructures (float[16]) that will be converted into a mat4t!!!
           openDDL_data_list * data_list_values = ((openDDL_data_type_structure *)structure->get_substructure(0))->get_data_list(0);
-          for (int i = 0; i < data_list_values->data_list.size(); ++i){
-            value_list[i] = data_list_values->data_list[i]->value.float_;
+          for (int i = 0; i < (int)data_list_values->size(); ++i){
+            value_list[i] = data_list_values->get_float(i);
           }
           no_error = get_translate_matrix(transformMatrix, ref, value_list.data());
         }
@@ -1537,11 +1580,8 @@ namespace octet
         bool no_error = true;
         int coordinates = 3;
         //Check that the structure is correct!
-        char * name = structure->get_name();
-        if (name != NULL)
-          ref.ref = app_utils::get_atom(name);
-        else
-          ref.ref = atom_;
+        ref.ref = get_octet_atom(structure->get_nameID());
+        ref.structure = structure;
         ref.type = _ROTATE;
         ref.subtype = GEX_AXIS;
         //Get the value of the properties!
@@ -1553,11 +1593,11 @@ namespace octet
         else{
           for (int i = 0; i < numProperties && no_error; ++i){
             openDDL_properties * current_property = structure->get_property(i);
-            int typeProperty = identifiers_.get_value(current_property->identifierID);
-            if (typeProperty == 49){//object
+            int typeProperty = current_property->identifierID;
+            if (typeProperty == gex_ident::prop_object){
               object_only = current_property->literal.value.bool_;
             }
-            else if (typeProperty == 44){//kind
+            else if (typeProperty == gex_ident::prop_kind){
               if (current_property->literal.size_string_ == 1){
                 switch (current_property->literal.value.string_[0]){
                 case 'x':
@@ -1590,10 +1630,10 @@ namespace octet
         else{
           openDDL_data_list * data_list_values = ((openDDL_data_type_structure *)structure->get_substructure(0))->get_data_list(0);
           dynarray<float> value_list;
-          int size_list = data_list_values->data_list.size();
+          int size_list = (int)data_list_values->size();
           value_list.reserve(size_list);
           for (int i = 0; i < size_list; ++i){
-            value_list[i] = data_list_values->data_list[i]->value.float_;
+            value_list[i] = data_list_values->get_float(i);
           }
           no_error = get_rotate_matrix(transformMatrix, ref, value_list.data());
         }
@@ -1613,11 +1653,8 @@ namespace octet
         bool no_error = true;
         int coordinates = 3;
         //Check that the structure is correct!
-        char * name = structure->get_name();
-        if (name != NULL)
-          ref.ref = app_utils::get_atom(name);
-        else
-          ref.ref = atom_;
+        ref.ref = get_octet_atom(structure->get_nameID());
+        ref.structure = structure;
         ref.type = _SCALE;
         //Get the value of the properties!
         int numProperties = structure->get_number_properties();
@@ -1628,11 +1665,11 @@ namespace octet
         else{
           for (int i = 0; i < numProperties && no_error; ++i){
             openDDL_properties * current_property = structure->get_property(i);
-            int typeProperty = identifiers_.get_value(current_property->identifierID);
-            if (typeProperty == 49){//object
+            int typeProperty = current_property->identifierID;
+            if (typeProperty == gex_ident::prop_object){
               object_only = current_property->literal.value.bool_;
             }
-            else if (typeProperty == 44){//kind
+            else if (typeProperty == gex_ident::prop_kind){
               if (current_property->literal.size_string_ == 1)
                 switch (current_property->literal.value.string_[0]){
                 case 'x':
@@ -1667,10 +1704,10 @@ namespace octet
           //Obtain the values from the substructures (float) that will be converted into a mat4t!!!
           openDDL_data_list * data_list_values = ((openDDL_data_type_structure *)structure->get_substructure(0))->get_data_list(0);
           dynarray<float> value_list;
-          int size_list = data_list_values->data_list.size();
+          int size_list = (int)data_list_values->size();
           value_list.reserve(size_list);
           for (int i = 0; i < size_list; ++i){
-            value_list[i] = data_list_values->data_list[i]->value.float_;
+            value_list[i] = data_list_values->get_float(i);
           }
           no_error = get_scale_matrix(transformMatrix, ref, value_list.data());
         }
@@ -1687,16 +1724,11 @@ namespace octet
       bool openGEX_Node(openDDL_identifier_structure *structure, scene_node *father = NULL){
         int tempID;
         bool no_error = true;
-        //Creating new node
-        scene_node *node;
-        node = new scene_node();
-        //If it's not a Top-Level class, add it to his father
-        if (father != NULL){
-          father->add_child(node);
-        }
+        //Creating new node (it's added to his father if it's not a Top-Level class)
+        scene_node *node = scene.new_node(father);
         //Obtain the name of the structure
         char * name = structure->get_name();
-        node->set_sid(app_utils::get_atom(name));
+        scene.set_node_sid(node, get_octet_atom(structure->get_nameID()));
         //BoneNode has no properties!
         int numProperties = structure->get_number_properties();
         if (numProperties != 0){
@@ -1720,6 +1752,7 @@ namespace octet
         int num_mat_index = 0;
         char * nameNode = NULL;
         int sizeName = 0;
+        int atomNode = -1;
         bool object_only = false;
         //Check all the substructures
         for (int i = 0; i < numSubstructures; ++i){
@@ -1729,54 +1762,54 @@ namespace octet
           tempID = substructure->get_identifierID();
           switch (tempID){
             //Get Name (may not have)
-          case 21://Name
+          case gex_ident::id_Name:
             if (numNames == 0){
               ++numNames;
-              no_error = openGEX_Name(nameNode, sizeName, substructure);
+              no_error = openGEX_Name(nameNode, sizeName, atomNode, substructure);
             }
             else{
               printf("(((ERROR: It has more than one Morph, it can only have one (or none)!!!)))\n");
             }
             break;
             //Get Transforms (may not have)
-          case 32://Transform
+          case gex_ident::id_Transform:
             no_error = openGEX_Transform(current_ref, transformMatrixes, object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 33://Translation
+          case gex_ident::id_Translation:
             no_error = openGEX_Translate(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 25://Rotation
+          case gex_ident::id_Rotation:
             no_error = openGEX_Rotate(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 26://Scale
+          case gex_ident::id_Scale:
             no_error = openGEX_Scale(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
             //Get Animation
-          case 0://Animation
+          case gex_ident::id_Animation:
             //IGNORE ANIMATIONS FOR NOW!!!! TO DO!
             break;
             //Get Nodes (children)
-          case 4://BoneNode
+          case gex_ident::id_BoneNode:
             no_error = openGEX_BoneNode(substructure, node);
             break;
-          case 7://CameraNode
+          case gex_ident::id_CameraNode:
             //IGNORE CAMERAS FOR NOW!!!! TO DO!
             break;
-          case 10://GeometryNode
+          case gex_ident::id_GeometryNode:
             no_error = openGEX_GeometryNode(substructure, node);
             break;
-          case 14://LightNode
+          case gex_ident::id_LightNode:
             //IGNORE LIGHTS FOR NOW!!!! TO DO!
             break;
-          case 22://Nodes
+          case gex_ident::id_Node:
             no_error = openGEX_Node(substructure, node);
             break;
           }
@@ -1785,14 +1818,16 @@ namespace octet
         if (numNames == 0){ //it has no name, so get the structure name
           if (DEBUGOPENGEX) printf("As it has no name, assign the structure name \n");
           nameNode = name;
+          atomNode = structure->get_nameID();
         }
         // We are working with transpose matrix in octet!!! So transpose it to be able to work properly!
-        node->access_nodeToParent().multMatrix(nodeToParent.transpose4x4());
+        scene.transform_node(node, nodeToParent.transpose4x4());
 
         //Add the id for the animations
-        node->set_sid(app_utils::get_atom(nameNode));
+        scene.set_node_sid(node, get_octet_atom(atomNode));
         //Add the current bone to the dictionary of bones
-        dict_nodes[name] = node;
+        if (structure->get_nameID() >= 0)
+          dict_nodes[structure->get_nameID()] = node;
 
         return no_error;
       }
@@ -1806,16 +1841,11 @@ namespace octet
       bool openGEX_BoneNode(openDDL_identifier_structure *structure, scene_node *father = NULL){
         int tempID;
         bool no_error = true;
-        //Creating new node
-        scene_node *node;
-        node = new scene_node();
-        //If it's not a Top-Level class, add it to his father
-        if (father != NULL){
-          father->add_child(node);
-        }
+        //Creating new node (it's added to his father if it's not a Top-Level class)
+        scene_node *node = scene.new_node(father);
         //Obtain the name of the structure
         char * name = structure->get_name();
-        node->set_sid(app_utils::get_atom(name));
+        scene.set_node_sid(node, get_octet_atom(structure->get_nameID()));
         //BoneNode has no properties!
         int numProperties = structure->get_number_properties();
         if (numProperties != 0){
@@ -1839,6 +1869,7 @@ namespace octet
         int num_mat_index = 0;
         char * nameNode = NULL;
         int sizeName = 0;
+        int atomNode = -1;
         bool object_only = false;
         //Check all the substructures
         for (int i = 0; i < numSubstructures; ++i){
@@ -1848,55 +1879,55 @@ namespace octet
           tempID = substructure->get_identifierID();
           switch (tempID){
             //Get Name (may not have)
-          case 21://Name
+          case gex_ident::id_Name:
             if (numNames == 0){
               ++numNames;
-              no_error = openGEX_Name(nameNode, sizeName, substructure);
+              no_error = openGEX_Name(nameNode, sizeName, atomNode, substructure);
             }
             else{
               printf("(((ERROR: It has more than one Morph, it can only have one (or none)!!!)))\n");
             }
             break;
             //Get Transforms (may not have)
-          case 32://Transform
+          case gex_ident::id_Transform:
             no_error = openGEX_Transform(structure_ref, transformMatrixes, object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(structure_ref);
             break;
-          case 33://Translation
+          case gex_ident::id_Translation:
             no_error = openGEX_Translate(structure_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(structure_ref);
             break;
-          case 25://Rotation
+          case gex_ident::id_Rotation:
             no_error = openGEX_Rotate(structure_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(structure_ref);
             break;
-          case 26://Scale
+          case gex_ident::id_Scale:
             no_error = openGEX_Scale(structure_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(structure_ref);
             break;
             //Get Animation
-          case 0://Animation
+          case gex_ident::id_Animation:
             if (check_animation)
               no_error = openGEX_Animation(list_ref, substructure, node);
             break;
             //Get Nodes (children)
-          case 4://BoneNode
+          case gex_ident::id_BoneNode:
             no_error = openGEX_BoneNode(substructure, node);
             break;
-          case 7://CameraNode
+          case gex_ident::id_CameraNode:
             //IGNORE CAMERAS FOR NOW!!!! TO DO!
             break;
-          case 10://GeometryNode
+          case gex_ident::id_GeometryNode:
             no_error = openGEX_GeometryNode(substructure, node);
             break;
-          case 14://LightNode
+          case gex_ident::id_LightNode:
             //IGNORE LIGHTS FOR NOW!!!! TO DO!
             break;
-          case 22://Nodes
+          case gex_ident::id_Node:
             no_error = openGEX_Node(substructure, node);
             break;
           }
@@ -1905,13 +1936,16 @@ namespace octet
         if (numNames == 0){ //it has no name, so get the structure name
           if (DEBUGOPENGEX) printf("As it has no name, assign the structure name \n");
           nameNode = name;
+          atomNode = structure->get_nameID();
         }
         // We are working with transpose matrix in octet!!! So transpose it to be able to work properly!
-        node->access_nodeToParent().multMatrix(nodeToParent.transpose4x4());
+        scene.transform_node(node, nodeToParent.transpose4x4());
         //At this point the node has the children, the parent, and the matrix of transform!
         //Add the current bone to the dictionary of bones
-        dict_nodes[name] = node;
-        dict_bone_nodes[name] = node;
+        if (structure->get_nameID() >= 0){
+          dict_nodes[structure->get_nameID()] = node;
+          dict_bone_nodes[structure->get_nameID()] = node;
+        }
         
         return no_error;
       }
@@ -1940,8 +1974,8 @@ namespace octet
         else{
           for (int i = 0; i < numProperties && no_error; ++i){
             openDDL_properties * current_property = structure->get_property(i);
-            int typeProperty = identifiers_.get_value(current_property->identifierID);
-            if (typeProperty == 36){//attrib
+            int typeProperty = current_property->identifierID;
+            if (typeProperty == gex_ident::prop_attrib){
               //attrib properties can be "position", "normal", "tangent", "bitangent", "color", and "texcoord"
               //also, they can be finished in an optional [0] or [1] where having [1] means an secondary value
               //This will translate those words to the following values:
@@ -2005,7 +2039,7 @@ namespace octet
                 break;
               }
             }
-            else if (typeProperty == 47){//morph
+            else if (typeProperty == gex_ident::prop_morph){
               morph_index = current_property->literal.value.u_integer_literal_;
             }
             else{
@@ -2024,58 +2058,48 @@ namespace octet
           openDDL_data_list *data_list;
           int size_data_list = substructure->get_integer_literal();
           int number_data_lists = substructure->get_number_lists();
-          if (size_data_list == 1){
+          if (substructure->get_typeID() != token_type::tok_float){
+            no_error = false;
+            printf("(((ERROR! The VertexArray has to contain floats!)))\n");
+          }
+          else if (size_data_list <= 1){
+            //All the values are in one contiguous data_list, so read them directly from the array of floats
             data_list = substructure->get_data_list(0);
-            num_vertexes = data_list->data_list.size();
-            openDDL_data_literal * new_data_list = data_list->data_list[0];
-            float a, b, c;
+            openDDL_span<float> values = data_list->get_span<float>();
             if (current_attrib == 0){ //pos
+              num_vertexes = (int)values.size() / 3;
               if (vertices == NULL)
                 vertices = new mesh::vertex[num_vertexes];
               for (int i = 0; i < num_vertexes; ++i){
-                a = new_data_list->value.float_;
-                ++new_data_list;
-                b = new_data_list->value.float_;
-                ++new_data_list;
-                c = new_data_list->value.float_;
-                ++new_data_list;
-                vertices[i].pos = vec3(a, b, c);
+                vertices[i].pos = vec3(values[3 * i], values[3 * i + 1], values[3 * i + 2]);
               }
             }
             else if (current_attrib == 1){//normal
+              num_vertexes = (int)values.size() / 3;
               if (vertices == NULL)
                 vertices = new mesh::vertex[num_vertexes];
               for (int i = 0; i < num_vertexes; ++i){
-                a = new_data_list->value.float_;
-                ++new_data_list;
-                b = new_data_list->value.float_;
-                ++new_data_list;
-                c = new_data_list->value.float_;
-                ++new_data_list;
-                vertices[i].normal = vec3(a, b, c);
+                vertices[i].normal = vec3(values[3 * i], values[3 * i + 1], values[3 * i + 2]);
               }
             }
             else if (current_attrib == 2){//uv
+              num_vertexes = (int)values.size() / 2;
               if (vertices == NULL)
                 vertices = new mesh::vertex[num_vertexes];
               for (int i = 0; i < num_vertexes; ++i){
-                a = new_data_list->value.float_;
-                ++new_data_list;
-                b = new_data_list->value.float_;
-                ++new_data_list;
-                vertices[i].uv = vec2(a, b);
+                vertices[i].uv = vec2(values[2 * i], values[2 * i + 1]);
               }
             }
           }
           else{
             num_vertexes = number_data_lists;
+            //All the subarrays are one after the other in the same array of floats
+            openDDL_span<float> values = substructure->get_contiguous_list()->get_span<float>();
             if (size_data_list == 2 && current_attrib == 2){ //uv
               if (vertices == NULL)
                 vertices = new mesh::vertex[num_vertexes];
               for (int i = 0; i < number_data_lists; ++i){
-                data_list = substructure->get_data_list(i);
-                vertices[i].uv = vec2(data_list->data_list[0]->value.float_,
-                                      data_list->data_list[1]->value.float_);
+                vertices[i].uv = vec2(values[2 * i], values[2 * i + 1]);
               }
             }
             else if (size_data_list == 3){
@@ -2083,20 +2107,14 @@ namespace octet
                 if (vertices == NULL)
                   vertices = new mesh::vertex[num_vertexes];
                 for (int i = 0; i < number_data_lists; ++i){
-                  data_list = substructure->get_data_list(i);
-                  vertices[i].pos = vec3(data_list->data_list[0]->value.float_,
-                                        data_list->data_list[1]->value.float_, 
-                                        data_list->data_list[2]->value.float_);
+                  vertices[i].pos = vec3(values[3 * i], values[3 * i + 1], values[3 * i + 2]);
                 }
               }
               else if (current_attrib == 1){ //normal
                 if (vertices == NULL)
                   vertices = new mesh::vertex[num_vertexes];
                 for (int i = 0; i < number_data_lists; ++i){
-                  data_list = substructure->get_data_list(i);
-                  vertices[i].normal = vec3(data_list->data_list[0]->value.float_,
-                                            data_list->data_list[1]->value.float_,
-                                            data_list->data_list[2]->value.float_);
+                  vertices[i].normal = vec3(values[3 * i], values[3 * i + 1], values[3 * i + 2]);
                 }
               }
               else{
@@ -2135,14 +2153,14 @@ namespace octet
         else{
           for (int i = 0; i < numProperties && no_error; ++i){
             openDDL_properties * current_property = structure->get_property(i);
-            int typeProperty = identifiers_.get_value(current_property->identifierID);
-            if (typeProperty == 46){//material
+            int typeProperty = current_property->identifierID;
+            if (typeProperty == gex_ident::prop_material){
               material_index = current_property->literal.value.float_;
             }
-            else if (typeProperty == 51){//restart
+            else if (typeProperty == gex_ident::prop_restart){
               restart = current_property->literal.value.float_;
             }
-            else if (typeProperty == 41){//front
+            else if (typeProperty == gex_ident::prop_front){
               //front can ve ccw or cw, so first check the size of the string
               if (current_property->literal.size_string_ == 2){
                 if (same_word("cw", current_property->literal.value.string_, 2))
@@ -2181,26 +2199,23 @@ namespace octet
           openDDL_data_list *data_list;
           int size_data_list = substructure->get_integer_literal();
           int number_data_lists = substructure->get_number_lists();
-          if (size_data_list == 1){
+          if (size_data_list <= 1){
             data_list = substructure->get_data_list(0);
-            num_indices = data_list->data_list.size();
+            num_indices = (int)data_list->size();
             if (indices == NULL)
               indices = new uint32_t [num_indices];
-            for (int i = 0; i < num_indices; ++i){
-              indices[i] = data_list->data_list[i]->value.u_integer_literal_;
-            }
+            //Copy (and convert from uint8, uint16... to uint32) all the indices in one go
+            data_list->get_values(indices, 0, num_indices);
           }
           else{
             num_indices = number_data_lists * size_data_list;
             if (indices == NULL)
               indices = new uint32_t[num_indices];
-            for (int i = 0; i < number_data_lists; ++i){
-              data_list = substructure->get_data_list(i);
-              for (int j = 0; j < size_data_list; ++j){
-                indices[i*size_data_list + j] = data_list->data_list[j]->value.u_integer_literal_;
-              }
-              if(DEBUGOPENGEX) printf("(%u, %u, %u)\n", indices[i*size_data_list], indices[i*size_data_list + 1], indices[i*size_data_list + 2]);
-            }
+            //All the subarrays are one after the other in the same list, so copy them in one go
+            data_list = substructure->get_contiguous_list();
+            data_list->get_values(indices, 0, num_indices);
+            for (int i = 0; DEBUGOPENGEX && i < number_data_lists; ++i)
+              printf("(%u, %u, %u)\n", indices[i*size_data_list], indices[i*size_data_list + 1], indices[i*size_data_list + 2]);
           }
         }
         return no_error;
@@ -2208,11 +2223,11 @@ namespace octet
 
       ////////////////////////////////////////////////////////////////////////////////
       /// @brief This will obtain all the info from a BoneRefArray structure
-      /// @param  ref_array This is an array of atoms_
+      /// @param  ref_array This is an array with the atoms of the names of the bones referenced (-1 if one was not found)
       /// @param  structure This is the structure to be analized, it has to be Node.
       /// @return True if everything went well, false if there was some problem
       ////////////////////////////////////////////////////////////////////////////////
-      bool openGEX_BoneRefArray(dynarray<atom_t> &ref_array, openDDL_identifier_structure *structure){
+      bool openGEX_BoneRefArray(dynarray<int> &ref_array, openDDL_identifier_structure *structure){
         bool no_error = true;
         //Check properties (it cannot have properties!)
         if (structure->get_number_properties() != 0){
@@ -2224,10 +2239,11 @@ namespace octet
           //Obtain the data_list_array
           openDDL_data_type_structure *substructure = (openDDL_data_type_structure *)structure->get_substructure(0);
           openDDL_data_list *data_list = substructure->get_data_list(0);
-          int num_ref = data_list->data_list.size();
+          int num_ref = (int)data_list->size();
           ref_array.resize(num_ref);
           for (int i = 0; i < num_ref; ++i){
-            ref_array[i] = app_utils::get_atom(data_list->data_list[i]->value.ref_);
+            openDDL_structure * target = data_list->get_target(i);
+            ref_array[i] = target != NULL ? target->get_nameID() : -1;
           }
         }
         else{
@@ -2239,13 +2255,13 @@ namespace octet
 
       ////////////////////////////////////////////////////////////////////////////////
       /// @brief This will obtain all the info from a Skeleton structure
-      /// @param  bone_array This is an array of atoms_ of the bones
+      /// @param  bone_array This is an array with the atoms of the bones (in the atom table of the document)
       /// @param  matrixTransforms This is an array of matrixes for each bone
       /// @param  structure This is the structure to be analized, it has to be Node.
       /// @param  instance  This is an atom (equivalente to string! but cheaper!) with the name of the mesh_instance that contains the mesh
       /// @return True if everything went well, false if there was some problem
       ////////////////////////////////////////////////////////////////////////////////
-      bool openGEX_Skeleton(dynarray<atom_t> &bone_array , dynarray<mat4t> &matrixTransforms, openDDL_identifier_structure *structure, atom_t instance){
+      bool openGEX_Skeleton(dynarray<int> &bone_array , dynarray<mat4t> &matrixTransforms, openDDL_identifier_structure *structure, atom_t instance){
         bool no_error = true;
         //Check properties (Skeleton structure has no properties)
         if (structure->get_number_properties() != 0){
@@ -2263,7 +2279,7 @@ namespace octet
           openDDL_identifier_structure *substructure = (openDDL_identifier_structure *)structure->get_substructure(i);
           int tempID = substructure->get_identifierID();
           switch (tempID){
-          case 5:  //BoneRefArray
+          case gex_ident::id_BoneRefArray:
             if (!contains_bone_ref){
               contains_bone_ref = true;
               no_error = openGEX_BoneRefArray(bone_array, substructure);
@@ -2273,7 +2289,7 @@ namespace octet
               printf("(((ERROR-> The structure Skeleton can only contain one single structure of BoneRefArray!)))\n");
             }
             break;
-          case 32: //Transform
+          case gex_ident::id_Transform:
             if (!contains_transform){
               contains_transform = true;
               no_error = openGEX_Transform(current_ref, matrixTransforms, object_only, substructure);
@@ -2324,7 +2340,7 @@ namespace octet
         bool object_only = false;
         dynarray<ref_transform> list_ref;
         dynarray<mat4t> transformMatrixes;
-        dynarray<atom_t> bone_array;
+        dynarray<int> bone_array;
         dynarray<mat4t> bindToModel;
         dynarray<int> boneCountArray;
         dynarray<int> boneIndexArray;
@@ -2332,8 +2348,8 @@ namespace octet
         if (transformMatrixes.size() < 1)
           transformMatrixes.resize(1);
         //Get ready the skin and skeleton...
-        skin_skeleton.ref_skin = new skin();
-        skin_skeleton.ref_skeleton = new skeleton(); 
+        skin_skeleton.ref_skin = scene.new_skin();
+        skin_skeleton.ref_skeleton = scene.new_skeleton();
         skin_skeleton.maxCount = 0;
         //Now check all the substructures
         for (int i = 0; i < num_substructures; ++i){
@@ -2343,7 +2359,7 @@ namespace octet
           openDDL_data_list * data_list_array;
           //Check the type of the substructure
           switch (substructure->get_identifierID()){
-          case 32: //Transform
+          case gex_ident::id_Transform:
             if (!contains_transform){
               contains_transform = true;
               no_error = openGEX_Transform(current_ref, transformMatrixes, object_only, substructure);
@@ -2356,7 +2372,7 @@ namespace octet
               printf("(((ERROR: The structure Skin has two or more Transform. It's invalid, it can only have one Transform!)))\n");
             }
             break;
-          case 27: //Skeleton
+          case gex_ident::id_Skeleton:
             if (!contains_skeleton){
               contains_skeleton = true;
               no_error = openGEX_Skeleton(bone_array, bindToModel, substructure, instance);
@@ -2366,15 +2382,15 @@ namespace octet
               printf("(((ERROR: The structure Skin has two or more Skeleton. It's invalid, it can only have one Skeleton!)))\n");
             }
             break;
-          case 2:  //BoneCountArray
+          case gex_ident::id_BoneCountArray:
             if (!contains_bone_count){
               contains_bone_count = true;
               data_list_array = ((openDDL_data_type_structure*)substructure->get_substructure(0))->get_data_list(0);
-              int size_data_list_array = data_list_array->data_list.size();
+              int size_data_list_array = (int)data_list_array->size();
+              boneCountArray.resize(size_data_list_array);
+              data_list_array->get_values(boneCountArray.data(), 0, size_data_list_array);
               for (int i = 0; i < size_data_list_array; ++i){
-                int value = data_list_array->data_list[i]->value.integer_;
-                boneCountArray.push_back(value);
-                if (value>skin_skeleton.maxCount) skin_skeleton.maxCount = value;
+                if (boneCountArray[i]>skin_skeleton.maxCount) skin_skeleton.maxCount = boneCountArray[i];
               }
             }
             else{
@@ -2382,30 +2398,26 @@ namespace octet
               printf("(((ERROR: The structure Skin has two or more BoneCountArray. It's invalid, it can only have one BoneCountArray!)))\n");
             }
             break;
-          case 3:  //BoneIndexArray
+          case gex_ident::id_BoneIndexArray:
             if (!contains_bone_index){
               contains_bone_index = true;
               data_list_array = ((openDDL_data_type_structure*)substructure->get_substructure(0))->get_data_list(0);
-              int size_data_list_array = data_list_array->data_list.size();
-              for (int i = 0; i < size_data_list_array; ++i){
-                int value = data_list_array->data_list[i]->value.integer_;
-                boneIndexArray.push_back(value);
-              }
+              int size_data_list_array = (int)data_list_array->size();
+              boneIndexArray.resize(size_data_list_array);
+              data_list_array->get_values(boneIndexArray.data(), 0, size_data_list_array);
             }
             else{
               no_error = false;
               printf("(((ERROR: The structure Skin has two or more BoneIndexArray. It's invalid, it can only have one BoneIndexArray!)))\n");
             }
             break;
-          case 6:  //BoneWeightArray
+          case gex_ident::id_BoneWeightArray:
             if (!contains_bone_weight){
               contains_bone_weight = true;
               data_list_array = ((openDDL_data_type_structure*)substructure->get_substructure(0))->get_data_list(0);
-              int size_data_list_array = data_list_array->data_list.size();
-              for (int i = 0; i < size_data_list_array; ++i){
-                float value = data_list_array->data_list[i]->value.float_;
-                boneWeightArray.push_back(value);
-              }
+              int size_data_list_array = (int)data_list_array->size();
+              boneWeightArray.resize(size_data_list_array);
+              data_list_array->get_values(boneWeightArray.data(), 0, size_data_list_array);
             }
             else{
               no_error = false;
@@ -2445,13 +2457,17 @@ namespace octet
             }
           }
           //Set the skin with the given transform (identity if it has no transform!)
-          skin_skeleton.ref_skin->set_bindToModel(transformMatrixes[0].transpose4x4());
+          scene.set_bind_to_model(skin_skeleton.ref_skin, transformMatrixes[0].transpose4x4());
           //Post process everything!
           unsigned int number_bones = bone_array.size();
 
           for (unsigned int i_bone = 0; i_bone < number_bones; ++i_bone){
-            atom_t atom_bone = bone_array[i_bone];
-            scene_node *current_bone = dict_bone_nodes[app_utils::get_atom_name(bone_array[i_bone])];
+            if (!dict_bone_nodes.contains(bone_array[i_bone])){
+              no_error = false;
+              printf("(((ERROR: A bone of the BoneRefArray is not a BoneNode!)))\n");
+              break;
+            }
+            scene_node *current_bone = dict_bone_nodes[bone_array[i_bone]];
             scene_node *bone_parent = current_bone->get_parent();
             int parent;
             if (bone_parent == NULL){
@@ -2460,21 +2476,169 @@ namespace octet
             else{
               parent = skin_skeleton.ref_skeleton->get_bone_index(bone_parent->get_sid());
             }
-            skin_skeleton.ref_skeleton->add_bone(current_bone, parent);
-            skin_skeleton.ref_skin->add_joint(bindToModel[i_bone], current_bone->get_sid());
+            scene.add_bone(skin_skeleton.ref_skeleton, current_bone, parent);
+            scene.add_joint(skin_skeleton.ref_skin, bindToModel[i_bone], current_bone->get_sid());
+          }
+        }
+        return no_error;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will create the mesh_instances of a Mesh, one for each instance of its object and each IndexArray
+      /// @param  objectRef This is the atom of the name of the object that contains this mesh!
+      /// @param  valuePrimitive The primitive of the mesh (GL_TRIANGLES...)
+      /// @param  vertices The vertices of the mesh, and the number of them
+      /// @param  texcoord False if there was no texcoord VertexArray (then the uv of all the vertices is (0, 1))
+      /// @param  indices The indices of each IndexArray, the number of them and the index of their material
+      /// @param  skin_skeleton The skin and skeleton of the mesh (NULL if it has not)
+      ///   It's used with the Meshes of the tree and with the ones read by the model (check openGEX_model.h)
+      ///   There is one mesh for each IndexArray, shared by all the instances, and all of them use the vertex buffer
+      ///   of the first one (so the vertices are stored once, whatever the number of IndexArrays and instances)
+      ///   With set_instancing, the instances of an object used by more than one node are added to an instanced mesh
+      ///   With set_vertex_welding, the vertices that are the same are welded first (check openGEX_welder.h)
+      ///   With set_mesh_optimization, the triangles and the vertices are optimized first (check openGEX_optimizer.h)
+      ///   With set_vertex_format, the vertices are encoded in a compact layout (not the skinned ones)
+      ////////////////////////////////////////////////////////////////////////////////
+      void openGEX_mesh_instances(int objectRef, uint16_t valuePrimitive, mesh::vertex * vertices, int num_vertexes, bool texcoord, dynarray<uint32_t *> &indices, dynarray<int> &num_indices, dynarray<unsigned int> &material_indexes, ref_skin_skeleton &skin_skeleton){
+        int numIndexArray = (int)indices.size();
+        unsigned int num_objects = info_meshes_from_objectRef.contains(objectRef) ? info_meshes_from_objectRef[objectRef].size() : 0;
+        //First, create the meshes, filled with the info that we have (if we don't have some info, it's added manually)
+        dynarray<ref<mesh>> meshes;
+        int format = openGEX_vertex_format::VERTEX_FLOAT;
+        if (num_objects > 0 && numIndexArray > 0){
+          //The vertices are welded and the triangles are optimized before creating the mesh (check openGEX_welder.h and
+          //openGEX_optimizer.h), then the vertices and indices used are the ones of the welder or the optimizer
+          int num_read = num_vertexes;
+          if (welding_mode != openGEX_vertex_welder::WELD_NONE && welder.weld(welding_mode, welding_epsilon, texcoord, vertices, num_vertexes, indices, num_indices))
+            printf("The vertices of the Mesh of %s were welded: %i -> %i\n", app_utils::get_atom_name(get_octet_atom(objectRef)), num_read, num_vertexes);
+          if (use_optimization && valuePrimitive == GL_TRIANGLES && optimizer.optimize(vertices, num_vertexes, indices, num_indices)){
+            const openGEX_cache_stats &before = optimizer.get_stats_before();
+            const openGEX_cache_stats &after = optimizer.get_stats_after();
+            printf("The Mesh of %s was optimized: %u degenerate triangles removed, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", app_utils::get_atom_name(get_octet_atom(objectRef)),
+              optimizer.get_num_degenerates(), before.get_acmr(), after.get_acmr(), before.get_atvr(), after.get_atvr());
+          }
+          //The skin of octet works with the float vertices, so the skinned meshes keep them
+          format = skin_skeleton.ref_skin == NULL ? vertex_format : (int)openGEX_vertex_format::VERTEX_FLOAT;
+          meshes.resize(numIndexArray);
+          meshes[0] = scene.new_mesh(skin_skeleton.ref_skin, valuePrimitive, vertices, num_vertexes, texcoord, indices[0], num_indices[0], format);
+          for (int index_i = 1; index_i < numIndexArray; ++index_i)
+            meshes[index_i] = scene.new_submesh(meshes[0], skin_skeleton.ref_skin, valuePrimitive, indices[index_i], num_indices[index_i], format);
+        }
+        //With instancing, the instances of an object used by more than one node go to an instanced mesh, not to the dictionary
+        //(the skinned meshes are not instanced, every instance has its own pose)
+        dynarray<ref<openGEX_instanced_mesh>> instanced_meshes;
+        if (use_instancing && num_objects > 1 && skin_skeleton.ref_skeleton == NULL){
+          instanced_meshes.resize(numIndexArray);
+          for (int index_i = 0; index_i < numIndexArray; ++index_i){
+            instanced_meshes[index_i] = scene.new_instanced_mesh(meshes[index_i], format);
+            document_instanced_meshes.push_back(instanced_meshes[index_i]);
+          }
+        }
+        //It has to process for every single 
+        for (unsigned int index_objects = 0; index_objects < num_objects; ++index_objects){
+          info_mesh_instance *info_current_object = info_meshes_from_objectRef[objectRef][index_objects];
+          //Now create a mesh_isntance for every single IndexArray!
+          for (int index_i = 0; index_i < numIndexArray; ++index_i){
+            bool add_later_material = false;
+            mesh *current_mesh = meshes[index_i];
+            mesh_instance * current_mesh_instance;
+            //Now, obtain the material!
+            //This is the material of this mesh
+            material *current_material = 0;
+            int current_ref_material = info_current_object->ref_materials[material_indexes[index_i]];
+            //If there is no material, add the default material
+            if (current_ref_material < 0){
+              current_material = scene.new_material(vec4(0.5, 0, 0));
+              //Now, finally, create the mesh_instance! (with the skeleton, if there is one)
+              current_mesh_instance = scene.new_mesh_instance(info_current_object->node, current_mesh, current_material, skin_skeleton.ref_skeleton);
+            }
+            else{//if there is a material, is more complex, so add the references if it has not been already obtained
+                //Check if it's been obtained already or not
+              if (ref_materials.contains(current_ref_material)){
+                current_material = ref_materials[current_ref_material];
+                if (current_material == NULL)
+                  add_later_material = true;
+              }
+              else{ //It's NULL!
+                add_later_material = true;
+              }
+              //Now, finally, create the mesh_instance! (with the skeleton, if there is one)
+              current_mesh_instance = scene.new_mesh_instance(info_current_object->node, current_mesh, current_material, skin_skeleton.ref_skeleton);
+              if (add_later_material){
+                current_material = NULL;
+                ref_materials[current_ref_material] = current_material;
+                ref_materials_inv[current_ref_material].push_back(current_mesh_instance);
+              }
+            }
+            if (instanced_meshes.size() > 0){
+              scene.add_instance(instanced_meshes[index_i], current_mesh_instance);
+              continue;
+            }
+            //The mesh_instances of the IndexArrays after the first one have the number of the IndexArray after the name
+            const char *name = app_utils::get_atom_name(info_current_object->name);
+            if (index_i > 0){
+              dynarray<char> new_name;
+              get_indexed_name(new_name, name, index_i);
+              scene.set_resource(dict, new_name.data(), current_mesh_instance);
+            }
+            else{
+              scene.set_resource(dict, name, current_mesh_instance);
+            }
           }
         }
+        //The instanced meshes have the name of the object, without the $ (and the number of the IndexArray after the first one)
+        for (unsigned int index_i = 0; index_i < instanced_meshes.size(); ++index_i){
+          const char *name = app_utils::get_atom_name(get_octet_atom(objectRef));
+          if (*name == '$' || *name == '%')
+            ++name;
+          if (index_i > 0){
+            dynarray<char> new_name;
+            get_indexed_name(new_name, name, index_i);
+            scene.set_resource(dict, new_name.data(), instanced_meshes[index_i]);
+          }
+          else{
+            scene.set_resource(dict, name, instanced_meshes[index_i]);
+          }
+        }
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will obtain all the info from a Mesh read by the model (check openGEX_model.h)
+      /// @param  objectRef This is the atom of the name of the object that contains this mesh!
+      /// @param  record This is the Mesh, with its vertices and indices already in their final layout
+      /// @return True if everything went well, false if there was some problem (the errors were printed while lexing)
+      ////////////////////////////////////////////////////////////////////////////////
+      bool openGEX_Mesh(int objectRef, openGEX_mesh_record *record){
+        bool no_error = record->no_error;
+        ref_skin_skeleton skin_skeleton;
+        skin_skeleton.ref_skeleton = NULL;
+        skin_skeleton.ref_skin = NULL;
+        if (record->skin != NULL && check_skin_skeleton)
+          no_error = openGEX_Skin(skin_skeleton, record->skin, get_octet_atom(objectRef)) && no_error;
+        if (record->num_vertex_arrays >= 1){
+          //The indices are not copied, only the pointers to them
+          int numIndexArray = (int)record->index_arrays.size();
+          dynarray<uint32_t *> indices(numIndexArray);
+          dynarray<int> num_indices(numIndexArray);
+          dynarray<unsigned int> material_indexes(numIndexArray);
+          for (int i = 0; i < numIndexArray; ++i){
+            indices[i] = record->index_arrays[i]->indices.data();
+            num_indices[i] = (int)record->index_arrays[i]->indices.size();
+            material_indexes[i] = record->index_arrays[i]->material_index;
+          }
+          openGEX_mesh_instances(objectRef, record->primitive, record->vertices.data(), record->num_vertexes, record->texcoord, indices, num_indices, material_indexes, skin_skeleton);
+        }
         return no_error;
       }
 
       ////////////////////////////////////////////////////////////////////////////////
       /// @brief This will obtain all the info from a Mesh structure
-      /// @param  objectRef This is the name of the object that contains this mesh!
+      /// @param  objectRef This is the atom of the name of the object that contains this mesh!
       /// @param  lod Level of detail (it has to be different for any mesh in a same GeometryObject
       /// @param  structure This is the structure to be analized, it has to be Node.
       /// @return True if everything went well, false if there was some problem
       ////////////////////////////////////////////////////////////////////////////////
-      bool openGEX_Mesh(char * objectRef, int &lod, openDDL_identifier_structure *structure){
+      bool openGEX_Mesh(int objectRef, int &lod, openDDL_identifier_structure *structure){
         bool no_error = true;
         int tempID;
         uint16_t valuePrimitive = GL_TRIANGLES;
@@ -2483,13 +2647,13 @@ namespace octet
         for (int i = 0; i < numProperties; ++i){
           openDDL_properties *current_property;
           current_property = structure->get_property(i);
-          tempID = identifiers_.get_value(current_property->identifierID);
+          tempID = current_property->identifierID;
           switch (tempID){
-          case 45:
+          case gex_ident::prop_lod:
             //Property lod
             lod = current_property->literal.value.u_integer_literal_;
             break;
-          case 50:
+          case gex_ident::prop_primitive:
             //Property primitive
             //The primitives can ve different types (check enum Primitives)
             char * new_primitive;
@@ -2578,7 +2742,7 @@ namespace octet
           openDDL_identifier_structure *substructure = (openDDL_identifier_structure *)structure->get_substructure(i);
           tempID = substructure->get_identifierID();
           switch (tempID){
-          case 35://VertexArray
+          case gex_ident::id_VertexArray:
             ++numVertexArray;
             int current_attrib;
             //This will translate those words to the following values:
@@ -2596,17 +2760,17 @@ namespace octet
               break;
             }
             break;
-          case 12://IndexArray
+          case gex_ident::id_IndexArray:
             indices.push_back(NULL);
             material_indexes.push_back(0);
             num_indices.push_back(0);
             no_error = openGEX_IndexArray(indices[numIndexArray], num_indices[numIndexArray], material_indexes[numIndexArray], substructure);
             ++numIndexArray;
             break;
-          case 28://Skin
+          case gex_ident::id_Skin:
             if (numSkin == 0){
               ++numSkin;
-              if (check_skin_skeleton) no_error = openGEX_Skin(skin_skeleton, substructure, app_utils::get_atom(objectRef));
+              if (check_skin_skeleton) no_error = openGEX_Skin(skin_skeleton, substructure, get_octet_atom(objectRef));
             }
             else{
               no_error = false;
@@ -2623,111 +2787,9 @@ namespace octet
           no_error = false;
           printf("(((ERROR: The structure Mesh has to have one VertexArray substructure)))\n");
         }
-        else{ 
+        else{
           //Post processing after reading all the substructures!
-          unsigned int num_objects = info_meshes_from_objectRef[objectRef].size();
-          //It has to process for every single 
-          for (unsigned int index_objects = 0; index_objects < num_objects; ++index_objects){
-            info_mesh_instance *info_current_object = info_meshes_from_objectRef[objectRef][index_objects];
-            //Now create a mesh_isntance for every single IndexArray!
-            for (int index_i = 0; index_i < numIndexArray; ++index_i){
-              bool add_later_material = false;
-              //First, create the mesh!
-              mesh *current_mesh = new mesh(skin_skeleton.ref_skin); 
-              mesh_instance * current_mesh_instance;
-              current_mesh->allocate(sizeof(mesh::vertex) * num_vertexes, sizeof(uint32_t) * num_indices[index_i]);
-              current_mesh->set_num_indices(num_indices[index_i]);
-              current_mesh->set_num_vertices(num_vertexes);
-              current_mesh->set_mode(valuePrimitive);
-              current_mesh->add_attribute(attribute_pos, 3, GL_FLOAT, 0);
-              current_mesh->add_attribute(attribute_normal, 3, GL_FLOAT, 12);
-              current_mesh->add_attribute(attribute_uv, 2, GL_FLOAT, 24);
-              //Now fill it with the info that we have (if we don't have some info, add it manually)
-              current_mesh->set_params(sizeof(mesh::vertex), num_indices[index_i], num_vertexes, valuePrimitive, GL_UNSIGNED_INT);
-              gl_resource::wolock vl(current_mesh->get_vertices());
-              gl_resource::wolock il(current_mesh->get_indices());
-              uint32_t *idx = il.u32();
-              mesh::vertex *vtx = (mesh::vertex *)vl.f32();
-              if (texcoord)
-                for (int i = 0; i < num_vertexes; ++i){
-                  vtx[i] = vertices[i];
-                }
-              else
-                for (int i = 0; i < num_vertexes; ++i){
-                  vtx[i] = vertices[i];
-                  vtx[i].uv = vec2(0, 1);
-                }
-              for (int i = 0; i < num_indices[index_i]; ++i){
-                idx[i] = indices[index_i][i];
-              }
-              //Now, obtain the material!
-              //This is the material of this mesh
-              material *current_material = 0;
-              char *current_ref_material = info_current_object->ref_materials[material_indexes[index_i]];
-              //If there is no material, add the default material
-              if (current_ref_material == "_DE_FA_UL_T"){
-                current_material = new material(vec4(0.5, 0, 0));
-                //Now, finally, create the mesh_instance!
-                //If there is no skeleton
-                if (skin_skeleton.ref_skeleton == NULL)
-                  current_mesh_instance = new mesh_instance(info_current_object->node, current_mesh, current_material);
-                else{
-                  //current_mesh_instance = new mesh_instance(info_current_object->node, current_mesh, current_material);
-                  current_mesh_instance = new mesh_instance(info_current_object->node, current_mesh, current_material, skin_skeleton.ref_skeleton);
-                }
-                const char *name = app_utils::get_atom_name(info_current_object->name);
-                char *new_name = new char[20];
-                if (index_i > 0){
-                  new_name[0] = get_char_from_int(index_i);
-                  for (int i = 1; i < 20 && *name != '/0'; ++i){
-                    new_name[i] = *name;
-                    ++name;
-                  }
-                  dict->set_resource(new_name, current_mesh_instance);
-                }
-                else{
-                  dict->set_resource(name, current_mesh_instance);
-                }
-              }
-              else{//if there is a material, is more complex, so add the references if it has not been already obtained
-                  //Check if it's been obtained already or not
-                if (ref_materials[current_ref_material]){
-                  current_material = ref_materials[current_ref_material];
-                  if (current_material == NULL)
-                    add_later_material = true;
-                }
-                else{ //It's NULL!
-                  add_later_material = true;
-                }
-                //Now, finally, create the mesh_instance!
-                //If there is no skeleton
-                if (skin_skeleton.ref_skeleton == NULL)
-                  current_mesh_instance = new mesh_instance(info_current_object->node, current_mesh, current_material);
-                else{
-                  //current_mesh_instance = new mesh_instance(info_current_object->node, current_mesh, current_material);
-                  current_mesh_instance = new mesh_instance(info_current_object->node, current_mesh, current_material, skin_skeleton.ref_skeleton);
-                }
-                if (add_later_material){
-                  current_material = NULL;
-                  ref_materials[current_ref_material] = current_material;
-                  ref_materials_inv[current_ref_material].push_back(current_mesh_instance);
-                }
-                const char *name = app_utils::get_atom_name(info_current_object->name);
-                char *new_name = new char[20];
-                if (index_i > 0){
-                  new_name[0] = get_char_from_int(index_i);
-                  for (int i = 1; i < 20 && *name != '/0'; ++i){
-                    new_name[i] = *name;
-                    ++name;
-                  }
-                  dict->set_resource(new_name, current_mesh_instance);
-                }
-                else{
-                    dict->set_resource(name, current_mesh_instance);
-                }
-              }
-            }
-          }
+          openGEX_mesh_instances(objectRef, valuePrimitive, vertices, num_vertexes, texcoord, indices, num_indices, material_indexes, skin_skeleton);
         }
         return no_error;
       }
@@ -2750,8 +2812,8 @@ namespace octet
         }
         else if (numProperties == 1){
           openDDL_properties * current_property = structure->get_property(0);
-          tempID = identifiers_.get_value(current_property->identifierID);
-          if (tempID == 55){
+          tempID = current_property->identifierID;
+          if (tempID == gex_ident::prop_two_sided){
             two_sided = current_property->literal.value.bool_;
           }
           else{
@@ -2763,6 +2825,7 @@ namespace octet
         int numSubstructures = structure->get_number_substructures();
         char * nameNode = NULL;
         int sizeName = 0;
+        int atomNode = -1;
         vec4 value_color;
         GEX_ATTRIB value_attrib;
         float param_value;
@@ -2777,23 +2840,23 @@ namespace octet
           openDDL_identifier_structure *substructure = (openDDL_identifier_structure *)structure->get_substructure(i);
           tempID = substructure->get_identifierID();
           switch (tempID){
-          case 21: //Name
+          case gex_ident::id_Name:
             if (numNames == 0){
               ++numNames;
-              no_error = openGEX_Name(nameNode, sizeName, substructure);
+              no_error = openGEX_Name(nameNode, sizeName, atomNode, substructure);
             }
             else{
               no_error = false;
               printf("(((ERROR: The structure Material can only have as substructure a Mesh)))\n");
             }
             break;
-          case 9:  //Color
+          case gex_ident::id_Color:
             no_error = openGEX_Color(value_color, value_attrib, substructure);
             break;
-          case 24: //Param
+          case gex_ident::id_Param:
             no_error = openGEX_Param(param_value, param_type, substructure);
             break;
-          case 29: //Texture
+          case gex_ident::id_Texture:
             no_error = openGEX_Texture(texture_url, size_url, index_texture, type_texture, substructure);
             break;
           default:
@@ -2805,19 +2868,23 @@ namespace octet
         //Post process all that info a material of octet
         material * new_material;
         if (texture_url != NULL){ //if the material has a texture
-          new_material = new material(new image(texture_url));
+          new_material = scene.new_material(texture_url);
         }
         else{//It has no texture
-          new_material = new material(value_color);
+          new_material = scene.new_material(value_color);
         }
         //And copy all that into the dict and the mesh_instances referenced
         if (numNames == 0){ //if it has no name, add the name of the structure!
           nameNode = name;
+          atomNode = structure->get_nameID();
         }
-        dict->set_resource(nameNode, new_material);
-        int num_instances = ref_materials_inv[name].size();
-        for (int i = 0; i < num_instances; ++i){
-          ref_materials_inv[name][i]->set_material(new_material);
+        scene.set_resource(dict, nameNode, new_material);
+        int material_atom = structure->get_nameID();
+        if (ref_materials_inv.contains(material_atom)){
+          int num_instances = ref_materials_inv[material_atom].size();
+          for (int i = 0; i < num_instances; ++i){
+            scene.set_material(ref_materials_inv[material_atom][i], new_material);
+          }
         }
 
         return no_error;
@@ -2842,41 +2909,36 @@ namespace octet
         dynarray<mesh_instance *> mesh_instances;
         mesh_instance * current_mesh_instance;
         current_mesh_instance = new mesh_instance;
-        //Creating new node
-        scene_node *node;
-        node = new scene_node();
+        //Creating new node (it's added to his father if it's not a Top-Level class)
+        scene_node *node = scene.new_node(father);
         //Assign that to the current info
         //Obtain the name of the structure
         char * name = structure->get_name();
-        node->set_sid(app_utils::get_atom(name));
+        scene.set_node_sid(node, get_octet_atom(structure->get_nameID()));
         info_current_instance->node = node;
         unsigned int capacity_materials = 5;
         info_current_instance->ref_materials.resize(capacity_materials);
         for (int i = 0; i < 5; ++i){
-          info_current_instance->ref_materials[i] = NULL;
-        }
-        //If it's not a Top-Level class, add it to his father
-        if (father != NULL){
-          father->add_child(node);
+          info_current_instance->ref_materials[i] = -1;
         }
         //Obtain the properties (may not have)
         int numProperties = structure->get_number_properties();
         for (int i = 0; i < numProperties; ++i){
           openDDL_properties *current_property;
           current_property = structure->get_property(i);
-          tempID = identifiers_.get_value(current_property->identifierID);
+          tempID = current_property->identifierID;
           switch (tempID){
-          case 57:
+          case gex_ident::prop_visible:
             //Property visible
             values_specified[0] = true;
             values_properties[0] = current_property->literal.value.bool_;
             break;
-          case 52:
+          case gex_ident::prop_shadow:
             //Property shadow
             values_specified[1] = true;
             values_properties[1] = current_property->literal.value.bool_;
             break;
-          case 48:
+          case gex_ident::prop_motion_blur:
             //Property motion_blur
             values_specified[2] = true;
             values_properties[2] = current_property->literal.value.bool_;
@@ -2907,9 +2969,10 @@ namespace octet
         int num_mat_index = 0;
         char * nameNode = NULL;
         int sizeName = 0;
+        int atomNode = -1;
         bool object_only = false;
-        char * object_ref = NULL;
-        char * ref_material = NULL;
+        int object_ref = -1;
+        int ref_material = -1;
 
         //Check all the substructures
         for (int i = 0; i < numSubstructures; ++i){
@@ -2919,22 +2982,22 @@ namespace octet
           tempID = substructure->get_identifierID();
           switch (tempID){
           //Get Name (may not have)
-          case 21://Name
+          case gex_ident::id_Name:
             if (numNames == 0){
               ++numNames;
-              no_error = openGEX_Name(nameNode, sizeName, substructure);
-              info_current_instance->name = app_utils::get_atom(nameNode);
+              no_error = openGEX_Name(nameNode, sizeName, atomNode, substructure);
+              info_current_instance->name = get_octet_atom(atomNode);
             }
             else{
               printf("(((ERROR: It has more than one Morph, it can only have one (or none)!!!)))\n");
             }
             break;
           //Get ObjectRef (geometryObject) (only 1)
-          case 23://ObjectRef
+          case gex_ident::id_ObjectRef:
             if (numObjectRef == 0){
               ++numObjectRef;
               no_error = openGEX_ObjectRef(object_ref, substructure);
-              if (!info_meshes_from_objectRef.contains(object_ref))
+              if (object_ref >= 0 && !info_meshes_from_objectRef.contains(object_ref))
                 info_meshes_from_objectRef[object_ref];
               else{
                 //Think what will do here TODO
@@ -2945,10 +3008,10 @@ namespace octet
             }
             break;
           //Get MaterialRef
-          case 17://MaterialRef
+          case gex_ident::id_MaterialRef:
             mat_index = 0;
             no_error = openGEX_MaterialRef(ref_material, mat_index, substructure);
-            if (!ref_materials.contains(ref_material))
+            if (ref_material >= 0 && !ref_materials.contains(ref_material))
               ref_materials[ref_material] = NULL;
             else{
               //Think what will do here TODO
@@ -2958,13 +3021,13 @@ namespace octet
               mat_index += 5;
               info_current_instance->ref_materials.resize(mat_index);
               for (unsigned int i = mat_index - 5 ; i < mat_index ; ++i){
-                info_current_instance->ref_materials[i] = NULL;
+                info_current_instance->ref_materials[i] = -1;
               }
             }
             info_current_instance->ref_materials[mat_index] = ref_material;
             break;
           //Get Morph (may have one or none)
-          case 20://Morph
+          case gex_ident::id_Morph:
             if (numMorph == 0){
               ++numMorph;
               no_error = openGEX_Morph(values, numValues, substructure);
@@ -2974,52 +3037,52 @@ namespace octet
             }
             break;
           //Get Transforms (may not have)
-          case 32://Transform
+          case gex_ident::id_Transform:
             no_error = openGEX_Transform(current_ref, transformMatrixes, object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 33://Translation
+          case gex_ident::id_Translation:
             no_error = openGEX_Translate(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 25://Rotation
+          case gex_ident::id_Rotation:
             no_error = openGEX_Rotate(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 26://Scale
+          case gex_ident::id_Scale:
             no_error = openGEX_Scale(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
           //Get Animation
-          case 0://Animation
+          case gex_ident::id_Animation:
             if (check_animation)
               no_error = openGEX_Animation(list_ref, substructure, node);
             break;
           //Get Nodes (children)
-          case 4://BoneNode
+          case gex_ident::id_BoneNode:
             no_error = openGEX_BoneNode(substructure, node);
             break;
-          case 7://CameraNode
+          case gex_ident::id_CameraNode:
             //IGNORE CAMERAS FOR NOW!!!! TO DO!
             break;
-          case 10://GeometryNode
+          case gex_ident::id_GeometryNode:
             no_error = openGEX_GeometryNode(substructure, node);
             break;
-          case 14://LightNode
+          case gex_ident::id_LightNode:
             //IGNORE LIGHTS FOR NOW!!!! TO DO!
             break;
-          case 22://Nodes
+          case gex_ident::id_Node:
             no_error = openGEX_Node(substructure, node);
             break;
           }
         }
         //Sum up after reading all substructures
         if (num_mat_index == 0){ //If it has no Material... add a default material
-          info_current_instance->ref_materials[0] = "_DE_FA_UL_T";
+          info_current_instance->ref_materials[0] = -1;
         }
         if (numObjectRef != 1){
           printf("(((ERROR!! The GeometricNode structure has to have one ObjectRef!)))\n");
@@ -3028,12 +3091,14 @@ namespace octet
           if (numNames == 0){ //it has no name, so get the structure name
             if (DEBUGOPENGEX) printf("As it has no name, assign the structure name \n");
             nameNode = name;
+            atomNode = structure->get_nameID();
           }
           // We are working with transpose matrix in octet!!!
-          node->access_nodeToParent().multMatrix(nodeToParent.transpose4x4());
+          scene.transform_node(node, nodeToParent.transpose4x4());
           //Add the id for the animations
-          node->set_sid(app_utils::get_atom(nameNode));
-          info_meshes_from_objectRef[object_ref].push_back(info_current_instance);
+          scene.set_node_sid(node, get_octet_atom(atomNode));
+          if (object_ref >= 0)
+            info_meshes_from_objectRef[object_ref].push_back(info_current_instance);
         }
         return no_error;
       }
@@ -3051,26 +3116,24 @@ namespace octet
         //Creating matrix of transforms
         mat4t nodeToParent;
         nodeToParent.loadIdentity(); //and initialize it to identity!
-        //Obtain the name of the structure
-        char * name = structure->get_name();
         //Obtain the properties (may not have)
         int numProperties = structure->get_number_properties();
         for (int i = 0; i < numProperties; ++i){
           openDDL_properties *current_property;
           current_property = structure->get_property(i);
-          tempID = identifiers_.get_value(current_property->identifierID);
+          tempID = current_property->identifierID;
           switch (tempID){
-          case 57:
+          case gex_ident::prop_visible:
             //Property visible
             values_specified[0] = true;
             values_properties[0] = current_property->literal.value.bool_;
             break;
-          case 52:
+          case gex_ident::prop_shadow:
             //Property shadow
             values_specified[1] = true;
             values_properties[1] = current_property->literal.value.bool_;
             break;
-          case 48:
+          case gex_ident::prop_motion_blur:
             //Property motion_blur
             values_specified[2] = true;
             values_properties[2] = current_property->literal.value.bool_;
@@ -3080,6 +3143,14 @@ namespace octet
             break;
           }
         }
+        //If the model read this GeometryObject, its meshes are in the record (the structure has no substructures)
+        openGEX_geometry_record *record = model.get_record(structure);
+        if (record != NULL){
+          no_error = record->no_error;
+          for (unsigned int i = 0; i < record->meshes.size() && no_error; ++i)
+            no_error = openGEX_Mesh(structure->get_nameID(), record->meshes[i]);
+          return no_error;
+        }
         //Check substructures
         int numSubstructures = structure->get_number_substructures();
         dynarray<int> lod(numSubstructures);
@@ -3087,9 +3158,9 @@ namespace octet
         for (int i = 0; i < numSubstructures && no_error; ++i){
           openDDL_identifier_structure *substructure = (openDDL_identifier_structure *)structure->get_substructure(i);
           tempID = substructure->get_identifierID();
-          if (tempID == 18){//Mesh
+          if (tempID == gex_ident::id_Mesh){
             lod[i] = 0;
-            no_error = openGEX_Mesh(name, lod[i], substructure);
+            no_error = openGEX_Mesh(structure->get_nameID(), lod[i], substructure);
           }
           else{
             no_error = false;
@@ -3116,18 +3187,13 @@ namespace octet
         ref<info_camera_instance> info_current_instance = new info_camera_instance;
         camera_instance * current_camera_instance;
         current_camera_instance = new camera_instance;
-        //Creating new node
-        scene_node *node;
-        node = new scene_node();
+        //Creating new node (it's added to his father if it's not a Top-Level class)
+        scene_node *node = scene.new_node(father);
         //Assign that to the current info
         //Obtain the name of the structure
         char * name = structure->get_name();
-        node->set_sid(app_utils::get_atom(name));
+        scene.set_node_sid(node, get_octet_atom(structure->get_nameID()));
         info_current_instance->node = node;
-        //If it's not a Top-Level class, add it to his father
-        if (father != NULL){
-          father->add_child(node);
-        }
         //Camera node has no properties
         //Check substructures
         int numSubstructures = structure->get_number_substructures();
@@ -3148,9 +3214,10 @@ namespace octet
         int num_mat_index = 0;
         char * nameNode = NULL;
         int sizeName = 0;
+        int atomNode = -1;
         bool object_only = false;
-        char * object_ref = NULL;
-        char * ref_material = NULL;
+        int object_ref = -1;
+        int ref_material = -1;
 
         //Check all the substructures
         for (int i = 0; i < numSubstructures; ++i){
@@ -3160,22 +3227,22 @@ namespace octet
           tempID = substructure->get_identifierID();
           switch (tempID){
             //Get Name (may not have)
-          case 21://Name
+          case gex_ident::id_Name:
             if (numNames == 0){
               ++numNames;
-              no_error = openGEX_Name(nameNode, sizeName, substructure);
-              info_current_instance->name = app_utils::get_atom(nameNode);
+              no_error = openGEX_Name(nameNode, sizeName, atomNode, substructure);
+              info_current_instance->name = get_octet_atom(atomNode);
             }
             else{
               printf("(((ERROR: It has more than one Morph, it can only have one (or none)!!!)))\n");
             }
             break;
             //Get ObjectRef (geometryObject) (only 1)
-          case 23://ObjectRef
+          case gex_ident::id_ObjectRef:
             if (numObjectRef == 0){
               ++numObjectRef;
               no_error = openGEX_ObjectRef(object_ref, substructure);
-              if (!info_cameras_from_objectRef.contains(object_ref))
+              if (object_ref >= 0 && !info_cameras_from_objectRef.contains(object_ref))
                 info_cameras_from_objectRef[object_ref];
               else{
                 //Think what will do here TODO
@@ -3186,45 +3253,45 @@ namespace octet
             }
             break;
             //Get Transforms (may not have)
-          case 32://Transform
+          case gex_ident::id_Transform:
             no_error = openGEX_Transform(current_ref, transformMatrixes, object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 33://Translation
+          case gex_ident::id_Translation:
             no_error = openGEX_Translate(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 25://Rotation
+          case gex_ident::id_Rotation:
             no_error = openGEX_Rotate(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
-          case 26://Scale
+          case gex_ident::id_Scale:
             no_error = openGEX_Scale(current_ref, transformMatrixes[0], object_only, substructure);
             nodeToParent.multMatrix(transformMatrixes[0]);
             list_ref.push_back(current_ref);
             break;
             //Get Animation
-          case 0://Animation
+          case gex_ident::id_Animation:
             if (check_animation)
               no_error = openGEX_Animation(list_ref, substructure, node);
             break;
             //Get Nodes (children)
-          case 4://BoneNode
+          case gex_ident::id_BoneNode:
             no_error = openGEX_BoneNode(substructure, node);
             break;
-          case 7://CameraNode
+          case gex_ident::id_CameraNode:
             no_error = openGEX_CameraNode(substructure, node);
             break;
-          case 10://GeometryNode
+          case gex_ident::id_GeometryNode:
             no_error = openGEX_GeometryNode(substructure, node);
             break;
-          case 14://LightNode
+          case gex_ident::id_LightNode:
             //IGNORE LIGHTS FOR NOW!!!! TO DO!
             break;
-          case 22://Nodes
+          case gex_ident::id_Node:
             no_error = openGEX_Node(substructure, node);
             break;
           }
@@ -3238,12 +3305,14 @@ namespace octet
           if (numNames == 0){ //it has no name, so get the structure name
             if (DEBUGOPENGEX) printf("As it has no name, assign the structure name \n");
             nameNode = name;
+            atomNode = structure->get_nameID();
           }
           // We are working with transpose matrix in octet!!!
-          node->access_nodeToParent().multMatrix(nodeToParent.transpose4x4());
+          scene.transform_node(node, nodeToParent.transpose4x4());
           //Add the id for the animations
-          node->set_sid(app_utils::get_atom(nameNode));
-          info_cameras_from_objectRef[object_ref].push_back(info_current_instance);
+          scene.set_node_sid(node, get_octet_atom(atomNode));
+          if (object_ref >= 0)
+            info_cameras_from_objectRef[object_ref].push_back(info_current_instance);
         }
         return no_error;
       }
@@ -3272,7 +3341,7 @@ namespace octet
         for (int i = 0; i < numSubstructures && no_error; ++i){
           openDDL_identifier_structure *substructure = (openDDL_identifier_structure *)structure->get_substructure(i);
           tempID = substructure->get_identifierID();
-          if (tempID == 24){//Param
+          if (tempID == gex_ident::id_Param){
             no_error = openGEX_Param(param_value[i], param_type[i], substructure);
           }
           else{
@@ -3302,22 +3371,22 @@ namespace octet
 
         if (structure->get_father_structure() == NULL){ //It's a top-level structure!
           switch (tempID){
-          case 19: //Metric 
+          case gex_ident::id_Metric:
             if (DEBUGOPENGEX) printf("Metric\n");
             //Process Metric structure
             no_error = openGEX_Metric(structure);
             break;
-          case 10: //GeometryNode 
+          case gex_ident::id_GeometryNode:
             if (DEBUGOPENGEX) printf("GeometryNode\n");
             //Process GeometryNode structure
             no_error = openGEX_GeometryNode(structure);
             break;
-          case 11: //GeometryObject
+          case gex_ident::id_GeometryObject:
             if (DEBUGOPENGEX) printf("GeometryObject\n");
             //Process GeometryObject structure
             no_error = openGEX_GeometryObject(structure);
             break;
-          case 16: //Material
+          case gex_ident::id_Material:
             if (DEBUGOPENGEX) printf("Material\n");
             //Process Material structure
             no_error = openGEX_Material(structure);
@@ -3326,7 +3395,7 @@ namespace octet
             if (DEBUGOPENGEX) printf("BoneNode\n");
             no_error = openGEX_BoneNode(structure);
             break;
-          case 22: //Node
+          case gex_ident::id_Node:
             if (DEBUGOPENGEX) printf("BoneNode\n");
             no_error = openGEX_Node(structure);
             break;
@@ -3365,6 +3434,92 @@ namespace octet
       openGEX_parser(){
         init_ddl();
         init_gex();
+        use_instancing = false;
+        use_optimization = false;
+        welding_mode = openGEX_vertex_welder::WELD_NONE;
+        welding_epsilon = 0.0f;
+        vertex_format = openGEX_vertex_format::VERTEX_FLOAT;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will choose if the GeometryObjects are read into typed records instead of the tree
+      /// @param  enable  True to read the meshes straight into their vertices and indices (check openGEX_model.h)
+      ///   The rest of the document is the tree of always, and with false all the document is the tree (for the tools)
+      ////////////////////////////////////////////////////////////////////////////////
+      void set_typed_geometry(bool enable){
+        set_schema(enable ? &model : NULL);
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will choose if the nodes that use the same GeometryObject are instanced
+      /// @param  enable  True to add an openGEX_instanced_mesh to the dictionary instead of their mesh_instances
+      ///   It's only for the objects used by more than one GeometryNode, and not skinned (check openGEX_instancing.h)
+      ////////////////////////////////////////////////////////////////////////////////
+      void set_instancing(bool enable){
+        use_instancing = enable;
+      }
+
+      bool get_instancing() const{
+        return use_instancing;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will choose if the triangles and the vertices of the meshes are optimized after reading them
+      /// @param  enable  True to remove the degenerate triangles and reorder them for the cache and the overdraw
+      ///   The stats of the cache of every mesh are printed (check openGEX_optimizer.h)
+      ////////////////////////////////////////////////////////////////////////////////
+      void set_mesh_optimization(bool enable){
+        use_optimization = enable;
+      }
+
+      bool get_mesh_optimization() const{
+        return use_optimization;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will choose if the vertices of the meshes that are the same are welded after reading them
+      /// @param  mode  WELD_NONE, WELD_EXACT or WELD_EPSILON (check openGEX_welder.h), any other mode is WELD_NONE
+      /// @param  epsilon  How far the components of the vertices can be to be welded (only with WELD_EPSILON)
+      ////////////////////////////////////////////////////////////////////////////////
+      void set_vertex_welding(int mode, float epsilon = 0.0f){
+        welding_mode = mode == openGEX_vertex_welder::WELD_EXACT || mode == openGEX_vertex_welder::WELD_EPSILON ? mode : (int)openGEX_vertex_welder::WELD_NONE;
+        welding_epsilon = welding_mode == openGEX_vertex_welder::WELD_EPSILON ? epsilon : 0.0f;
+      }
+
+      int get_vertex_welding() const{
+        return welding_mode;
+      }
+
+      float get_welding_epsilon() const{
+        return welding_epsilon;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will choose the layout of the vertices of the meshes
+      /// @param  format  VERTEX_FLOAT (32 bytes), VERTEX_COMPACT (16 bytes) or VERTEX_SMALL (12 bytes)
+      ///   With the compact layouts the positions are in the AABB of the mesh, and the normals are octahedral, so
+      ///   the shaders have to decode them (check openGEX_vertex_format.h). The skinned meshes are always floats.
+      ////////////////////////////////////////////////////////////////////////////////
+      void set_vertex_format(int format){
+        vertex_format = format >= 0 && format < openGEX_vertex_format::NUM_VERTEX_FORMATS ? format : (int)openGEX_vertex_format::VERTEX_FLOAT;
+      }
+
+      int get_vertex_format() const{
+        return vertex_format;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will return the records of the GeometryObjects read by the model (with set_typed_geometry)
+      ////////////////////////////////////////////////////////////////////////////////
+      openGEX_model &get_model(){
+        return model;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief This will return the scene that creates the resources (to record them, and to save or replay them)
+      ////////////////////////////////////////////////////////////////////////////////
+      openGEX_scene &get_scene(){
+        return scene;
       }
 
       ////////////////////////////////////////////////////////////////////////////////
@@ -3376,6 +3531,14 @@ namespace octet
       ////////////////////////////////////////////////////////////////////////////////
       bool openGEX_data(resource_dict *new_dict, bool animation, bool skin_skeleton){
         dict = new_dict;
+        //The atoms are of the document, so the ones of the previous document are not valid anymore
+        info_meshes_from_objectRef.reset();
+        info_cameras_from_objectRef.reset();
+        dict_nodes.reset();
+        dict_bone_nodes.reset();
+        ref_materials.reset();
+        ref_materials_inv.reset();
+        document_instanced_meshes.reset();
         check_skin_skeleton = skin_skeleton;
         check_animation = animation;
         bool no_error = true;
@@ -3391,6 +3554,10 @@ namespace octet
           no_error = openGEX_structure(topLevelStructure);
         }
         if (DEBUGSTRUCTURE) printf("\n");
+        //The Materials after the nodes are already set to the instances, so the packed arrays can be filled
+        for (unsigned int i = 0; i < document_instanced_meshes.size(); ++i)
+          document_instanced_meshes[i]->update();
+        document_instanced_meshes.reset();
         return no_error;
       }
     };
@@ -0,0 +1,1017 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openGEX_scene.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the converted scene of an openGEX file, saved to load it again without converting anything
+///
+///   Even with the binary cache of the document (check openDDL_cache.h), openGEX_data builds the meshes, the
+///   materials, the skeletons and the animations every time. The parser creates all of them with the functions
+///   of openGEX_scene, and while it's recording, each one of them is saved as an operation (with its vertices,
+///   indices, matrices and keys in the payload). Loading the scene does the same operations again, with the
+///   vertices and indices copied in bulk, so the dictionary gets the same resources without reading the document.
+///   Like the cache of the document, there are no pointers in the blob (only offsets and indices of the objects),
+///   and it keeps the size, the time of modification and the hash of the source to know if it's still valid.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENGEX_SCENE_INCLUDED
+#define OPENGEX_SCENE_INCLUDED
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is the beginning of the blob, the offsets of the sections are from the beginning of the file
+  ///   The sections are aligned to 8 bytes: operations, strings, characters of the strings and payload
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openGEX_scene_header{
+        char magic[8];
+        // OPENGEX_SCENE_VERSION, and 0x01020304 written with the byte order of the machine that wrote the blob
+        uint32_t version;
+        uint32_t byte_order;
+        openDDL_cache_source source;
+        // The options of openGEX_data and of the parser used to convert the scene (the flags of openGEX_scene)
+        uint32_t flags;
+        uint32_t num_objects;
+        // The epsilon of the welding of the vertices (only with FLAG_WELD_EPSILON)
+        float welding_epsilon;
+        uint32_t unused;
+        uint64_t blob_size;
+        uint32_t num_operations;
+        uint32_t num_strings;
+        uint64_t operations_offset;
+        uint64_t strings_offset;
+        uint64_t chars_offset;
+        uint64_t payload_offset;
+        uint64_t payload_size;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is one operation of the scene (one of the enum of openGEX_scene)
+  ///   The operations that create a resource give it the next index of the objects, the others use these indices
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openGEX_scene_operation{
+        int32_t type;
+        // The indices of the objects used (-1 is NULL), or some numbers of the operation
+        int32_t args[5];
+        // The index of the strings used (names, atoms and urls), or -1
+        int32_t strings[3];
+        uint32_t unused;
+        // Two arrays of the payload (vertices and indices, times and values...), from the beginning of the payload
+        uint64_t offsets[2];
+        uint64_t sizes[2];
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This is one string of the blob, its characters (ended with \0) are in the section of characters
+  ////////////////////////////////////////////////////////////////////////////////
+      struct openGEX_scene_string{
+        uint64_t offset;
+        uint32_t size;
+        uint32_t unused;
+      };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class creates the resources of the scene, and records them while a scene is being converted
+  ///   The resources are not referenced by the recorder (nothing changes while recording). If one is released and
+  ///   its address is used again by a new one, the new one simply gets the address in the table of indices.
+  ////////////////////////////////////////////////////////////////////////////////
+      class openGEX_scene{
+        enum { MIN_SLOTS = 256 };
+        // What was created by each operation, to check the indices of the objects of a blob
+        enum { KIND_NODE = 0, KIND_MESH = 1, KIND_MATERIAL = 2, KIND_MESH_INSTANCE = 3, KIND_SKIN = 4,
+          KIND_SKELETON = 5, KIND_ANIMATION = 6, KIND_ANIMATION_INSTANCE = 7, KIND_INSTANCED_MESH = 8 };
+
+        bool recording;
+        // The resources created, the index is the one used by the operations
+        dynarray<resource *> objects;
+        // A hash table with open addressing from the address of a resource to its index (-1 is a free slot)
+        dynarray<resource *> slot_objects;
+        dynarray<int> slot_indices;
+        dynarray<openGEX_scene_operation> operations;
+        dynarray<openGEX_scene_string> strings;
+        dynarray<char> chars;
+        dynarray<uint8_t> payload;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a mesh with the layout of a vertex format, and copy its indices
+        /// @param  mesh_skin  The skin of the mesh (it can be NULL)
+        /// @param  mode  The primitive of the mesh (GL_TRIANGLES...)
+        /// @param  format  The layout of the vertices (check openGEX_vertex_format.h)
+        /// @param  num_vertexes  The number of vertices (they are not filled here)
+        /// @param  indices  The indices, and the number of them
+        ////////////////////////////////////////////////////////////////////////////////
+        static mesh * allocate_mesh(skin * mesh_skin, uint16_t mode, int format, int num_vertexes, const uint32_t * indices, int num_indices){
+          mesh * current_mesh = new mesh(mesh_skin);
+          unsigned int stride = openGEX_vertex_format::get_stride(format);
+          current_mesh->allocate(stride * num_vertexes, sizeof(uint32_t) * num_indices);
+          current_mesh->set_num_indices(num_indices);
+          current_mesh->set_num_vertices(num_vertexes);
+          current_mesh->set_mode(mode);
+          openGEX_vertex_format::add_attributes(current_mesh, format);
+          current_mesh->set_params(stride, num_indices, num_vertexes, mode, GL_UNSIGNED_INT);
+          if (num_indices > 0){
+            gl_resource::wolock il(current_mesh->get_indices());
+            memcpy(il.u32(), indices, sizeof(uint32_t) * num_indices);
+          }
+          return current_mesh;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the slot of a resource in the hash table
+        /// @return The slot with the resource, or the free slot where it has to be added
+        ////////////////////////////////////////////////////////////////////////////////
+        unsigned int find_slot(resource * object) const{
+          unsigned int mask = slot_objects.size() - 1;
+          uint64_t address = (uint64_t)(size_t)object;
+          unsigned int slot = (unsigned int)(((address >> 4) * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+          while (slot_indices[slot] >= 0 && slot_objects[slot] != object)
+            slot = (slot + 1) & mask;
+          return slot;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will double the number of slots, and put again all the resources in the table
+        ///   They are added in order, so if an address was used twice the slot keeps the last index
+        ////////////////////////////////////////////////////////////////////////////////
+        void grow(){
+          unsigned int new_size = slot_objects.size() < MIN_SLOTS ? MIN_SLOTS : slot_objects.size() * 2;
+          slot_objects.resize(new_size);
+          slot_indices.resize(new_size);
+          for (unsigned int i = 0; i < new_size; ++i)
+            slot_indices[i] = -1;
+          for (unsigned int i = 0; i < objects.size(); ++i){
+            unsigned int slot = find_slot(objects[i]);
+            slot_objects[slot] = objects[i];
+            slot_indices[slot] = (int)i;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will give the next index to a resource created by an operation
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_object(resource * object){
+          if ((objects.size() + 1) * 2 > slot_objects.size())
+            grow();
+          unsigned int slot = find_slot(object);
+          slot_objects[slot] = object;
+          slot_indices[slot] = (int)objects.size();
+          objects.push_back(object);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the index of a resource
+        /// @return The index of the resource, or -1 if it's NULL or it was not created by openGEX_scene
+        ////////////////////////////////////////////////////////////////////////////////
+        int find_object(resource * object) const{
+          if (object == NULL || slot_objects.size() == 0)
+            return -1;
+          return slot_indices[find_slot(object)];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a new operation
+        /// @param  type  The type of the operation (one of the enum)
+        /// @return The operation, with no objects and no strings. It's valid till the next operation is added
+        ////////////////////////////////////////////////////////////////////////////////
+        openGEX_scene_operation &add_operation(int type){
+          openGEX_scene_operation operation;
+          memset(&operation, 0, sizeof(operation));
+          operation.type = type;
+          for (int i = 0; i < 5; ++i)
+            operation.args[i] = -1;
+          for (int i = 0; i < 3; ++i)
+            operation.strings[i] = -1;
+          operations.push_back(operation);
+          return operations[operations.size() - 1];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a string to the blob
+        /// @param  name  The characters, ended with \0 (it can be NULL)
+        /// @return The index of the string, or -1 if it's NULL
+        ////////////////////////////////////////////////////////////////////////////////
+        int add_string(const char * name){
+          if (name == NULL)
+            return -1;
+          openGEX_scene_string string;
+          string.offset = chars.size();
+          string.size = (uint32_t)strlen(name);
+          string.unused = 0;
+          chars.resize((unsigned int)(string.offset + string.size + 1));
+          memcpy(chars.data() + string.offset, name, string.size + 1);
+          strings.push_back(string);
+          return (int)strings.size() - 1;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add the name of an atom of octet to the blob
+        /// @return The index of the string, or -1 for atom_
+        ////////////////////////////////////////////////////////////////////////////////
+        int add_atom(atom_t atom){
+          return atom == atom_ ? -1 : add_string(app_utils::get_atom_name(atom));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add an array to the payload of an operation
+        /// @param  operation  The operation
+        /// @param  index  Which array of the operation (0 or 1)
+        /// @param  data  The bytes of the array
+        /// @param  size  The number of bytes
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_payload(openGEX_scene_operation &operation, int index, const void * data, size_t size){
+          uint64_t offset = payload.size();
+          payload.resize((unsigned int)openDDL_cache::align(offset + size));
+          if (size > 0)
+            memcpy(payload.data() + offset, data, size);
+          memset(payload.data() + offset + size, 0, (size_t)(payload.size() - offset - size));
+          operation.offsets[index] = offset;
+          operation.sizes[index] = size;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get a string of a blob already checked
+        /// @param  header  The header of the blob
+        /// @param  index  The index of the string (-1 is NULL)
+        /// @param  no_error  It's set to false if the string is not in the blob
+        /// @return The characters of the string (ended with \0), or NULL
+        ////////////////////////////////////////////////////////////////////////////////
+        static const char * get_string(const openGEX_scene_header &header, int index, bool &no_error){
+          if (index < 0)
+            return NULL;
+          if ((uint32_t)index >= header.num_strings){
+            no_error = false;
+            return NULL;
+          }
+          const uint8_t * data = (const uint8_t *)&header;
+          const openGEX_scene_string &string = ((const openGEX_scene_string *)(data + header.strings_offset))[index];
+          uint64_t chars_size = header.payload_offset - header.chars_offset;
+          if (string.offset >= chars_size || string.size >= chars_size - string.offset || data[header.chars_offset + string.offset + string.size] != 0){
+            no_error = false;
+            return NULL;
+          }
+          return (const char *)data + header.chars_offset + string.offset;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get an array of the payload of an operation of a blob already checked
+        /// @param  header  The header of the blob
+        /// @param  operation  The operation
+        /// @param  index  Which array of the operation (0 or 1)
+        /// @param  size  The number of bytes expected
+        /// @param  no_error  It's set to false if the array is not in the blob or it has another size
+        /// @return The first byte of the array (aligned to 8 bytes), or NULL
+        ////////////////////////////////////////////////////////////////////////////////
+        static const uint8_t * get_payload(const openGEX_scene_header &header, const openGEX_scene_operation &operation, int index, uint64_t size, bool &no_error){
+          if (operation.sizes[index] != size || operation.offsets[index] % ALIGNMENT != 0 || operation.offsets[index] > header.payload_size ||
+              size > header.payload_size - operation.offsets[index]){
+            no_error = false;
+            return NULL;
+          }
+          return (const uint8_t *)&header + header.payload_offset + operation.offsets[index];
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will get an object used by an operation of a blob, checking what it is
+        /// @param  objects  The objects created till now by the operations (empty while the operations are checked)
+        /// @param  kinds  What each object is (one of the KIND enum)
+        /// @param  num_created  The number of objects created till now
+        /// @param  index  The index of the object (-1 is NULL)
+        /// @param  kind  What the object has to be (-1 if it can be anything)
+        /// @param  can_be_null  False if the operation needs the object
+        /// @param  no_error  It's set to false if the object is not valid
+        ////////////////////////////////////////////////////////////////////////////////
+        static resource * get_object(dynarray<resource *> &objects, dynarray<int> &kinds, unsigned int num_created, int index, int kind, bool can_be_null, bool &no_error){
+          if (index < 0 && can_be_null)
+            return NULL;
+          if (index < 0 || (unsigned int)index >= num_created || (kind >= 0 && kinds[index] != kind)){
+            no_error = false;
+            return NULL;
+          }
+          return (unsigned int)index < objects.size() ? objects[index] : NULL;
+        }
+
+        // The scene can be big, so it cannot be copied
+        openGEX_scene(const openGEX_scene &);
+        openGEX_scene &operator=(const openGEX_scene &);
+      public:
+        enum { OPENGEX_SCENE_VERSION = 4, BYTE_ORDER_MARK = 0x01020304, ALIGNMENT = 8 };
+        // The options of openGEX_data and of the parser saved in the flags of the header
+        enum { FLAG_ANIMATION = 1, FLAG_SKIN_SKELETON = 2, FLAG_INSTANCING = 4, FLAG_OPTIMIZATION = 8,
+          FLAG_WELD_EXACT = 16, FLAG_WELD_EPSILON = 32, FLAG_VERTEX_COMPACT = 64, FLAG_VERTEX_SMALL = 128 };
+        // The operations (the ones with NEW create a resource)
+        enum {
+          NEW_NODE = 0,           // args: father
+          SET_NODE_SID = 1,       // args: node, strings: sid
+          TRANSFORM_NODE = 2,     // args: node, payload: the mat4t multiplied to nodeToParent
+          NEW_MESH = 3,           // args: skin, mode, number of vertices, number of indices, texcoord and format (texcoord | format << 1), payload: vertices (floats) and indices
+          NEW_COLOR_MATERIAL = 4, // payload: the color (vec4)
+          NEW_IMAGE_MATERIAL = 5, // strings: url of the image
+          NEW_MESH_INSTANCE = 6,  // args: node, mesh, material and skeleton
+          SET_MATERIAL = 7,       // args: mesh_instance and material
+          NEW_SKIN = 8,
+          SET_BIND_TO_MODEL = 9,  // args: skin, payload: mat4t
+          ADD_JOINT = 10,         // args: skin, strings: sid, payload: mat4t
+          NEW_SKELETON = 11,
+          ADD_BONE = 12,          // args: skeleton, node and parent
+          NEW_ANIMATION = 13,
+          ADD_CHANNEL = 14,       // args: animation and node, strings: sid, target and component, payload: times and values
+          NEW_ANIMATION_INSTANCE = 15, // args: animation and node
+          SET_RESOURCE = 16,      // args: resource, strings: name
+          NEW_SUBMESH = 17,       // args: mesh with the vertices, skin, mode, number of indices and format, payload: indices
+          NEW_INSTANCED_MESH = 18, // args: mesh and format
+          ADD_INSTANCE = 19       // args: instanced mesh and mesh_instance
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor of the scene, it's not recording
+        ////////////////////////////////////////////////////////////////////////////////
+        openGEX_scene(){
+          recording = false;
+          reset();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will remove all the operations recorded
+        ////////////////////////////////////////////////////////////////////////////////
+        void reset(){
+          objects.reset();
+          slot_objects.reset();
+          slot_indices.reset();
+          operations.reset();
+          strings.reset();
+          chars.reset();
+          payload.reset();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will start or stop recording the resources created (starting removes the previous ones)
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_recording(bool enable){
+          if (enable)
+            reset();
+          recording = enable;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the magic characters of the beginning of the blobs
+        ////////////////////////////////////////////////////////////////////////////////
+        static const char * get_magic(){
+          return "OGEXSCNE";
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new scene_node
+        /// @param  father  The father of the node (NULL for the nodes of the top level)
+        ////////////////////////////////////////////////////////////////////////////////
+        scene_node * new_node(scene_node * father){
+          scene_node * node = new scene_node();
+          if (father != NULL)
+            father->add_child(node);
+          if (recording){
+            int father_index = find_object(father);
+            add_operation(NEW_NODE).args[0] = father_index;
+            add_object(node);
+          }
+          return node;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will set the sid of a scene_node (used by the animations and the skeletons)
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_node_sid(scene_node * node, atom_t sid){
+          node->set_sid(sid);
+          if (recording){
+            int node_index = find_object(node);
+            int sid_index = add_atom(sid);
+            openGEX_scene_operation &operation = add_operation(SET_NODE_SID);
+            operation.args[0] = node_index;
+            operation.strings[0] = sid_index;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will multiply a matrix to the nodeToParent of a scene_node
+        /// @param  matrix  The matrix, already transposed (octet works with the transpose matrices)
+        ////////////////////////////////////////////////////////////////////////////////
+        void transform_node(scene_node * node, const mat4t &matrix){
+          node->access_nodeToParent().multMatrix(matrix);
+          if (recording){
+            int node_index = find_object(node);
+            openGEX_scene_operation &operation = add_operation(TRANSFORM_NODE);
+            operation.args[0] = node_index;
+            add_payload(operation, 0, &matrix, sizeof(mat4t));
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new mesh, with the vertices and indices copied into it
+        /// @param  mesh_skin  The skin of the mesh (it can be NULL)
+        /// @param  mode  The primitive of the mesh (GL_TRIANGLES...)
+        /// @param  vertices  The vertices, and the number of them
+        /// @param  texcoord  False if the vertices have no texcoord (then the uv of all the vertices is (0, 1))
+        /// @param  indices  The indices, and the number of them
+        /// @param  format  The layout of the vertices in the mesh (the vertices are encoded here)
+        ///   With the compact layouts, the AABB of the mesh is set, it's needed to decode the positions
+        ////////////////////////////////////////////////////////////////////////////////
+        mesh * new_mesh(skin * mesh_skin, uint16_t mode, const mesh::vertex * vertices, int num_vertexes, bool texcoord, const uint32_t * indices, int num_indices, int format){
+          mesh * current_mesh = allocate_mesh(mesh_skin, mode, format, num_vertexes, indices, num_indices);
+          if (num_vertexes > 0){
+            float center[3] = { 0, 0, 0 };
+            float half_extent[3] = { 0, 0, 0 };
+            if (format != openGEX_vertex_format::VERTEX_FLOAT){
+              openGEX_vertex_format::get_bounds(vertices, num_vertexes, center, half_extent);
+              current_mesh->set_aabb(aabb(vec3(center[0], center[1], center[2]), vec3(half_extent[0], half_extent[1], half_extent[2])));
+            }
+            gl_resource::wolock vl(current_mesh->get_vertices());
+            openGEX_vertex_format::encode(format, vertices, num_vertexes, texcoord, center, half_extent, vl.u8());
+          }
+          if (recording){
+            int skin_index = find_object(mesh_skin);
+            openGEX_scene_operation &operation = add_operation(NEW_MESH);
+            operation.args[0] = skin_index;
+            operation.args[1] = mode;
+            operation.args[2] = num_vertexes;
+            operation.args[3] = num_indices;
+            operation.args[4] = (texcoord ? 1 : 0) | (format << 1);
+            add_payload(operation, 0, vertices, sizeof(mesh::vertex) * num_vertexes);
+            add_payload(operation, 1, indices, sizeof(uint32_t) * num_indices);
+            add_object(current_mesh);
+          }
+          return current_mesh;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new mesh that uses the vertex buffer of another one (with its own indices)
+        /// @param  shared_mesh  The mesh with the vertices (made with new_mesh)
+        /// @param  mesh_skin  The skin of the mesh (it can be NULL)
+        /// @param  mode  The primitive of the mesh (GL_TRIANGLES...)
+        /// @param  indices  The indices, and the number of them
+        /// @param  format  The layout of the vertices of the shared mesh
+        ///   The IndexArrays of a Mesh are drawn with the same vertices, so they are stored only once
+        ////////////////////////////////////////////////////////////////////////////////
+        mesh * new_submesh(mesh * shared_mesh, skin * mesh_skin, uint16_t mode, const uint32_t * indices, int num_indices, int format){
+          mesh * current_mesh = allocate_mesh(mesh_skin, mode, format, 0, indices, num_indices);
+          current_mesh->set_vertices(shared_mesh->get_vertices());
+          current_mesh->set_num_vertices(shared_mesh->get_num_vertices());
+          current_mesh->set_params(openGEX_vertex_format::get_stride(format), num_indices, shared_mesh->get_num_vertices(), mode, GL_UNSIGNED_INT);
+          current_mesh->set_aabb(shared_mesh->get_aabb());
+          if (recording){
+            int shared_index = find_object(shared_mesh);
+            int skin_index = find_object(mesh_skin);
+            openGEX_scene_operation &operation = add_operation(NEW_SUBMESH);
+            operation.args[0] = shared_index;
+            operation.args[1] = skin_index;
+            operation.args[2] = mode;
+            operation.args[3] = num_indices;
+            operation.args[4] = format;
+            add_payload(operation, 0, indices, sizeof(uint32_t) * num_indices);
+            add_object(current_mesh);
+          }
+          return current_mesh;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new material with a color
+        ////////////////////////////////////////////////////////////////////////////////
+        material * new_material(const vec4 &color){
+          material * current_material = new material(color);
+          if (recording){
+            add_payload(add_operation(NEW_COLOR_MATERIAL), 0, &color, sizeof(vec4));
+            add_object(current_material);
+          }
+          return current_material;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new material with an image
+        /// @param  url  The address of the image
+        ////////////////////////////////////////////////////////////////////////////////
+        material * new_material(const char * url){
+          material * current_material = new material(new image(url));
+          if (recording){
+            int url_index = add_string(url);
+            add_operation(NEW_IMAGE_MATERIAL).strings[0] = url_index;
+            add_object(current_material);
+          }
+          return current_material;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new mesh_instance
+        /// @param  instance_skeleton  The skeleton of the mesh_instance (NULL if it has not)
+        ////////////////////////////////////////////////////////////////////////////////
+        mesh_instance * new_mesh_instance(scene_node * node, mesh * instance_mesh, material * instance_material, skeleton * instance_skeleton){
+          mesh_instance * instance;
+          if (instance_skeleton == NULL)
+            instance = new mesh_instance(node, instance_mesh, instance_material);
+          else
+            instance = new mesh_instance(node, instance_mesh, instance_material, instance_skeleton);
+          if (recording){
+            int node_index = find_object(node);
+            int mesh_index = find_object(instance_mesh);
+            int material_index = find_object(instance_material);
+            int skeleton_index = find_object(instance_skeleton);
+            openGEX_scene_operation &operation = add_operation(NEW_MESH_INSTANCE);
+            operation.args[0] = node_index;
+            operation.args[1] = mesh_index;
+            operation.args[2] = material_index;
+            operation.args[3] = skeleton_index;
+            add_object(instance);
+          }
+          return instance;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will change the material of a mesh_instance (the ones created before their Material)
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_material(mesh_instance * instance, material * instance_material){
+          instance->set_material(instance_material);
+          if (recording){
+            int instance_index = find_object(instance);
+            int material_index = find_object(instance_material);
+            openGEX_scene_operation &operation = add_operation(SET_MATERIAL);
+            operation.args[0] = instance_index;
+            operation.args[1] = material_index;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new instanced mesh (check openGEX_instancing.h)
+        /// @param  format  The layout of the vertices of the mesh
+        ////////////////////////////////////////////////////////////////////////////////
+        openGEX_instanced_mesh * new_instanced_mesh(mesh * instanced_mesh, int format){
+          openGEX_instanced_mesh * instanced = new openGEX_instanced_mesh(instanced_mesh, format);
+          if (recording){
+            int mesh_index = find_object(instanced_mesh);
+            openGEX_scene_operation &operation = add_operation(NEW_INSTANCED_MESH);
+            operation.args[0] = mesh_index;
+            operation.args[1] = format;
+            add_object(instanced);
+          }
+          return instanced;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a mesh_instance to an instanced mesh
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_instance(openGEX_instanced_mesh * instanced, mesh_instance * instance){
+          instanced->add_instance(instance);
+          if (recording){
+            int instanced_index = find_object(instanced);
+            int instance_index = find_object(instance);
+            openGEX_scene_operation &operation = add_operation(ADD_INSTANCE);
+            operation.args[0] = instanced_index;
+            operation.args[1] = instance_index;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new skin
+        ////////////////////////////////////////////////////////////////////////////////
+        skin * new_skin(){
+          skin * current_skin = new skin();
+          if (recording){
+            add_operation(NEW_SKIN);
+            add_object(current_skin);
+          }
+          return current_skin;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will set the bindToModel matrix of a skin (already transposed)
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_bind_to_model(skin * current_skin, const mat4t &matrix){
+          current_skin->set_bindToModel(matrix);
+          if (recording){
+            int skin_index = find_object(current_skin);
+            openGEX_scene_operation &operation = add_operation(SET_BIND_TO_MODEL);
+            operation.args[0] = skin_index;
+            add_payload(operation, 0, &matrix, sizeof(mat4t));
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a joint to a skin
+        /// @param  matrix  The bindToModel matrix of the joint
+        /// @param  sid  The sid of the bone of the joint
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_joint(skin * current_skin, const mat4t &matrix, atom_t sid){
+          current_skin->add_joint(matrix, sid);
+          if (recording){
+            int skin_index = find_object(current_skin);
+            int sid_index = add_atom(sid);
+            openGEX_scene_operation &operation = add_operation(ADD_JOINT);
+            operation.args[0] = skin_index;
+            operation.strings[0] = sid_index;
+            add_payload(operation, 0, &matrix, sizeof(mat4t));
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new skeleton
+        ////////////////////////////////////////////////////////////////////////////////
+        skeleton * new_skeleton(){
+          skeleton * current_skeleton = new skeleton();
+          if (recording){
+            add_operation(NEW_SKELETON);
+            add_object(current_skeleton);
+          }
+          return current_skeleton;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a bone to a skeleton
+        /// @param  parent  The index of the parent bone in the skeleton (-1 if it has not)
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_bone(skeleton * current_skeleton, scene_node * bone, int parent){
+          current_skeleton->add_bone(bone, parent);
+          if (recording){
+            int skeleton_index = find_object(current_skeleton);
+            int bone_index = find_object(bone);
+            openGEX_scene_operation &operation = add_operation(ADD_BONE);
+            operation.args[0] = skeleton_index;
+            operation.args[1] = bone_index;
+            operation.args[2] = parent;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new animation
+        ////////////////////////////////////////////////////////////////////////////////
+        animation * new_animation(){
+          animation * current_animation = new animation();
+          if (recording){
+            add_operation(NEW_ANIMATION);
+            add_object(current_animation);
+          }
+          return current_animation;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a channel to an animation (the parameters are the ones of animation::add_channel)
+        ////////////////////////////////////////////////////////////////////////////////
+        void add_channel(animation * current_animation, scene_node * node, atom_t sid, atom_t target, atom_t component, dynarray<float> &times, dynarray<float> &values){
+          current_animation->add_channel(node, sid, target, component, times, values);
+          if (recording){
+            int animation_index = find_object(current_animation);
+            int node_index = find_object(node);
+            int sid_index = add_atom(sid);
+            int target_index = add_atom(target);
+            int component_index = add_atom(component);
+            openGEX_scene_operation &operation = add_operation(ADD_CHANNEL);
+            operation.args[0] = animation_index;
+            operation.args[1] = node_index;
+            operation.strings[0] = sid_index;
+            operation.strings[1] = target_index;
+            operation.strings[2] = component_index;
+            add_payload(operation, 0, times.data(), sizeof(float) * times.size());
+            add_payload(operation, 1, values.data(), sizeof(float) * values.size());
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create a new animation_instance
+        ////////////////////////////////////////////////////////////////////////////////
+        animation_instance * new_animation_instance(animation * current_animation, scene_node * node){
+          animation_instance * instance = new animation_instance(current_animation, node);
+          if (recording){
+            int animation_index = find_object(current_animation);
+            int node_index = find_object(node);
+            openGEX_scene_operation &operation = add_operation(NEW_ANIMATION_INSTANCE);
+            operation.args[0] = animation_index;
+            operation.args[1] = node_index;
+            add_object(instance);
+          }
+          return instance;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add a resource to the dictionary
+        /// @param  dict  The dictionary of resources
+        /// @param  name  The name of the resource in the dictionary
+        ////////////////////////////////////////////////////////////////////////////////
+        void set_resource(resource_dict * dict, const char * name, resource * new_resource){
+          dict->set_resource(name, new_resource);
+          if (recording){
+            int resource_index = find_object(new_resource);
+            int name_index = add_string(name);
+            openGEX_scene_operation &operation = add_operation(SET_RESOURCE);
+            operation.args[0] = resource_index;
+            operation.strings[0] = name_index;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will write the operations recorded in a blob
+        /// @param  file  The file of the blob, opened to write in binary mode
+        /// @param  source  The size, time of modification and hash of the file converted
+        /// @param  flags  The options used to convert the scene (FLAG_ANIMATION, FLAG_SKIN_SKELETON...)
+        /// @param  welding_epsilon  The epsilon of the welding of the vertices (0 if it was not WELD_EPSILON)
+        /// @return True if everything was written. The magic is written at the end, so a blob not finished is never used
+        ////////////////////////////////////////////////////////////////////////////////
+        bool write(FILE * file, const openDDL_cache_source &source, uint32_t flags, float welding_epsilon){
+          if (file == NULL)
+            return false;
+          openGEX_scene_header header;
+          memset(&header, 0, sizeof(header));
+          header.version = OPENGEX_SCENE_VERSION;
+          header.byte_order = BYTE_ORDER_MARK;
+          header.source = source;
+          header.flags = flags;
+          header.welding_epsilon = welding_epsilon;
+          header.num_objects = objects.size();
+          header.num_operations = operations.size();
+          header.num_strings = strings.size();
+          header.operations_offset = openDDL_cache::align(sizeof(header));
+          header.strings_offset = header.operations_offset + header.num_operations * sizeof(openGEX_scene_operation);
+          header.chars_offset = header.strings_offset + header.num_strings * sizeof(openGEX_scene_string);
+          header.payload_offset = openDDL_cache::align(header.chars_offset + chars.size());
+          header.payload_size = payload.size();
+          header.blob_size = header.payload_offset + header.payload_size;
+
+          static const uint8_t zeros[ALIGNMENT] = { 0 };
+          size_t header_padding = (size_t)(header.operations_offset - sizeof(header));
+          size_t chars_padding = (size_t)(header.payload_offset - header.chars_offset - chars.size());
+          bool no_error = fwrite(&header, sizeof(header), 1, file) == 1;
+          no_error = no_error && fwrite(zeros, 1, header_padding, file) == header_padding;
+          if (no_error && operations.size() > 0)
+            no_error = fwrite(operations.data(), sizeof(openGEX_scene_operation), operations.size(), file) == operations.size();
+          if (no_error && strings.size() > 0)
+            no_error = fwrite(strings.data(), sizeof(openGEX_scene_string), strings.size(), file) == strings.size();
+          if (no_error && chars.size() > 0)
+            no_error = fwrite(chars.data(), 1, chars.size(), file) == chars.size();
+          no_error = no_error && fwrite(zeros, 1, chars_padding, file) == chars_padding;
+          if (no_error && payload.size() > 0)
+            no_error = fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+
+          //Now that everything is written, the header gets its magic characters
+          memcpy(header.magic, get_magic(), sizeof(header.magic));
+          no_error = no_error && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+          return fflush(file) == 0 && no_error;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check the header of a blob, and if it was made from the current version of the source
+        /// @param  data  The blob mapped in memory (aligned to 8 bytes)
+        /// @param  size  The size of the blob
+        /// @param  source  The size, time of modification and hash of the source now
+        /// @return The header if the blob can be used, or NULL if it's from another file or version, or it's broken
+        ///   The options of openGEX_data used are in the flags of the header
+        ////////////////////////////////////////////////////////////////////////////////
+        static const openGEX_scene_header * check_header(const uint8_t * data, size_t size, const openDDL_cache_source &source){
+          if (data == NULL || size < sizeof(openGEX_scene_header))
+            return NULL;
+          const openGEX_scene_header * header = (const openGEX_scene_header *)data;
+          if (memcmp(header->magic, get_magic(), 8) != 0 || header->version != OPENGEX_SCENE_VERSION || header->byte_order != BYTE_ORDER_MARK)
+            return NULL;
+          if (header->source.size != source.size || header->source.mtime != source.mtime || header->source.hash != source.hash)
+            return NULL;
+          if (header->blob_size != size)
+            return NULL;
+          if (header->operations_offset % ALIGNMENT != 0 || header->operations_offset > size ||
+              header->num_operations > (size - header->operations_offset) / sizeof(openGEX_scene_operation) ||
+              header->strings_offset % ALIGNMENT != 0 || header->strings_offset > size ||
+              header->num_strings > (size - header->strings_offset) / sizeof(openGEX_scene_string) ||
+              header->payload_offset % ALIGNMENT != 0 || header->payload_offset > size || header->chars_offset > header->payload_offset ||
+              header->payload_size != size - header->payload_offset)
+            return NULL;
+          return header;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will create the resources of a blob again, doing all its operations (without recording them)
+        /// @param  dict  The dictionary of resources where the resources are added
+        /// @param  header  The header of the blob (checked with check_header), the rest of the blob goes after it
+        /// @return True if everything went well, false if there was an operation not valid in the blob
+        ///   The vertices, indices, matrices and keys are copied in bulk from the blob. All the operations are
+        ///   checked before doing the first one, so if the blob is not valid nothing is added to the dictionary.
+        ////////////////////////////////////////////////////////////////////////////////
+        bool replay(resource_dict * dict, const openGEX_scene_header &header){
+          bool saved_recording = recording;
+          recording = false;
+          dynarray<resource *> replay_objects;
+          dynarray<int> kinds;
+          replay_objects.reserve(header.num_objects);
+          kinds.reserve(header.num_objects);
+          const openGEX_scene_operation * replay_operations = (const openGEX_scene_operation *)((const uint8_t *)&header + header.operations_offset);
+          bool no_error = true;
+          //The first pass only checks the operations, so nothing is created from a broken blob
+          for (int pass = 0; pass < 2 && no_error; ++pass){
+            bool apply = pass == 1;
+            unsigned int num_created = 0;
+            for (uint32_t i = 0; i < header.num_operations && no_error; ++i){
+              const openGEX_scene_operation &operation = replay_operations[i];
+              const int32_t * args = operation.args;
+              resource * created = NULL;
+              int kind = -1;
+              switch (operation.type){
+              case NEW_NODE:{
+                scene_node * father = (scene_node *)get_object(replay_objects, kinds, num_created, args[0], KIND_NODE, true, no_error);
+                kind = KIND_NODE;
+                if (no_error && apply)
+                  created = new_node(father);
+                break;
+              }
+              case SET_NODE_SID:{
+                scene_node * node = (scene_node *)get_object(replay_objects, kinds, num_created, args[0], KIND_NODE, false, no_error);
+                const char * sid = get_string(header, operation.strings[0], no_error);
+                if (no_error && apply)
+                  set_node_sid(node, sid == NULL ? atom_ : app_utils::get_atom(sid));
+                break;
+              }
+              case TRANSFORM_NODE:{
+                scene_node * node = (scene_node *)get_object(replay_objects, kinds, num_created, args[0], KIND_NODE, false, no_error);
+                const uint8_t * matrix_data = get_payload(header, operation, 0, sizeof(mat4t), no_error);
+                if (no_error && apply){
+                  mat4t matrix;
+                  memcpy(&matrix, matrix_data, sizeof(mat4t));
+                  transform_node(node, matrix);
+                }
+                break;
+              }
+              case NEW_MESH:{
+                skin * mesh_skin = (skin *)get_object(replay_objects, kinds, num_created, args[0], KIND_SKIN, true, no_error);
+                int format = args[4] >> 1;
+                if (args[2] < 0 || args[3] < 0 || format < 0 || format >= openGEX_vertex_format::NUM_VERTEX_FORMATS)
+                  no_error = false;
+                const uint8_t * vertices = get_payload(header, operation, 0, (uint64_t)sizeof(mesh::vertex) * (uint32_t)args[2], no_error);
+                const uint8_t * indices = get_payload(header, operation, 1, (uint64_t)sizeof(uint32_t) * (uint32_t)args[3], no_error);
+                kind = KIND_MESH;
+                if (no_error && apply)
+                  created = new_mesh(mesh_skin, (uint16_t)args[1], (const mesh::vertex *)vertices, args[2], (args[4] & 1) != 0, (const uint32_t *)indices, args[3], format);
+                break;
+              }
+              case NEW_SUBMESH:{
+                mesh * shared_mesh = (mesh *)get_object(replay_objects, kinds, num_created, args[0], KIND_MESH, false, no_error);
+                skin * mesh_skin = (skin *)get_object(replay_objects, kinds, num_created, args[1], KIND_SKIN, true, no_error);
+                if (args[3] < 0 || args[4] < 0 || args[4] >= openGEX_vertex_format::NUM_VERTEX_FORMATS)
+                  no_error = false;
+                const uint8_t * indices = get_payload(header, operation, 0, (uint64_t)sizeof(uint32_t) * (uint32_t)args[3], no_error);
+                kind = KIND_MESH;
+                if (no_error && apply)
+                  created = new_submesh(shared_mesh, mesh_skin, (uint16_t)args[2], (const uint32_t *)indices, args[3], args[4]);
+                break;
+              }
+              case NEW_COLOR_MATERIAL:{
+                const uint8_t * color_data = get_payload(header, operation, 0, sizeof(vec4), no_error);
+                kind = KIND_MATERIAL;
+                if (no_error && apply){
+                  vec4 color;
+                  memcpy(&color, color_data, sizeof(vec4));
+                  created = new_material(color);
+                }
+                break;
+              }
+              case NEW_IMAGE_MATERIAL:{
+                const char * url = get_string(header, operation.strings[0], no_error);
+                if (url == NULL)
+                  no_error = false;
+                kind = KIND_MATERIAL;
+                if (no_error && apply)
+                  created = new_material(url);
+                break;
+              }
+              case NEW_MESH_INSTANCE:{
+                scene_node * node = (scene_node *)get_object(replay_objects, kinds, num_created, args[0], KIND_NODE, false, no_error);
+                mesh * instance_mesh = (mesh *)get_object(replay_objects, kinds, num_created, args[1], KIND_MESH, false, no_error);
+                material * instance_material = (material *)get_object(replay_objects, kinds, num_created, args[2], KIND_MATERIAL, true, no_error);
+                skeleton * instance_skeleton = (skeleton *)get_object(replay_objects, kinds, num_created, args[3], KIND_SKELETON, true, no_error);
+                kind = KIND_MESH_INSTANCE;
+                if (no_error && apply)
+                  created = new_mesh_instance(node, instance_mesh, instance_material, instance_skeleton);
+                break;
+              }
+              case SET_MATERIAL:{
+                mesh_instance * instance = (mesh_instance *)get_object(replay_objects, kinds, num_created, args[0], KIND_MESH_INSTANCE, false, no_error);
+                material * instance_material = (material *)get_object(replay_objects, kinds, num_created, args[1], KIND_MATERIAL, true, no_error);
+                if (no_error && apply)
+                  set_material(instance, instance_material);
+                break;
+              }
+              case NEW_INSTANCED_MESH:{
+                mesh * instanced_mesh = (mesh *)get_object(replay_objects, kinds, num_created, args[0], KIND_MESH, false, no_error);
+                if (args[1] < 0 || args[1] >= openGEX_vertex_format::NUM_VERTEX_FORMATS)
+                  no_error = false;
+                kind = KIND_INSTANCED_MESH;
+                if (no_error && apply)
+                  created = new_instanced_mesh(instanced_mesh, args[1]);
+                break;
+              }
+              case ADD_INSTANCE:{
+                openGEX_instanced_mesh * instanced = (openGEX_instanced_mesh *)get_object(replay_objects, kinds, num_created, args[0], KIND_INSTANCED_MESH, false, no_error);
+                mesh_instance * instance = (mesh_instance *)get_object(replay_objects, kinds, num_created, args[1], KIND_MESH_INSTANCE, false, no_error);
+                if (no_error && apply)
+                  add_instance(instanced, instance);
+                break;
+              }
+              case NEW_SKIN:
+                kind = KIND_SKIN;
+                if (apply)
+                  created = new_skin();
+                break;
+              case SET_BIND_TO_MODEL:
+              case ADD_JOINT:{
+                skin * current_skin = (skin *)get_object(replay_objects, kinds, num_created, args[0], KIND_SKIN, false, no_error);
+                const uint8_t * matrix_data = get_payload(header, operation, 0, sizeof(mat4t), no_error);
+                const char * sid = get_string(header, operation.strings[0], no_error);
+                if (no_error && apply){
+                  mat4t matrix;
+                  memcpy(&matrix, matrix_data, sizeof(mat4t));
+                  if (operation.type == SET_BIND_TO_MODEL)
+                    set_bind_to_model(current_skin, matrix);
+                  else
+                    add_joint(current_skin, matrix, sid == NULL ? atom_ : app_utils::get_atom(sid));
+                }
+                break;
+              }
+              case NEW_SKELETON:
+                kind = KIND_SKELETON;
+                if (apply)
+                  created = new_skeleton();
+                break;
+              case ADD_BONE:{
+                skeleton * current_skeleton = (skeleton *)get_object(replay_objects, kinds, num_created, args[0], KIND_SKELETON, false, no_error);
+                scene_node * bone = (scene_node *)get_object(replay_objects, kinds, num_created, args[1], KIND_NODE, false, no_error);
+                if (no_error && apply)
+                  add_bone(current_skeleton, bone, args[2]);
+                break;
+              }
+              case NEW_ANIMATION:
+                kind = KIND_ANIMATION;
+                if (apply)
+                  created = new_animation();
+                break;
+              case ADD_CHANNEL:{
+                animation * current_animation = (animation *)get_object(replay_objects, kinds, num_created, args[0], KIND_ANIMATION, false, no_error);
+                scene_node * node = (scene_node *)get_object(replay_objects, kinds, num_created, args[1], KIND_NODE, false, no_error);
+                const char * names[3];
+                for (int j = 0; j < 3; ++j)
+                  names[j] = get_string(header, operation.strings[j], no_error);
+                if (operation.sizes[0] % sizeof(float) != 0 || operation.sizes[1] % sizeof(float) != 0)
+                  no_error = false;
+                const uint8_t * times_data = get_payload(header, operation, 0, operation.sizes[0], no_error);
+                const uint8_t * values_data = get_payload(header, operation, 1, operation.sizes[1], no_error);
+                if (no_error && apply){
+                  atom_t channel_atoms[3];
+                  for (int j = 0; j < 3; ++j)
+                    channel_atoms[j] = names[j] == NULL ? atom_ : app_utils::get_atom(names[j]);
+                  dynarray<float> times;
+                  dynarray<float> values;
+                  times.resize((unsigned int)(operation.sizes[0] / sizeof(float)));
+                  values.resize((unsigned int)(operation.sizes[1] / sizeof(float)));
+                  if (times.size() > 0)
+                    memcpy(times.data(), times_data, (size_t)operation.sizes[0]);
+                  if (values.size() > 0)
+                    memcpy(values.data(), values_data, (size_t)operation.sizes[1]);
+                  add_channel(current_animation, node, channel_atoms[0], channel_atoms[1], channel_atoms[2], times, values);
+                }
+                break;
+              }
+              case NEW_ANIMATION_INSTANCE:{
+                animation * current_animation = (animation *)get_object(replay_objects, kinds, num_created, args[0], KIND_ANIMATION, false, no_error);
+                scene_node * node = (scene_node *)get_object(replay_objects, kinds, num_created, args[1], KIND_NODE, false, no_error);
+                kind = KIND_ANIMATION_INSTANCE;
+                if (no_error && apply)
+                  created = new_animation_instance(current_animation, node);
+                break;
+              }
+              case SET_RESOURCE:{
+                resource * new_resource = get_object(replay_objects, kinds, num_created, args[0], -1, false, no_error);
+                const char * name = get_string(header, operation.strings[0], no_error);
+                if (name == NULL)
+                  no_error = false;
+                if (no_error && apply)
+                  set_resource(dict, name, new_resource);
+                break;
+              }
+              default:
+                no_error = false;
+                break;
+              }
+              if (!no_error)
+                printf("(((ERROR! The operation %u of the converted scene is not valid!)))\n", i);
+              else if (kind >= 0){
+                if (apply)
+                  replay_objects.push_back(created);
+                else
+                  kinds.push_back(kind);
+                ++num_created;
+              }
+            }
+          }
+          //The materials of the instances are set by then, so the packed arrays of the instanced meshes can be filled
+          for (unsigned int i = 0; i < replay_objects.size() && no_error; ++i){
+            if (kinds[i] == KIND_INSTANCED_MESH)
+              ((openGEX_instanced_mesh *)replay_objects[i])->update();
+          }
+          recording = saved_recording;
+          return no_error;
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,384 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openGEX_vertex_format.h
+/// @author Juanmi Huertas Delgado
+/// @brief This are the layouts of the vertices of the meshes created (with set_vertex_format of openGEX_parser)
+///
+///   By default the vertices are mesh::vertex, with floats: 32 bytes for each vertex. In the big scenes most of
+///   the memory (and the bandwidth to draw them) is vertices, so they can be stored with less bytes:
+///   - VERTEX_FLOAT (32 bytes): position, normal and texcoord with floats (mesh::vertex)
+///   - VERTEX_COMPACT (16 bytes): position with 3 shorts (and 2 bytes of padding), normal with 2 shorts, texcoord
+///     with 2 half floats
+///   - VERTEX_SMALL (12 bytes): position with 3 shorts, normal with 2 bytes, texcoord with 2 half floats
+///   The positions are normalized in the AABB of the mesh (set in the mesh): position = center + pos * half_extent.
+///   The normals are octahedral (the unit sphere is folded in a square, check decode_normal), so the shaders
+///   have to decode them. The encoders work with 4 vertices at a time with SSE2 (and the half floats with F16C),
+///   and give the same values than the scalar version. The skinned meshes are always VERTEX_FLOAT.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENGEX_VERTEX_FORMAT_INCLUDED
+#define OPENGEX_VERTEX_FORMAT_INCLUDED
+
+#if defined(OPENDDL_SSE2) && defined(__F16C__)
+  #define OPENGEX_F16C 1
+  #include <immintrin.h>
+#endif
+
+#ifndef GL_HALF_FLOAT
+  #define GL_HALF_FLOAT 0x140B
+#endif
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class has the layouts of the vertices, and the functions to encode and decode them
+  ////////////////////////////////////////////////////////////////////////////////
+      class openGEX_vertex_format{
+        // The biggest values of the normalized shorts and bytes
+        enum { SHORT_SCALE = 32767, BYTE_SCALE = 127 };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will quantize a value of [-1, 1] (it's clamped) to a normalized integer, rounding to the nearest
+        ///   The value is moved to be positive, so the truncation is the same than the floor (the SIMD does the same)
+        ////////////////////////////////////////////////////////////////////////////////
+        static int quantize(float value, int scale){
+          value = value > -1.0f ? value : -1.0f;
+          value = value < 1.0f ? value : 1.0f;
+          return (int)(value * (float)scale + ((float)scale + 0.5f)) - scale;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will fold a normal in the octahedral square
+        /// @param  normal  The normal (it doesn't need to be unit), and it returns the two coordinates in [-1, 1]
+        ////////////////////////////////////////////////////////////////////////////////
+        static void fold_normal(const float * normal, float &u, float &v){
+          float sum = fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+          float inverse = sum > 0.0f ? 1.0f / sum : 0.0f;
+          u = normal[0] * inverse;
+          v = normal[1] * inverse;
+          if (normal[2] < 0.0f){
+            float folded_u = (1.0f - fabsf(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+            float folded_v = (1.0f - fabsf(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+            u = folded_u;
+            v = folded_v;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will write the quantized values of a vertex in its layout
+        /// @param  position  The position normalized in the AABB (3 values), and the normal folded (2 values)
+        ////////////////////////////////////////////////////////////////////////////////
+        static void write_vertex(int format, uint8_t * output, const int * position, const int * normal, const uint16_t * uv){
+          int16_t shorts[4] = { (int16_t)position[0], (int16_t)position[1], (int16_t)position[2], 0 };
+          if (format == VERTEX_COMPACT){
+            int16_t normal_shorts[2] = { (int16_t)normal[0], (int16_t)normal[1] };
+            memcpy(output, shorts, 8);
+            memcpy(output + 8, normal_shorts, 4);
+            memcpy(output + 12, uv, 4);
+          }
+          else{
+            int8_t normal_bytes[2] = { (int8_t)normal[0], (int8_t)normal[1] };
+            memcpy(output, shorts, 6);
+            memcpy(output + 6, normal_bytes, 2);
+            memcpy(output + 8, uv, 4);
+          }
+        }
+
+      #if defined(OPENDDL_SSE2)
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will quantize 4 values of [-1, 1] at once (the same operations than quantize)
+        ////////////////////////////////////////////////////////////////////////////////
+        static __m128i quantize_4(__m128 value, int scale){
+          value = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+          __m128 shifted = _mm_add_ps(_mm_mul_ps(value, _mm_set1_ps((float)scale)), _mm_set1_ps((float)scale + 0.5f));
+          return _mm_sub_epi32(_mm_cvttps_epi32(shifted), _mm_set1_epi32(scale));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will encode 4 vertices at once (the ones after count repeat the last one, and are not written)
+        ////////////////////////////////////////////////////////////////////////////////
+        static void encode_4(int format, const mesh::vertex * vertices, int count, bool texcoord, const float * center, const float * inverse, uint8_t * output){
+          const float * v[4];
+          for (int i = 0; i < 4; ++i)
+            v[i] = (const float *)(vertices + (i < count ? i : count - 1));
+          //The positions, one component of the 4 vertices in each register
+          int position[3][4];
+          for (int k = 0; k < 3; ++k){
+            __m128 p = _mm_setr_ps(v[0][k], v[1][k], v[2][k], v[3][k]);
+            p = _mm_mul_ps(_mm_sub_ps(p, _mm_set1_ps(center[k])), _mm_set1_ps(inverse[k]));
+            _mm_storeu_si128((__m128i *)position[k], quantize_4(p, SHORT_SCALE));
+          }
+          //The normals, folded in the octahedron
+          const __m128 sign_mask = _mm_set1_ps(-0.0f);
+          const __m128 zero = _mm_setzero_ps();
+          const __m128 one = _mm_set1_ps(1.0f);
+          const __m128 minus_one = _mm_set1_ps(-1.0f);
+          __m128 nx = _mm_setr_ps(v[0][3], v[1][3], v[2][3], v[3][3]);
+          __m128 ny = _mm_setr_ps(v[0][4], v[1][4], v[2][4], v[3][4]);
+          __m128 nz = _mm_setr_ps(v[0][5], v[1][5], v[2][5], v[3][5]);
+          __m128 sum = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign_mask, nx), _mm_andnot_ps(sign_mask, ny)), _mm_andnot_ps(sign_mask, nz));
+          __m128 inverse_sum = _mm_and_ps(_mm_cmpgt_ps(sum, zero), _mm_div_ps(one, sum));
+          __m128 u = _mm_mul_ps(nx, inverse_sum);
+          __m128 w = _mm_mul_ps(ny, inverse_sum);
+          __m128 sign_u = _mm_cmpge_ps(u, zero);
+          __m128 sign_w = _mm_cmpge_ps(w, zero);
+          sign_u = _mm_or_ps(_mm_and_ps(sign_u, one), _mm_andnot_ps(sign_u, minus_one));
+          sign_w = _mm_or_ps(_mm_and_ps(sign_w, one), _mm_andnot_ps(sign_w, minus_one));
+          __m128 folded_u = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, w)), sign_u);
+          __m128 folded_w = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, u)), sign_w);
+          __m128 fold = _mm_cmplt_ps(nz, zero);
+          u = _mm_or_ps(_mm_and_ps(fold, folded_u), _mm_andnot_ps(fold, u));
+          w = _mm_or_ps(_mm_and_ps(fold, folded_w), _mm_andnot_ps(fold, w));
+          int scale = format == VERTEX_COMPACT ? SHORT_SCALE : BYTE_SCALE;
+          int normal[2][4];
+          _mm_storeu_si128((__m128i *)normal[0], quantize_4(u, scale));
+          _mm_storeu_si128((__m128i *)normal[1], quantize_4(w, scale));
+          //The texcoords (0, 1 if the Mesh has not them)
+          uint16_t uv[4][2];
+        #if defined(OPENGEX_F16C)
+          float uv_floats[8];
+          for (int i = 0; i < 4; ++i){
+            uv_floats[i * 2] = texcoord ? v[i][6] : 0.0f;
+            uv_floats[i * 2 + 1] = texcoord ? v[i][7] : 1.0f;
+          }
+          _mm_storel_epi64((__m128i *)uv[0], _mm_cvtps_ph(_mm_loadu_ps(uv_floats), 0));
+          _mm_storel_epi64((__m128i *)uv[2], _mm_cvtps_ph(_mm_loadu_ps(uv_floats + 4), 0));
+        #else
+          for (int i = 0; i < 4; ++i){
+            uv[i][0] = float_to_half(texcoord ? v[i][6] : 0.0f);
+            uv[i][1] = float_to_half(texcoord ? v[i][7] : 1.0f);
+          }
+        #endif
+          for (int i = 0; i < count; ++i){
+            int vertex_position[3] = { position[0][i], position[1][i], position[2][i] };
+            int vertex_normal[2] = { normal[0][i], normal[1][i] };
+            write_vertex(format, output + i * get_stride(format), vertex_position, vertex_normal, uv[i]);
+          }
+        }
+      #endif
+
+      public:
+        enum { VERTEX_FLOAT = 0, VERTEX_COMPACT = 1, VERTEX_SMALL = 2, NUM_VERTEX_FORMATS = 3 };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the size of a vertex with a layout
+        ////////////////////////////////////////////////////////////////////////////////
+        static unsigned int get_stride(int format){
+          switch (format){
+          case VERTEX_COMPACT:
+            return 16;
+          case VERTEX_SMALL:
+            return 12;
+          default:
+            return sizeof(mesh::vertex);
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will add the attributes of a layout to a mesh (the normalized ones are marked as normalized)
+        ////////////////////////////////////////////////////////////////////////////////
+        static void add_attributes(mesh * current_mesh, int format){
+          switch (format){
+          case VERTEX_COMPACT:
+            current_mesh->add_attribute(attribute_pos, 3, GL_SHORT, 0, GL_TRUE);
+            current_mesh->add_attribute(attribute_normal, 2, GL_SHORT, 8, GL_TRUE);
+            current_mesh->add_attribute(attribute_uv, 2, GL_HALF_FLOAT, 12);
+            break;
+          case VERTEX_SMALL:
+            current_mesh->add_attribute(attribute_pos, 3, GL_SHORT, 0, GL_TRUE);
+            current_mesh->add_attribute(attribute_normal, 2, GL_BYTE, 6, GL_TRUE);
+            current_mesh->add_attribute(attribute_uv, 2, GL_HALF_FLOAT, 8);
+            break;
+          default:
+            current_mesh->add_attribute(attribute_pos, 3, GL_FLOAT, 0);
+            current_mesh->add_attribute(attribute_normal, 3, GL_FLOAT, 12);
+            current_mesh->add_attribute(attribute_uv, 2, GL_FLOAT, 24);
+            break;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will convert a float to a half float, rounding to the nearest even (like F16C)
+        ////////////////////////////////////////////////////////////////////////////////
+        static uint16_t float_to_half(float value){
+          uint32_t bits;
+          memcpy(&bits, &value, 4);
+          uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+          bits &= 0x7fffffff;
+          uint16_t half;
+          if (bits >= 0x47800000){
+            //Too big, infinite or NaN
+            half = bits > 0x7f800000 ? 0x7e00 : 0x7c00;
+          }
+          else if (bits < 0x38800000){
+            //Denormal or zero: adding 0.5 leaves the mantissa rounded in the last bits
+            float absolute;
+            memcpy(&absolute, &bits, 4);
+            absolute += 0.5f;
+            uint32_t rounded;
+            memcpy(&rounded, &absolute, 4);
+            half = (uint16_t)(rounded - 0x3f000000);
+          }
+          else{
+            uint32_t odd = (bits >> 13) & 1;
+            bits += ((uint32_t)(15 - 127) << 23) + 0xfff + odd;
+            half = (uint16_t)(bits >> 13);
+          }
+          return (uint16_t)(half | sign);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will convert a half float to a float
+        ////////////////////////////////////////////////////////////////////////////////
+        static float half_to_float(uint16_t half){
+          uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+          uint32_t exponent = (half >> 10) & 0x1f;
+          uint32_t mantissa = half & 0x3ff;
+          if (exponent == 0){
+            float value = (float)mantissa * (1.0f / 16777216.0f);
+            return sign ? -value : value;
+          }
+          uint32_t bits = sign | (exponent == 31 ? 0x7f800000 | (mantissa << 13) : ((exponent + 112) << 23) | (mantissa << 13));
+          float value;
+          memcpy(&value, &bits, 4);
+          return value;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will unfold an octahedral normal
+        /// @param  u, v  The two coordinates, in [-1, 1]
+        /// @param  normal  It returns the unit normal
+        ////////////////////////////////////////////////////////////////////////////////
+        static void decode_normal(float u, float v, float * normal){
+          float z = 1.0f - fabsf(u) - fabsf(v);
+          if (z < 0.0f){
+            float unfolded_u = (1.0f - fabsf(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+            float unfolded_v = (1.0f - fabsf(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+            u = unfolded_u;
+            v = unfolded_v;
+          }
+          float length = sqrtf(u * u + v * v + z * z);
+          normal[0] = u / length;
+          normal[1] = v / length;
+          normal[2] = z / length;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the AABB of the positions of some vertices
+        /// @param  center  It returns the center of the AABB
+        /// @param  half_extent  It returns the half of the size of the AABB
+        ////////////////////////////////////////////////////////////////////////////////
+        static void get_bounds(const mesh::vertex * vertices, int num_vertexes, float * center, float * half_extent){
+          for (int k = 0; k < 3; ++k){
+            float min_value = 0.0f;
+            float max_value = 0.0f;
+            for (int i = 0; i < num_vertexes; ++i){
+              float value = ((const float *)(vertices + i))[k];
+              if (i == 0 || value < min_value)
+                min_value = value;
+              if (i == 0 || value > max_value)
+                max_value = value;
+            }
+            center[k] = (min_value + max_value) * 0.5f;
+            half_extent[k] = (max_value - min_value) * 0.5f;
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will encode some vertices with a layout
+        /// @param  texcoord  False if the vertices have no texcoord (then the uv of all the vertices is (0, 1))
+        /// @param  center, half_extent  The AABB of the positions (get_bounds)
+        /// @param  output  The vertices encoded, get_stride(format) bytes each one
+        ////////////////////////////////////////////////////////////////////////////////
+        static void encode(int format, const mesh::vertex * vertices, int num_vertexes, bool texcoord, const float * center, const float * half_extent, uint8_t * output){
+          if (format == VERTEX_FLOAT){
+            memcpy(output, vertices, sizeof(mesh::vertex) * num_vertexes);
+            if (!texcoord){
+              mesh::vertex * vtx = (mesh::vertex *)output;
+              for (int i = 0; i < num_vertexes; ++i)
+                vtx[i].uv = vec2(0, 1);
+            }
+            return;
+          }
+        #if defined(OPENDDL_SSE2)
+          float inverse[3];
+          for (int k = 0; k < 3; ++k)
+            inverse[k] = half_extent[k] > 0.0f ? 1.0f / half_extent[k] : 0.0f;
+          unsigned int stride = get_stride(format);
+          for (int i = 0; i < num_vertexes; i += 4)
+            encode_4(format, vertices + i, num_vertexes - i < 4 ? num_vertexes - i : 4, texcoord, center, inverse, output + i * stride);
+        #else
+          encode_scalar(format, vertices, num_vertexes, texcoord, center, half_extent, output);
+        #endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will encode some vertices with a compact layout one at a time (encode does it without SSE2)
+        ///   The parameters are the ones of encode, and the bytes are the same than the ones of the SIMD version
+        ////////////////////////////////////////////////////////////////////////////////
+        static void encode_scalar(int format, const mesh::vertex * vertices, int num_vertexes, bool texcoord, const float * center, const float * half_extent, uint8_t * output){
+          float inverse[3];
+          for (int k = 0; k < 3; ++k)
+            inverse[k] = half_extent[k] > 0.0f ? 1.0f / half_extent[k] : 0.0f;
+          unsigned int stride = get_stride(format);
+          int scale = format == VERTEX_COMPACT ? SHORT_SCALE : BYTE_SCALE;
+          for (int i = 0; i < num_vertexes; ++i){
+            const float * v = (const float *)(vertices + i);
+            int position[3];
+            for (int k = 0; k < 3; ++k)
+              position[k] = quantize((v[k] - center[k]) * inverse[k], SHORT_SCALE);
+            float u, w;
+            fold_normal(v + 3, u, w);
+            int normal[2] = { quantize(u, scale), quantize(w, scale) };
+            uint16_t uv[2] = { float_to_half(texcoord ? v[6] : 0.0f), float_to_half(texcoord ? v[7] : 1.0f) };
+            write_vertex(format, output + i * stride, position, normal, uv);
+          }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will decode a vertex of a layout (to use the vertices in the CPU)
+        /// @param  vertex  The first byte of the vertex
+        /// @param  center, half_extent  The AABB of the mesh
+        /// @param  output  It returns the vertex decoded
+        ////////////////////////////////////////////////////////////////////////////////
+        static void decode(int format, const uint8_t * vertex, const float * center, const float * half_extent, mesh::vertex &output){
+          float * floats = (float *)&output;
+          if (format == VERTEX_FLOAT){
+            memcpy(floats, vertex, sizeof(mesh::vertex));
+            return;
+          }
+          int16_t position[3];
+          memcpy(position, vertex, 6);
+          for (int k = 0; k < 3; ++k){
+            float value = position[k] / (float)SHORT_SCALE;
+            floats[k] = center[k] + (value > -1.0f ? value : -1.0f) * half_extent[k];
+          }
+          float u, v;
+          uint16_t uv[2];
+          if (format == VERTEX_COMPACT){
+            int16_t normal[2];
+            memcpy(normal, vertex + 8, 4);
+            u = normal[0] / (float)SHORT_SCALE;
+            v = normal[1] / (float)SHORT_SCALE;
+            memcpy(uv, vertex + 12, 4);
+          }
+          else{
+            int8_t normal[2];
+            memcpy(normal, vertex + 6, 2);
+            u = normal[0] / (float)BYTE_SCALE;
+            v = normal[1] / (float)BYTE_SCALE;
+            memcpy(uv, vertex + 8, 4);
+          }
+          decode_normal(u > -1.0f ? u : -1.0f, v > -1.0f ? v : -1.0f, floats + 3);
+          floats[6] = half_to_float(uv[0]);
+          floats[7] = half_to_float(uv[1]);
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
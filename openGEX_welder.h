@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openGEX_welder.h
+/// @author Juanmi Huertas Delgado
+/// @brief This is the welding of the vertices of the meshes after they are read (with set_vertex_welding of openGEX_parser)
+///
+///   The VertexArrays of openGEX are one array for each attribute, and the exporters usually split the vertices
+///   (one for each face that uses them), so once the position, the normal and the texcoord are in mesh::vertex a
+///   lot of them are the same vertex. The welder finds them with a hash table and keeps only one of them,
+///   rewriting the indices of all the IndexArrays of the Mesh. There are two modes:
+///   - Exact: the vertices are the same if their attributes have the same bits
+///   - Epsilon: the vertices are the same if every component of their attributes is at most epsilon away. The
+///     positions are hashed in a grid of cells of size epsilon, so only the vertices of the 27 cells around a
+///     vertex are compared. The first vertex found is kept, with its attributes (they are not averaged).
+///   The texcoords are only compared if the Mesh has them (if not, all the vertices get the same one later).
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPENGEX_WELDER_INCLUDED
+#define OPENGEX_WELDER_INCLUDED
+
+namespace octet
+{
+  namespace loaders
+  {
+    namespace openGEX_loader
+    {
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief This class welds the vertices of a Mesh (check the beginning of the file)
+  ///   The vertices and indices welded are kept in it till the next mesh is welded, so the buffers are reused
+  ////////////////////////////////////////////////////////////////////////////////
+      class openGEX_vertex_welder{
+      public:
+        enum { WELD_NONE = 0, WELD_EXACT = 1, WELD_EPSILON = 2 };
+
+      private:
+        // The floats of mesh::vertex compared: position and normal, and the texcoord if the Mesh has it
+        enum { NUM_FLOATS_NO_TEXCOORD = 6, NUM_FLOATS = 8 };
+
+        // The mesh welded
+        dynarray<mesh::vertex> vertices;
+        dynarray<uint32_t> indices;
+        // The new index of every vertex of the Mesh
+        dynarray<uint32_t> remap;
+        // A hash table with open addressing with the vertices kept (-1 is a free slot)
+        dynarray<int> slots;
+        // The cell of every vertex kept (in epsilon mode)
+        dynarray<int64_t> cells;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will return the floats of the attributes of a vertex (mesh::vertex has only floats)
+        ////////////////////////////////////////////////////////////////////////////////
+        static const float * get_floats(const mesh::vertex * mesh_vertices, uint32_t index){
+          return (const float *)(mesh_vertices + index);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the cell of the grid of a position
+        /// @return False if the position can't be in the grid (it's not finite, or too far for the size of the cells)
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool get_cell(const float * position, float epsilon, int64_t * cell){
+          for (int k = 0; k < 3; ++k){
+            double value = floor((double)position[k] / epsilon);
+            if (!(value > -1e15 && value < 1e15))
+              return false;
+            cell[k] = (int64_t)value;
+          }
+          return true;
+        }
+
+        static uint64_t hash_cell(const int64_t * cell){
+          return openDDL_cache::hash_bytes(openDDL_cache::get_initial_hash(), (const uint8_t *)cell, sizeof(int64_t) * 3);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will check if two vertices are the same in epsilon mode
+        ////////////////////////////////////////////////////////////////////////////////
+        static bool are_near(const float * a, const float * b, int num_floats, float epsilon){
+          for (int k = 0; k < num_floats; ++k){
+            if (!(fabsf(a[k] - b[k]) <= epsilon))
+              return false;
+          }
+          return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find the vertex kept with the same bits than another one, or add it to the table
+        /// @return The new index of the vertex
+        ////////////////////////////////////////////////////////////////////////////////
+        uint32_t weld_exact(const mesh::vertex * mesh_vertices, uint32_t index, int num_floats, uint32_t &num_kept){
+          const float * floats = get_floats(mesh_vertices, index);
+          unsigned int mask = slots.size() - 1;
+          uint64_t hash = openDDL_cache::hash_bytes(openDDL_cache::get_initial_hash(), (const uint8_t *)floats, sizeof(float) * num_floats);
+          unsigned int slot = (unsigned int)(hash ^ (hash >> 32)) & mask;
+          while (slots[slot] >= 0){
+            if (memcmp(get_floats(mesh_vertices, slots[slot]), floats, sizeof(float) * num_floats) == 0)
+              return remap[slots[slot]];
+            slot = (slot + 1) & mask;
+          }
+          slots[slot] = (int)index;
+          return num_kept++;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will find a vertex kept near another one (in the 27 cells around it), or add it to the table
+        /// @return The new index of the vertex
+        ////////////////////////////////////////////////////////////////////////////////
+        uint32_t weld_epsilon(const mesh::vertex * mesh_vertices, uint32_t index, int num_floats, float epsilon, uint32_t &num_kept){
+          const float * floats = get_floats(mesh_vertices, index);
+          unsigned int mask = slots.size() - 1;
+          int64_t * cell = &cells[index * 3];
+          //The vertices out of the grid are never welded
+          if (!get_cell(floats, epsilon, cell))
+            return num_kept++;
+          for (int dx = -1; dx <= 1; ++dx){
+            for (int dy = -1; dy <= 1; ++dy){
+              for (int dz = -1; dz <= 1; ++dz){
+                int64_t near_cell[3] = { cell[0] + dx, cell[1] + dy, cell[2] + dz };
+                uint64_t hash = hash_cell(near_cell);
+                unsigned int slot = (unsigned int)(hash ^ (hash >> 32)) & mask;
+                while (slots[slot] >= 0){
+                  const int64_t * kept_cell = &cells[slots[slot] * 3];
+                  if (kept_cell[0] == near_cell[0] && kept_cell[1] == near_cell[1] && kept_cell[2] == near_cell[2] &&
+                      are_near(get_floats(mesh_vertices, slots[slot]), floats, num_floats, epsilon))
+                    return remap[slots[slot]];
+                  slot = (slot + 1) & mask;
+                }
+              }
+            }
+          }
+          uint64_t hash = hash_cell(cell);
+          unsigned int slot = (unsigned int)(hash ^ (hash >> 32)) & mask;
+          while (slots[slot] >= 0)
+            slot = (slot + 1) & mask;
+          slots[slot] = (int)index;
+          return num_kept++;
+        }
+
+      public:
+        ////////////////////////////////////////////////////////////////////////////////
+        /// @brief This will weld the vertices of a Mesh
+        /// @param  mode  WELD_EXACT or WELD_EPSILON (with an epsilon of 0 or less, it's WELD_EXACT)
+        /// @param  texcoord  False if the Mesh has no texcoord (then they are not compared)
+        /// @param  mesh_vertices  The vertices of the Mesh, and the number of them (it returns the new ones)
+        /// @param  index_arrays  The indices of each IndexArray (it returns the new ones)
+        /// @param  num_indices  The number of indices of each IndexArray
+        /// @return False if no vertex was welded, or if there is an index out of the vertices (then nothing is changed)
+        ///   The new vertices and indices are valid till the next weld
+        ////////////////////////////////////////////////////////////////////////////////
+        bool weld(int mode, float epsilon, bool texcoord, mesh::vertex *&mesh_vertices, int &num_vertexes, dynarray<uint32_t *> &index_arrays, dynarray<int> &num_indices){
+          if (mode == WELD_NONE || mesh_vertices == NULL || num_vertexes <= 1)
+            return false;
+          unsigned int num_arrays = index_arrays.size();
+          unsigned int total_indices = 0;
+          for (unsigned int i = 0; i < num_arrays; ++i){
+            if (num_indices[i] > 0 && index_arrays[i] == NULL)
+              return false;
+            for (int j = 0; j < num_indices[i]; ++j){
+              if (index_arrays[i][j] >= (uint32_t)num_vertexes)
+                return false;
+            }
+            total_indices += num_indices[i];
+          }
+          if (mode == WELD_EPSILON && !(epsilon > 0))
+            mode = WELD_EXACT;
+          int num_floats = texcoord ? NUM_FLOATS : NUM_FLOATS_NO_TEXCOORD;
+          //The table has at least twice the slots than vertices
+          unsigned int num_slots = 16;
+          while (num_slots < (unsigned int)num_vertexes * 2)
+            num_slots *= 2;
+          slots.resize(num_slots);
+          for (unsigned int i = 0; i < num_slots; ++i)
+            slots[i] = -1;
+          remap.resize(num_vertexes);
+          if (mode == WELD_EPSILON)
+            cells.resize(num_vertexes * 3);
+          uint32_t num_kept = 0;
+          for (int v = 0; v < num_vertexes; ++v){
+            if (mode == WELD_EPSILON)
+              remap[v] = weld_epsilon(mesh_vertices, v, num_floats, epsilon, num_kept);
+            else
+              remap[v] = weld_exact(mesh_vertices, v, num_floats, num_kept);
+          }
+          if (num_kept == (uint32_t)num_vertexes)
+            return false;
+          //The vertices kept are in their order, so remap is the index of the first one of each group
+          vertices.resize(num_kept);
+          uint32_t next = 0;
+          for (int v = 0; v < num_vertexes; ++v){
+            if (remap[v] == next)
+              vertices[next++] = mesh_vertices[v];
+          }
+          indices.resize(total_indices);
+          unsigned int offset = 0;
+          for (unsigned int i = 0; i < num_arrays; ++i){
+            for (int j = 0; j < num_indices[i]; ++j)
+              indices[offset + j] = remap[index_arrays[i][j]];
+            index_arrays[i] = indices.data() + offset;
+            offset += num_indices[i];
+          }
+          mesh_vertices = vertices.data();
+          num_vertexes = (int)num_kept;
+          return true;
+        }
+      };
+    }
+  }
+}
+
+#endif
\ No newline at end of file
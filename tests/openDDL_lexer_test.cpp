@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_lexer_test.cpp
+/// @author Juanmi Huertas Delgado
+/// @brief This are the tests of the data array lists of integers decoded in bulk by openDDL_lexer
+///
+///   It's a console program (place the folder of the example in "octet\src\examples", like example_openGEX),
+///   it prints the tests that fail and returns the number of them.
+///   The elements are decoded in place, so the integers of 8 characters are read with the padded path when there
+///   are 8 more characters in the buffer, and with the scalar one at the end of it: both are tested.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "../../../octet.h"
+
+using namespace octet;
+using namespace octet::loaders::openGEX_loader;
+
+static int num_failed = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief This lexer gives access to the structures of the top level of the document
+////////////////////////////////////////////////////////////////////////////////
+class openDDL_test_lexer : public openDDL_lexer{
+public:
+  int get_number_structures(){
+    return (int)openDDL_file.size();
+  }
+
+  openDDL_data_type_structure * get_data_structure(int index){
+    return (openDDL_data_type_structure *)openDDL_file[index];
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief This will lex a document with one data array list of unsigned_int32[3] and check its elements
+/// @param  name  The name of the test
+/// @param  text  The document
+/// @param  expected  The elements expected (the malformed ones are 0)
+/// @param  num_expected  The number of elements
+////////////////////////////////////////////////////////////////////////////////
+static void check_array(const char * name, const char * text, const uint32_t * expected, int num_expected){
+  for (int mode = 0; mode < 3; ++mode){
+    openDDL_test_lexer lexer;
+    lexer.set_lazy_data(mode == 1);
+    lexer.set_structural_index(mode == 2);
+    lexer.lexer_memory((const uint8_t *)text, strlen(text));
+    openDDL_data_list * list = lexer.get_number_structures() == 1 ? lexer.get_data_structure(0)->get_contiguous_list() : NULL;
+    if (list == NULL || list->size() != (size_t)num_expected){
+      printf("FAILED: %s (mode %i) has %i elements\n", name, mode, list != NULL ? (int)list->size() : -1);
+      ++num_failed;
+      continue;
+    }
+    dynarray<uint32_t> values(num_expected);
+    list->get_values(values.data(), 0, num_expected);
+    for (int i = 0; i < num_expected; ++i){
+      if (values[i] != expected[i]){
+        printf("FAILED: %s (mode %i) element %i is %u, not %u\n", name, mode, i, values[i], expected[i]);
+        ++num_failed;
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv){
+  // Elements of exactly 8 characters with 8 more characters after them (padded path), and at the end of the buffer
+  static const uint32_t valid[] = { 12345678, 87654321, 1, 2, 99999999, 10000000 };
+  check_array("valid", "unsigned_int32[3] {{12345678, 87654321, 1}, {2, 99999999, 10000000}}", valid, 6);
+  // The malformed elements are reported (It's not a correct integer-literal!) and stored as 0
+  static const uint32_t malformed[] = { 0, 0, 0, 7, 8, 9, 12345678, 0, 0 };
+  check_array("malformed", "unsigned_int32[3] {{1234)678, 1234!678, (2345678}, {7, 8, 9}, {12345678, 1234567/, 1234)678}}", malformed, 9);
+  // The elements of 1 to 7 characters are filled with '0'
+  static const uint32_t short_elements[] = { 1, 12, 123, 1234, 12345, 123456, 1234567, 0, 0 };
+  check_array("short", "unsigned_int32[3] {{1, 12, 123}, {1234, 12345, 123456}, {1234567, 12)45, 12!}}", short_elements, 9);
+
+  if (num_failed == 0)
+    printf("All the tests of the data array lists passed\n");
+  return num_failed;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openDDL_number_parser_test.cpp
+/// @author Juanmi Huertas Delgado
+/// @brief This are the tests of the integer literals of openDDL_number_parser
+///
+///   It's a console program (place the folder of the example in "octet\src\examples", like example_openGEX),
+///   it prints the tests that fail and returns the number of them.
+///   The words are tested as the lexer reads them: with 8 more characters after them that can be read (padded),
+///   and filled with digits, so a wrong character of the word can't be hidden by the characters after it.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "../../../octet.h"
+
+using namespace octet::loaders::openGEX_loader;
+
+static int num_failed = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief This will parse a word followed by 8 digits, with and without the padded path
+/// @param  word  The word to parse
+/// @param  valid  True if the word is a correct integer-literal
+/// @param  expected  The value of the word (only if it's valid)
+////////////////////////////////////////////////////////////////////////////////
+static void check_integer(const char * word, bool valid, uint64_t expected){
+  char buffer[64];
+  int size = (int)strlen(word);
+  memcpy(buffer, word, size);
+  memcpy(buffer + size, "99999999", 9);
+  for (int padded = 0; padded < 2; ++padded){
+    uint64_t value = 0;
+    bool no_error = openDDL_number_parser::parse_integer(value, buffer, size, padded != 0);
+    if (no_error != valid || (valid && value != expected)){
+      printf("FAILED: \"%s\" (padded %i) returned %i with %llu\n", word, padded, no_error, (unsigned long long)value);
+      ++num_failed;
+    }
+  }
+}
+
+int main(int argc, char **argv){
+  // The words of 1 to 7 digits are filled with '0' at the left
+  check_integer("1", true, 1);
+  check_integer("12", true, 12);
+  check_integer("123", true, 123);
+  check_integer("1234", true, 1234);
+  check_integer("12345", true, 12345);
+  check_integer("123456", true, 123456);
+  check_integer("1234567", true, 1234567);
+  check_integer("-1234567", true, 0 - (uint64_t)1234567);
+  check_integer("0000000", true, 0);
+  check_integer("1)3", false, 0);
+  check_integer("12345!7", false, 0);
+  check_integer("/", false, 0);
+  check_integer(":", false, 0);
+  // The words of exactly 8 characters are read as they are, without filling them
+  check_integer("12345678", true, 12345678);
+  check_integer("99999999", true, 99999999);
+  check_integer("00000000", true, 0);
+  check_integer("+12345678", true, 12345678);
+  check_integer("1234)678", false, 0);
+  check_integer("1234!678", false, 0);
+  check_integer("(2345678", false, 0);
+  check_integer("1234567/", false, 0);
+  check_integer("1234567:", false, 0);
+  check_integer("1234 678", false, 0);
+  // Longer words are read 8 digits at a time
+  check_integer("123456789", true, 123456789);
+  check_integer("1234567890123456", true, 1234567890123456ULL);
+  check_integer("18446744073709551615", true, 18446744073709551615ULL);
+  check_integer("18446744073709551616", false, 0);
+  check_integer("12345678)", false, 0);
+
+  if (num_failed == 0)
+    printf("All the tests of the integer literals passed\n");
+  return num_failed;
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file openGEX_vertex_format_test.cpp
+/// @author Juanmi Huertas Delgado
+/// @brief This are the tests of the compact layouts of the vertices of openGEX_vertex_format
+///
+///   It's a console program (place the folder of the example in "octet\src\examples", like example_openGEX),
+///   it prints the tests that fail and returns the number of them.
+///   The vertices are encoded with encode (4 at a time with SSE2, and F16C if the compiler has it) and with
+///   encode_scalar, and the bytes have to be the same. The half floats are tested in the edge cases.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "../../../octet.h"
+
+using namespace octet;
+using namespace octet::loaders::openGEX_loader;
+
+static int num_failed = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief This will return a float from its bits
+////////////////////////////////////////////////////////////////////////////////
+static float get_float(uint32_t bits){
+  float value;
+  memcpy(&value, &bits, 4);
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief This will convert a float to a half float and check the result
+/// @param  name  The name of the test
+/// @param  value  The float to convert
+/// @param  expected  The half float expected
+////////////////////////////////////////////////////////////////////////////////
+static void check_half(const char * name, float value, uint16_t expected){
+  uint16_t half = openGEX_vertex_format::float_to_half(value);
+  if (half != expected){
+    printf("FAILED: %s (%g) is 0x%04x, not 0x%04x\n", name, value, half, expected);
+    ++num_failed;
+  }
+#if defined(OPENGEX_F16C)
+  uint16_t simd_half = (uint16_t)_mm_extract_epi16(_mm_cvtps_ph(_mm_set1_ps(value), 0), 0);
+  if (simd_half != expected){
+    printf("FAILED: %s (%g) is 0x%04x with F16C, not 0x%04x\n", name, value, simd_half, expected);
+    ++num_failed;
+  }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief This will check that all the half floats are the same after converting them to float and back
+////////////////////////////////////////////////////////////////////////////////
+static void check_all_halves(){
+  for (uint32_t i = 0; i < 0x10000; ++i){
+    uint16_t half = (uint16_t)i;
+    float value = openGEX_vertex_format::half_to_float(half);
+    bool nan = (half & 0x7c00) == 0x7c00 && (half & 0x3ff) != 0;
+    if (nan ? value == value : openGEX_vertex_format::float_to_half(value) != half){
+      printf("FAILED: The half float 0x%04x is %g\n", half, value);
+      ++num_failed;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief This will encode some vertices with encode and with encode_scalar, and compare their bytes
+/// @param  format  VERTEX_COMPACT or VERTEX_SMALL
+/// @param  vertices  The vertices
+/// @param  num_vertexes  The number of vertices (the ones that are not a multiple of 4 are the tail of the SIMD)
+/// @param  texcoord  True if the vertices have texcoord
+////////////////////////////////////////////////////////////////////////////////
+static void check_encode(int format, const mesh::vertex * vertices, int num_vertexes, bool texcoord){
+  float center[3], half_extent[3];
+  openGEX_vertex_format::get_bounds(vertices, num_vertexes, center, half_extent);
+  unsigned int size = openGEX_vertex_format::get_stride(format) * num_vertexes;
+  //One more byte at the end, to check that nothing is written after the last vertex
+  dynarray<uint8_t> simd(size + 1), scalar(size + 1);
+  memset(simd.data(), 0xcd, size + 1);
+  memset(scalar.data(), 0xcd, size + 1);
+  openGEX_vertex_format::encode(format, vertices, num_vertexes, texcoord, center, half_extent, simd.data());
+  openGEX_vertex_format::encode_scalar(format, vertices, num_vertexes, texcoord, center, half_extent, scalar.data());
+  for (unsigned int i = 0; i <= size; ++i){
+    if (simd[i] != scalar[i]){
+      printf("FAILED: The byte %u of %i vertices (format %i, texcoord %i) is 0x%02x, not 0x%02x\n", i, num_vertexes, format, texcoord, simd[i], scalar[i]);
+      ++num_failed;
+      return;
+    }
+  }
+}
+
+int main(int argc, char **argv){
+  // The zeros keep their sign
+  check_half("zero", 0.0f, 0x0000);
+  check_half("negative zero", -0.0f, 0x8000);
+  // The denormals are rounded to the nearest even
+  check_half("smallest denormal", get_float(0x33800000), 0x0001);
+  check_half("half of the smallest denormal", get_float(0x33000000), 0x0000);
+  check_half("1.5 times the smallest denormal", get_float(0x33c00000), 0x0002);
+  check_half("biggest denormal", 1023.0f / 16777216.0f, 0x03ff);
+  check_half("negative denormal", -3.0f / 16777216.0f, 0x8003);
+  check_half("between the biggest denormal and the smallest normal", 1023.5f / 16777216.0f, 0x0400);
+  check_half("smallest normal", 1.0f / 16384.0f, 0x0400);
+  // The normals are rounded to the nearest even
+  check_half("one", 1.0f, 0x3c00);
+  check_half("one and a half ulp", 1.0f + 1.0f / 2048.0f, 0x3c00);
+  check_half("one and three halves ulp", 1.0f + 3.0f / 2048.0f, 0x3c02);
+  check_half("minus two", -2.0f, 0xc000);
+  // 65504 is the biggest half float, from 65520 they are rounded to infinite
+  check_half("biggest half", 65504.0f, 0x7bff);
+  check_half("below 65520", 65519.0f, 0x7bff);
+  check_half("65520", 65520.0f, 0x7c00);
+  check_half("minus 65520", -65520.0f, 0xfc00);
+  check_half("too big", 1.0e10f, 0x7c00);
+  check_half("infinite", get_float(0x7f800000), 0x7c00);
+  check_half("minus infinite", get_float(0xff800000), 0xfc00);
+  check_half("NaN", get_float(0x7fc00000), 0x7e00);
+  check_half("negative NaN", get_float(0xffc00000), 0xfe00);
+  check_all_halves();
+
+  // The vertices of the tests, with the normals on the axes and zero (the edges of the octahedral square)
+  enum { NUM_VERTEXES = 37 };
+  dynarray<mesh::vertex> vertices(NUM_VERTEXES);
+  static const float normals[][3] = { { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 0 },
+    { 1, 1, -1 }, { -1, 1, -1 }, { 1, -1, -1 }, { -1, -1, -1 }, { 0.5f, -0.25f, 0.8f } };
+  static const float texcoords[] = { 0.0f, -0.0f, 1.0f, 0.5f, 1.0f / 3.0f, 65504.0f, 65520.0f, -1.0e10f, 1.0f / 16777216.0f, 1023.5f / 16777216.0f };
+  uint32_t seed = 12345;
+  for (int i = 0; i < NUM_VERTEXES; ++i){
+    float * v = (float *)&vertices[i];
+    for (int k = 0; k < 3; ++k){
+      seed = seed * 1664525 + 1013904223;
+      v[k] = (float)(seed >> 8) / 16777216.0f * 20.0f - 10.0f;
+    }
+    const float * normal = normals[i % (sizeof(normals) / sizeof(normals[0]))];
+    for (int k = 0; k < 3; ++k)
+      v[3 + k] = normal[k];
+    v[6] = texcoords[i % (sizeof(texcoords) / sizeof(texcoords[0]))];
+    v[7] = texcoords[(i + 3) % (sizeof(texcoords) / sizeof(texcoords[0]))];
+  }
+  // The vertices on the faces of the AABB, and a flat AABB
+  for (int k = 0; k < 3; ++k){
+    ((float *)&vertices[0])[k] = -10.0f;
+    ((float *)&vertices[1])[k] = 10.0f;
+  }
+  for (int format = openGEX_vertex_format::VERTEX_COMPACT; format <= openGEX_vertex_format::VERTEX_SMALL; ++format){
+    for (int num_vertexes = 1; num_vertexes <= NUM_VERTEXES; ++num_vertexes){
+      check_encode(format, vertices.data(), num_vertexes, true);
+      check_encode(format, vertices.data(), num_vertexes, false);
+    }
+  }
+  for (int i = 0; i < NUM_VERTEXES; ++i)
+    ((float *)&vertices[i])[1] = 2.0f;
+  check_encode(openGEX_vertex_format::VERTEX_COMPACT, vertices.data(), NUM_VERTEXES, true);
+  check_encode(openGEX_vertex_format::VERTEX_SMALL, vertices.data(), NUM_VERTEXES, true);
+
+  if (num_failed == 0)
+    printf("All the tests of the layouts of the vertices passed\n");
+  return num_failed;
+}
\ No newline at end of file